@@ -0,0 +1,2106 @@
+// ULTIMATE ImGui Builder: headless frame-time benchmark
+// (create context, run the builder with NO INPUTS, NO GRAPHICS OUTPUT and report what each frame costs)
+// Usage: builder_benchmark [frames] [element_count...]
+// Default is 60 measured frames over synthetic documents of 1k, 10k and 100k elements.
+
+#include "imgui.h"
+#include "imgui_builder.h"
+#include "imgui_builder_batch.h"
+#include "imgui_builder_codegen.h"
+#include "imgui_builder_fold.h"
+#include "imgui_builder_history.h"
+#include "imgui_builder_jobs.h"
+#include "imgui_builder_json.h"
+#include "imgui_builder_live.h"
+#include "imgui_builder_preview.h"
+#include "imgui_builder_profiler.h"
+#include "imgui_builder_project.h"
+#include "imgui_builder_runtime.h"
+#include "imgui_builder_scheduler.h"
+#include "imgui_builder_search.h"
+#include "runtime_layout.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+// Allocation counters. Everything the builder allocates goes through operator new,
+// everything Dear ImGui allocates goes through the allocator functions we register below.
+// The builder may allocate from pool threads (parallel code generation).
+static std::atomic<size_t> g_NewCount(0);
+static std::atomic<size_t> g_NewBytes(0);
+static size_t g_ImGuiAllocCount = 0;
+static size_t g_ImGuiAllocBytes = 0;
+
+// GCC 11+ sees free() in operator delete and malloc() in operator new once they are inlined, and warns at every
+// new/delete pair of the program
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t sz)
+{
+    g_NewCount++;
+    g_NewBytes += sz;
+    if (void* ptr = malloc(sz ? sz : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t sz) { return operator new(sz); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+static void* BenchMalloc(size_t sz, void*) { g_ImGuiAllocCount++; g_ImGuiAllocBytes += sz; return malloc(sz); }
+static void BenchFree(void* ptr, void*) { free(ptr); }
+
+typedef std::chrono::steady_clock BenchClock;
+static double MillisecondsSince(BenchClock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// Widget mix used for synthetic documents: everything the preview knows how to draw.
+static const ElementType g_SyntheticTypes[] =
+{
+    ElementType::BUTTON, ElementType::CHECKBOX, ElementType::SLIDER_FLOAT, ElementType::SLIDER_INT,
+    ElementType::INPUT_TEXT, ElementType::INPUT_INT, ElementType::INPUT_FLOAT, ElementType::COMBO,
+    ElementType::LISTBOX, ElementType::COLOR_PICKER, ElementType::SEPARATOR, ElementType::TEXT,
+    ElementType::BULLET_TEXT, ElementType::PROGRESS_BAR, ElementType::RADIO_BUTTON, ElementType::SELECTABLE,
+    ElementType::SPACING,
+};
+
+// Every 64th element is a collapsing header owning the 16 elements that follow it, the rest are children of 'root'.
+static void BuildSyntheticDocument(ImGuiBuilder& builder, int count, ElementIndex root = ElementIndex_None)
+{
+    char label[64];
+    ElementIndex header = ElementIndex_None;
+    int header_children_left = 0;
+    for (int n = 0; n < count; n++)
+    {
+        if (n % 64 == 0)
+        {
+            snprintf(label, sizeof(label), "Header %d", n);
+            header = builder.AddElement(ElementType::COLLAPSING_HEADER, label, root);
+            header_children_left = 16;
+            continue;
+        }
+        ElementType type = g_SyntheticTypes[n % IM_ARRAYSIZE(g_SyntheticTypes)];
+        snprintf(label, sizeof(label), "Element %d", n);
+        builder.AddElement(type, label, header_children_left-- > 0 ? header : root);
+    }
+}
+
+struct BenchResult
+{
+    double  FrameAvgMs = 0.0, FrameMinMs = 1e30, FrameMaxMs = 0.0;
+    double  NewPerFrame = 0.0, NewBytesPerFrame = 0.0;
+    double  ImGuiAllocPerFrame = 0.0;
+    int     Vertices = 0;
+    double  CodegenMs = 0.0;
+    double  CodeMB = 0.0;
+    int     CodegenAllocs = 0;
+};
+
+static BenchResult RunBenchmark(int element_count, int frames)
+{
+    BenchResult result;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // Build atlas (no renderer: the texture is never uploaded)
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    builder->SetMenuVisible(true);
+    // Text fields have no length limit: show a long one in the preview and in the properties panel
+    const ElementIndex long_text = builder->AddElement(ElementType::INPUT_TEXT, "Long Text");
+    builder->GetElements().SetText(long_text, std::string(4096, 'x').c_str());
+    builder->SelectElement(long_text);
+    // Open every header in the preview and expand it in the tree: the whole document is reachable by scrolling,
+    // only what fits in the windows should cost anything.
+    ElementStore& elements = builder->GetElements();
+    for (ElementIndex element = elements.FirstChild(ElementIndex_None); element != ElementIndex_None; element = elements.NextSibling(element))
+        if (elements.FirstChild(element) != ElementIndex_None)
+            elements.flags[element] |= ElementFlags_Open | ElementFlags_Expanded;
+
+    // Warm up: first frames create windows, settings and draw list buffers.
+    const int warmup_frames = 3;
+    for (int n = 0; n < warmup_frames + frames; n++)
+    {
+        const bool measure = (n >= warmup_frames);
+        const size_t new_count = g_NewCount, new_bytes = g_NewBytes, imgui_allocs = g_ImGuiAllocCount;
+        BenchClock::time_point start = BenchClock::now();
+
+        ImGui::NewFrame();
+        builder->Render();
+        ImGui::Render();
+
+        const double ms = MillisecondsSince(start);
+        if (!measure)
+            continue;
+        result.FrameAvgMs += ms;
+        result.FrameMinMs = (ms < result.FrameMinMs) ? ms : result.FrameMinMs;
+        result.FrameMaxMs = (ms > result.FrameMaxMs) ? ms : result.FrameMaxMs;
+        result.NewPerFrame += (double)(g_NewCount - new_count);
+        result.NewBytesPerFrame += (double)(g_NewBytes - new_bytes);
+        result.ImGuiAllocPerFrame += (double)(g_ImGuiAllocCount - imgui_allocs);
+        result.Vertices = ImGui::GetDrawData()->TotalVtxCount;
+    }
+    result.FrameAvgMs /= frames;
+    result.NewPerFrame /= frames;
+    result.NewBytesPerFrame /= frames;
+    result.ImGuiAllocPerFrame /= frames;
+
+    // Whole document code generation. The second pass reuses the buffers of the first one and should not allocate.
+    CodeBuffer header, source;
+    GenerateDocumentCode(builder->GetElements(), "Benchmark", "benchmark.h", header, source);
+    const size_t allocs = g_NewCount + g_ImGuiAllocCount;
+    BenchClock::time_point start = BenchClock::now();
+    GenerateDocumentCode(builder->GetElements(), "Benchmark", "benchmark.h", header, source);
+    result.CodegenMs = MillisecondsSince(start);
+    result.CodegenAllocs = (int)(g_NewCount + g_ImGuiAllocCount - allocs);
+    result.CodeMB = (header.Size() + source.Size()) / (1024.0 * 1024.0);
+
+    delete builder;
+    ImGui::DestroyContext();
+    return result;
+}
+
+// Document operations: create, deep-duplicate and clear a whole document, counting heap allocations of each step.
+// The second creation pass runs on recycled memory and should not allocate at all.
+static size_t HeapAllocCount() { return g_NewCount + g_ImGuiAllocCount; }
+
+static void RunDocumentBenchmark(int element_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    ElementStore& elements = builder->GetElements();
+
+    size_t start_allocs = HeapAllocCount();
+    BenchClock::time_point start = BenchClock::now();
+    ElementIndex root = builder->AddElement(ElementType::GROUP, "Root");
+    BuildSyntheticDocument(*builder, element_count - 1, root);
+    const double create_ms = MillisecondsSince(start);
+    const size_t create_allocs = HeapAllocCount() - start_allocs;
+
+    start_allocs = HeapAllocCount();
+    start = BenchClock::now();
+    elements.Append(ElementIndex_None, elements.Duplicate(root));
+    const double duplicate_ms = MillisecondsSince(start);
+    const size_t duplicate_allocs = HeapAllocCount() - start_allocs;
+    const ElementStoreStats stats = elements.GetStats();
+
+    start_allocs = HeapAllocCount();
+    start = BenchClock::now();
+    builder->ClearElements();
+    const double clear_ms = MillisecondsSince(start);
+    const size_t clear_allocs = HeapAllocCount() - start_allocs;
+
+    start_allocs = HeapAllocCount();
+    start = BenchClock::now();
+    root = builder->AddElement(ElementType::GROUP, "Root");
+    BuildSyntheticDocument(*builder, element_count - 1, root);
+    const double recreate_ms = MillisecondsSince(start);
+    const size_t recreate_allocs = HeapAllocCount() - start_allocs;
+
+    printf("%10d %10.3f %8d %10.3f %8d %10.3f %8d %10.3f %8d %10d %10.1f %10d %10d\n", element_count,
+        create_ms, (int)create_allocs, duplicate_ms, (int)duplicate_allocs, clear_ms, (int)clear_allocs, recreate_ms, (int)recreate_allocs,
+        stats.slots, (double)stats.slot_bytes / stats.slots, stats.strings.strings, (int)(stats.strings.bytes_reserved / 1024));
+    delete builder;
+}
+
+// Element uids at scale: a million elements created, duplicated, partly removed and created again must keep
+// unique uids, and two documents built the same way must get the same uids and the same generated code.
+static bool RunUidBenchmark(int element_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    ElementStore& elements = builder->GetElements();
+    BenchClock::time_point start = BenchClock::now();
+    ElementIndex root = builder->AddElement(ElementType::GROUP, "Root");
+    BuildSyntheticDocument(*builder, element_count / 2 - 1, root);
+    elements.Append(ElementIndex_None, elements.Duplicate(root));
+    for (ElementIndex header = elements.FirstChild(root); header != ElementIndex_None; header = elements.NextSibling(header))
+    {
+        int n = 0;
+        for (ElementIndex element = elements.FirstChild(header); element != ElementIndex_None; n++)
+        {
+            ElementIndex next = elements.NextSibling(element);
+            if (n % 3 == 0)
+                elements.Remove(element);
+            element = next;
+        }
+    }
+    while (elements.Size() < element_count)
+        builder->AddElement(ElementType::BUTTON, "Button", root);
+    const double build_ms = MillisecondsSince(start);
+
+    start = BenchClock::now();
+    const bool unique = elements.HasUniqueUids();
+    const double check_ms = MillisecondsSince(start);
+
+    ImGuiBuilder* other = new ImGuiBuilder();
+    BuildSyntheticDocument(*other, 10000);
+    builder->ClearElements();
+    BuildSyntheticDocument(*builder, 10000);
+    CodeBuffer header, source, other_header, other_source;
+    GenerateDocumentCode(builder->GetElements(), "Benchmark", "benchmark.h", header, source);
+    GenerateDocumentCode(other->GetElements(), "Benchmark", "benchmark.h", other_header, other_source);
+    const bool reproducible = builder->GetElements().uids == other->GetElements().uids &&
+        source.Size() == other_source.Size() && memcmp(source.Begin(), other_source.Begin(), source.Size()) == 0;
+
+    printf("%10d %10.3f %10.3f %10s %14s\n", element_count, build_ms, check_ms, unique ? "OK" : "FAILED", reproducible ? "OK" : "FAILED");
+    delete other;
+    delete builder;
+    return unique && reproducible;
+}
+
+// Deep comparison of two documents, used to check that saving then loading gives back the same tree.
+static bool ElementsEqual(const ElementStore& a, ElementIndex ia, const ElementStore& b, ElementIndex ib)
+{
+    const ElementValues va = a.GetValues(ia);
+    const ElementValues vb = b.GetValues(ib);
+    const ElementStyle& sa = a.styles[ia];
+    const ElementStyle& sb = b.styles[ib];
+    if (a.types[ia] != b.types[ib] || a.flags[ia] != b.flags[ib] ||
+        va.int_value != vb.int_value || va.float_value != vb.float_value || va.min_value != vb.min_value ||
+        va.max_value != vb.max_value || va.selected_item != vb.selected_item ||
+        memcmp(&sa, &sb, sizeof(ElementStyle)) != 0 || memcmp(&a.GetColor(ia), &b.GetColor(ib), sizeof(ImVec4)) != 0 ||
+        a.uids[ia] != b.uids[ib] || strcmp(a.strings[ia].label, b.strings[ib].label) != 0 ||
+        strcmp(a.strings[ia].text_value, b.strings[ib].text_value) != 0 || a.GetItemCount(ia) != b.GetItemCount(ib))
+        return false;
+    for (int i = 0; i < a.GetItemCount(ia); i++)
+        if (strcmp(a.GetItems(ia)[i], b.GetItems(ib)[i]) != 0)
+            return false;
+    ElementIndex ca = a.FirstChild(ia), cb = b.FirstChild(ib);
+    for (; ca != ElementIndex_None && cb != ElementIndex_None; ca = a.NextSibling(ca), cb = b.NextSibling(cb))
+        if (!ElementsEqual(a, ca, b, cb))
+            return false;
+    return ca == cb;
+}
+
+static bool DocumentsEqual(const ElementStore& a, const ElementStore& b)
+{
+    ElementIndex ca = a.FirstChild(ElementIndex_None), cb = b.FirstChild(ElementIndex_None);
+    for (; ca != ElementIndex_None && cb != ElementIndex_None; ca = a.NextSibling(ca), cb = b.NextSibling(cb))
+        if (!ElementsEqual(a, ca, b, cb))
+            return false;
+    return ca == cb && a.Size() == b.Size();
+}
+
+// Project files: save, memory-mapped load, and a round trip check of every field.
+static bool RunProjectFileBenchmark(int element_count)
+{
+    const char* path = "builder_benchmark.imgb";
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+
+    std::string error;
+    BenchClock::time_point start = BenchClock::now();
+    bool ok = SaveProjectBinary(builder->GetElements(), "Benchmark", path, &error);
+    const double save_ms = MillisecondsSince(start);
+
+    ElementStore* loaded = new ElementStore();
+    const char* name = nullptr;
+    start = BenchClock::now();
+    ok = ok && LoadProjectBinary(*loaded, path, &name, &error);
+    const double load_ms = MillisecondsSince(start);
+
+    size_t file_size = 0;
+    if (ok)
+        if (std::shared_ptr<ProjectFileView> view = ProjectFileView::Open(path))
+            file_size = view->GetFileSize();
+    bool round_trip = ok && strcmp(name, "Benchmark") == 0 && DocumentsEqual(builder->GetElements(), *loaded);
+
+    // A combo selecting past its items must be rejected, not drawn
+    std::vector<char> bytes(file_size);
+    FILE* f = fopen(path, "rb");
+    round_trip &= f && fread(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    if (f)
+        fclose(f);
+    bool patched = false;
+    if (round_trip)
+    {
+        const ProjectFileHeader* header = (const ProjectFileHeader*)bytes.data();
+        ProjectFileNode* nodes = (ProjectFileNode*)(bytes.data() + header->nodes_offset);
+        for (ImU32 n = 0; n < header->node_count && !patched; n++)
+            if (nodes[n].items_count > 0)
+            {
+                nodes[n].selected_item = (ImS32)nodes[n].items_count;
+                patched = true;
+            }
+        // The loaded document still maps the file
+        const char* corrupted_path = "builder_benchmark_corrupted.imgb";
+        f = fopen(corrupted_path, "wb");
+        round_trip &= f && fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        if (f)
+            fclose(f);
+        ElementStore* corrupted = new ElementStore();
+        const char* corrupted_name = nullptr;
+        std::string corrupted_error;
+        round_trip &= patched && !LoadProjectBinary(*corrupted, corrupted_path, &corrupted_name, &corrupted_error);
+        delete corrupted;
+        remove(corrupted_path);
+    }
+    printf("%10d %10.3f %10.3f %10.2f %12s %s\n", element_count, save_ms, load_ms, file_size / (1024.0 * 1024.0),
+        round_trip ? "OK" : "FAILED", error.c_str());
+
+    delete loaded;
+    delete builder;
+    remove(path);
+    return round_trip;
+}
+
+// JSON project files: streaming export/import throughput, and the same round trip check.
+static bool RunJsonBenchmark(int element_count)
+{
+    const char* path = "builder_benchmark.json";
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+
+    std::string error;
+    size_t allocs = HeapAllocCount();
+    BenchClock::time_point start = BenchClock::now();
+    bool ok = SaveProjectJson(builder->GetElements(), "Benchmark", path, &error);
+    const double save_ms = MillisecondsSince(start);
+    const size_t save_allocs = HeapAllocCount() - allocs;
+
+    size_t file_size = 0;
+    if (FILE* f = fopen(path, "rb"))
+    {
+        fseek(f, 0, SEEK_END);
+        file_size = (size_t)ftell(f);
+        fclose(f);
+    }
+
+    ElementStore* loaded = new ElementStore();
+    const char* name = nullptr;
+    start = BenchClock::now();
+    ok = ok && LoadProjectJson(*loaded, path, &name, &error);
+    const double load_ms = MillisecondsSince(start);
+
+    const double size_mb = file_size / (1024.0 * 1024.0);
+    bool round_trip = ok && strcmp(name, "Benchmark") == 0 && DocumentsEqual(builder->GetElements(), *loaded);
+
+    // A combo selecting past its items must be rejected, not drawn
+    {
+        const char* corrupted_path = "builder_benchmark_corrupted.json";
+        ImGuiBuilder* corrupted = new ImGuiBuilder();
+        ElementStore& elements = corrupted->GetElements();
+        const ElementIndex combo = corrupted->AddElement(ElementType::COMBO, "Combo");
+        elements.EditItemList(combo)->selected_item = elements.GetItemCount(combo);
+        ElementStore* corrupted_loaded = new ElementStore();
+        const char* corrupted_name = nullptr;
+        std::string corrupted_error;
+        round_trip &= SaveProjectJson(elements, "Corrupted", corrupted_path, &corrupted_error) &&
+            !LoadProjectJson(*corrupted_loaded, corrupted_path, &corrupted_name, &corrupted_error);
+        delete corrupted_loaded;
+        delete corrupted;
+        remove(corrupted_path);
+    }
+    printf("%10d %10.2f %10.3f %10.1f %10zu %10.3f %10.1f %12s %s\n", element_count, size_mb, save_ms, size_mb * 1000.0 / save_ms,
+        save_allocs, load_ms, size_mb * 1000.0 / load_ms, round_trip ? "OK" : "FAILED", error.c_str());
+
+    delete loaded;
+    delete builder;
+    remove(path);
+    return round_trip;
+}
+
+// Incremental code generation: edit one element at a time and regenerate the whole document through a CodeCache.
+// Every incremental output is checked against a generation from scratch.
+static bool RunCodeCacheBenchmark(int element_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ElementStore& elements = builder->GetElements();
+
+    CodeCache* cache = new CodeCache();
+    BenchClock::time_point start = BenchClock::now();
+    cache->GenerateDocument(elements, "Benchmark", "benchmark.h");
+    const double full_ms = MillisecondsSince(start);
+    start = BenchClock::now();
+    cache->GenerateDocument(elements, "Benchmark", "benchmark.h");
+    const double unchanged_ms = MillisecondsSince(start);
+
+    // Value edits, hide/show, add and remove, spread over the document
+    const int edits = 64;
+    double edit_ms = 0.0;
+    int generated = 0;
+    bool ok = true;
+    CodeBuffer header, source;
+    srand(1);
+    for (int n = 0; n < edits; n++)
+    {
+        ElementIndex element = (ElementIndex)(rand() % (int)elements.types.size());
+        if (!elements.IsAlive(element))
+            continue;
+        switch (n % 4)
+        {
+        case 0:
+            if (float* value = elements.EditFloat(element))
+                *value += 1.0f;
+            elements.Touch(element);
+            break;
+        case 1: elements.flags[element] ^= ElementFlags_Visible; elements.Touch(element); break;
+        case 2: builder->AddElement(ElementType::SLIDER_INT, "Added", elements.links[element].parent); break;
+        case 3: elements.Remove(element); break;
+        }
+        start = BenchClock::now();
+        cache->GenerateDocument(elements, "Benchmark", "benchmark.h");
+        edit_ms += MillisecondsSince(start);
+        generated += cache->GetGeneratedCount();
+
+        GenerateDocumentCode(elements, "Benchmark", "benchmark.h", header, source);
+        const CodeBuffer& cached = cache->GetSource();
+        ok &= cached.Size() == source.Size() && memcmp(cached.Begin(), source.Begin(), source.Size()) == 0;
+    }
+    printf("%10d %10.3f %12.3f %10.3f %12.1f %10s\n", element_count, full_ms, unchanged_ms, edit_ms / edits, (double)generated / edits, ok ? "OK" : "FAILED");
+
+    delete cache;
+    delete builder;
+    return ok;
+}
+
+// Whole-document code generation on 1, 2, 4... threads up to the hardware thread count.
+// Every output is checked against the single-threaded GenerateDocumentCode().
+static bool RunParallelCodegenBenchmark(int element_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    const ElementStore& elements = builder->GetElements();
+
+    CodeBuffer header, source;
+    GenerateDocumentCode(elements, "Benchmark", "benchmark.h", header, source);
+
+    const int hardware_threads = (int)std::thread::hardware_concurrency() > 1 ? (int)std::thread::hardware_concurrency() : 1;
+    double single_thread_ms = 0.0;
+    bool ok = true;
+    for (int threads = 1; ; threads = (threads * 2 < hardware_threads) ? threads * 2 : hardware_threads)
+    {
+        ThreadPool* pool = new ThreadPool(threads);
+        ParallelCodeGenerator* generator = new ParallelCodeGenerator();
+        generator->GenerateDocument(*pool, elements, "Benchmark", "benchmark.h"); // Warm up buffers and threads
+        double best_ms = 1e30;
+        int steals = 0;
+        for (int run = 0; run < 5; run++)
+        {
+            BenchClock::time_point start = BenchClock::now();
+            generator->GenerateDocument(*pool, elements, "Benchmark", "benchmark.h");
+            const double ms = MillisecondsSince(start);
+            if (ms < best_ms)
+            {
+                best_ms = ms;
+                steals = pool->GetStealCount();
+            }
+        }
+        if (threads == 1)
+            single_thread_ms = best_ms;
+        const CodeBuffer& parallel = generator->GetSource();
+        const bool same = parallel.Size() == source.Size() && memcmp(parallel.Begin(), source.Begin(), source.Size()) == 0;
+        ok &= same;
+        printf("%10d %10d %10.3f %10.2f %10d %10d %10s\n", element_count, threads, best_ms, single_thread_ms / best_ms,
+            generator->GetChunkCount(), steals, same ? "OK" : "FAILED");
+        delete generator;
+        delete pool;
+        if (threads == hardware_threads)
+            break;
+    }
+
+    delete builder;
+    return ok;
+}
+
+// A property edit every element has: its float value, or its width for the types without one
+static void SetFloatOrWidth(ElementStore& elements, ElementIndex element, float value)
+{
+    if (float* float_value = elements.EditFloat(element))
+        *float_value = value;
+    else
+        elements.styles[element].size.x = value;
+}
+
+// One random edit anywhere in the document, recorded into 'history' the way the builder UI records it.
+static void RandomRecordedEdit(ImGuiBuilder& builder, EditHistory& history, unsigned int& seed, int edit, int min_size)
+{
+    ElementStore& elements = builder.GetElements();
+    auto random = [&seed](int range) { seed = seed * 1664525u + 1013904223u; return (int)((seed >> 8) % (unsigned int)range); };
+    ElementIndex element;
+    do
+        element = random((int)elements.types.size());
+    while (!elements.IsAlive(element));
+
+    const int op = random(100);
+    if (op < 50)
+    {
+        history.BeginEdit(elements, element);
+        switch (random(4))
+        {
+        case 0:
+        {
+            char label[64];
+            snprintf(label, sizeof(label), "Edited %d", edit);
+            elements.SetLabel(element, label);
+            break;
+        }
+        case 1: SetFloatOrWidth(elements, element, (float)edit); break;
+        case 2: elements.styles[element].bg_color = ImVec4(0.1f, 0.2f, 0.3f, 1.0f); break;
+        default: elements.flags[element] ^= ElementFlags_Visible; break;
+        }
+        elements.Touch(element);
+        history.EndEdit(elements);
+    }
+    else if (op < 65 || elements.Size() < min_size)
+    {
+        history.RecordInsert(elements, builder.AddElement(ElementType::BUTTON, "Inserted", random(2) ? element : ElementIndex_None));
+    }
+    else if (op < 80)
+    {
+        history.RecordRemove(elements, element);
+        elements.Remove(element);
+    }
+    else
+    {
+        const ElementIndex old_parent = elements.Parent(element), old_before = elements.NextSibling(element);
+        ElementIndex parent;
+        do
+            parent = random((int)elements.types.size());
+        while (!elements.IsAlive(parent));
+        if (elements.Move(element, parent, elements.FirstChild(parent)))
+            history.RecordMove(elements, element, old_parent, old_before);
+    }
+    history.Seal();
+}
+
+// Undo/redo: random edits of every kind, then undo them all (the document must be back to what was saved before)
+// and redo them all (back to what was saved after). Then a long session of property edits in the default budget.
+static bool RunHistoryBenchmark(int element_count, int edit_count)
+{
+    const char* before_path = "builder_benchmark_before.imgb";
+    const char* after_path = "builder_benchmark_after.imgb";
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ElementStore& elements = builder->GetElements();
+    EditHistory* history = new EditHistory(64 * 1024 * 1024);
+    std::string error;
+    bool ok = SaveProjectBinary(elements, "Benchmark", before_path, &error);
+
+    unsigned int seed = 4242;
+    BenchClock::time_point start = BenchClock::now();
+    for (int edit = 0; edit < edit_count; edit++)
+        RandomRecordedEdit(*builder, *history, seed, edit, element_count / 2);
+    const double record_ms = MillisecondsSince(start);
+    const EditHistoryStats stats = history->GetStats();
+    ok &= SaveProjectBinary(elements, "Benchmark", after_path, &error);
+
+    int undone = 0;
+    double max_undo_us = 0.0;
+    start = BenchClock::now();
+    for (;;)
+    {
+        BenchClock::time_point step_start = BenchClock::now();
+        if (!history->Undo(elements))
+            break;
+        const double step_us = MillisecondsSince(step_start) * 1000.0;
+        max_undo_us = step_us > max_undo_us ? step_us : max_undo_us;
+        undone++;
+    }
+    const double undo_ms = MillisecondsSince(start);
+    ElementStore* saved = new ElementStore();
+    const char* name = nullptr;
+    const bool undo_ok = ok && undone == stats.steps && LoadProjectBinary(*saved, before_path, &name, &error) && DocumentsEqual(elements, *saved);
+
+    start = BenchClock::now();
+    int redone = 0;
+    while (history->Redo(elements))
+        redone++;
+    const double redo_ms = MillisecondsSince(start);
+    const bool redo_ok = ok && redone == stats.steps && LoadProjectBinary(*saved, after_path, &name, &error) && DocumentsEqual(elements, *saved);
+
+    // Long session: every property edit is a step of its own, the oldest fall out of the default budget
+    const int session_edits = 1000000;
+    history->SetCapacity(1024 * 1024);
+    start = BenchClock::now();
+    for (unsigned int edit = 0, n = 0; edit < (unsigned int)session_edits; n++)
+    {
+        const ElementIndex element = (ElementIndex)((n * 7919u) % elements.types.size());
+        if (!elements.IsAlive(element))
+            continue;
+        edit++;
+        history->BeginEdit(elements, element);
+        SetFloatOrWidth(elements, element, (float)edit);
+        elements.Touch(element);
+        history->EndEdit(elements);
+        history->Seal();
+    }
+    const double session_ms = MillisecondsSince(start);
+    const EditHistoryStats session = history->GetStats();
+
+    printf("%10d %10d %10d %10.3f %10.1f %10.3f %10.1f %10.3f %10s %10s\n", element_count, edit_count, stats.steps, record_ms, stats.bytes_used / 1024.0,
+        undo_ms, max_undo_us, redo_ms, undo_ok ? "OK" : "FAILED", redo_ok ? "OK" : "FAILED");
+    printf("%10s session of %d property edits: %.3f ms, %d steps kept in %.1f KB, %d evicted\n", "", session_edits, session_ms, session.steps,
+        session.bytes_used / 1024.0, session.evicted_steps);
+
+    delete saved;
+    delete history;
+    delete builder;
+    remove(before_path);
+    remove(after_path);
+    return undo_ok && redo_ok;
+}
+
+// Walks the whole tree checking every link against its neighbours, the element count and the uid map.
+static bool CheckTree(const ElementStore& elements, ElementIndex parent, int* count)
+{
+    ElementIndex prev = ElementIndex_None;
+    for (ElementIndex child = elements.FirstChild(parent); child != ElementIndex_None; child = elements.NextSibling(child))
+    {
+        if (!elements.IsAlive(child) || elements.Parent(child) != parent || elements.PrevSibling(child) != prev ||
+            elements.FindByUid(elements.uids[child]) != child || ++(*count) > elements.Size())
+            return false;
+        if (!CheckTree(elements, child, count))
+            return false;
+        prev = child;
+    }
+    return elements.LastChild(parent) == prev;
+}
+
+// Random structural edits anywhere in the tree: moves (reparenting, with cycles refused), reorders, duplicates in
+// place, inserts and deletes. Every edit is O(1) or O(depth); the tree is checked link by link at the end.
+static bool RunStructureBenchmark(int element_count, int edit_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ElementStore& elements = builder->GetElements();
+
+    unsigned int seed = 12345;
+    auto random = [&seed](int range) { seed = seed * 1664525u + 1013904223u; return (int)((seed >> 8) % (unsigned int)range); };
+    auto random_element = [&]()
+    {
+        for (;;)
+        {
+            const ElementIndex index = random((int)elements.types.size());
+            if (elements.IsAlive(index))
+                return index;
+        }
+    };
+
+    int moves = 0, refused = 0, duplicates = 0, inserts = 0, removes = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (int edit = 0; edit < edit_count; edit++)
+    {
+        const ElementIndex element = random_element();
+        const int op = random(100);
+        if (op < 40)
+        {
+            // Reparent under a random element, or to the top level
+            const ElementIndex parent = random(16) == 0 ? ElementIndex_None : random_element();
+            const ElementIndex before = random(2) == 0 ? ElementIndex_None : elements.FirstChild(parent);
+            if (before != element && elements.Move(element, parent, before))
+                moves++;
+            else
+                refused++;
+        }
+        else if (op < 60)
+        {
+            // Reorder among siblings
+            const ElementIndex prev = elements.PrevSibling(element);
+            if (prev != ElementIndex_None)
+                elements.Move(element, elements.Parent(element), prev);
+            moves++;
+        }
+        else if (op < 70 && elements.FirstChild(element) == ElementIndex_None)
+        {
+            elements.Insert(elements.Parent(element), elements.NextSibling(element), elements.Duplicate(element));
+            duplicates++;
+        }
+        else if (op < 85 || elements.Size() < element_count / 2)
+        {
+            builder->AddElement(ElementType::BUTTON, "Inserted", element);
+            inserts++;
+        }
+        else
+        {
+            elements.Remove(element);
+            removes++;
+        }
+    }
+    const double edit_ms = MillisecondsSince(start);
+
+    int count = 0;
+    start = BenchClock::now();
+    const bool ok = CheckTree(elements, ElementIndex_None, &count) && count == elements.Size() && elements.HasUniqueUids();
+    const double check_ms = MillisecondsSince(start);
+
+    printf("%10d %10d %10.3f %10.1f %10d %10d %10d %10d %10d %10.3f %10s\n", element_count, edit_count, edit_ms, edit_ms * 1e6 / edit_count,
+        moves, refused, duplicates, inserts, removes, check_ms, ok ? "OK" : "FAILED");
+    delete builder;
+    return ok;
+}
+
+// Reference for the search index: every alive element, plain case-insensitive substring test.
+static void FindByScan(const ElementStore& elements, const char* query, std::vector<ElementIndex>& out)
+{
+    out.clear();
+    for (ElementIndex index = 0; index < (ElementIndex)elements.types.size(); index++)
+    {
+        if (!(elements.flags[index] & ElementFlags_Alive))
+            continue;
+        const char* fields[3] = { elements.strings[index].label, elements.strings[index].text_value, GetElementTypeName(elements.types[index]) };
+        for (const char* field : fields)
+        {
+            bool found = false;
+            for (const char* start = field; *start && !found; start++)
+            {
+                size_t n = 0;
+                while (query[n] && start[n] && tolower((unsigned char)start[n]) == tolower((unsigned char)query[n]))
+                    n++;
+                found = query[n] == 0;
+            }
+            if (found)
+            {
+                out.push_back(index);
+                break;
+            }
+        }
+    }
+}
+
+// Element tree search: full index build, re-sync after a single edit, and queries, checked against a linear scan.
+static bool RunSearchBenchmark(int element_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ElementStore& elements = builder->GetElements();
+    ElementSearchIndex* index = new ElementSearchIndex();
+
+    BenchClock::time_point start = BenchClock::now();
+    index->Sync(elements);
+    const double build_ms = MillisecondsSince(start);
+
+    const ElementIndex edited = elements.FirstChild(elements.FirstChild(ElementIndex_None));
+    elements.SetLabel(edited, "Needle in the haystack");
+    start = BenchClock::now();
+    index->Sync(elements);
+    const double sync_ms = MillisecondsSince(start);
+    const int reindexed = index->GetReindexedCount();
+
+    static const char* const queries[] = { "needle", "Element 4711", "header 12", "button", "zz", "x", "no such label" };
+    std::vector<ElementIndex> found, expected;
+    double find_ms = 0.0;
+    bool ok = reindexed == 1;
+    for (const char* query : queries)
+    {
+        start = BenchClock::now();
+        index->Find(elements, query, found);
+        find_ms += MillisecondsSince(start);
+        FindByScan(elements, query, expected);
+        std::sort(found.begin(), found.end());
+        ok &= found == expected;
+    }
+    index->Find(elements, "needle", found);
+    ok &= found.size() == 1 && found[0] == edited;
+
+    printf("%10d %10.3f %10.3f %10d %10.3f %10s\n", element_count, build_ms, sync_ms, reindexed, find_ms / IM_ARRAYSIZE(queries), ok ? "OK" : "FAILED");
+    delete index;
+    delete builder;
+    return ok;
+}
+
+// Frame profiler: cost of one timed scope, frames with the profiler on and off (neither may allocate), and a trace
+// of a few frames exported then read back as JSON.
+static bool RunProfilerBenchmark(int element_count, int frames)
+{
+    // One scope, on a profiler of its own
+    FrameProfiler* bench_profiler = new FrameProfiler();
+    const int scope_count = 10000000;
+    BenchClock::time_point start = BenchClock::now();
+    for (int n = 0; n < scope_count; n++)
+    {
+        ProfileScope scope(*bench_profiler, ProfileZone_ElementPreview, n % ElementType_COUNT);
+    }
+    const double scope_ns = MillisecondsSince(start) * 1e6 / scope_count;
+    delete bench_profiler;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ElementStore& elements = builder->GetElements();
+    for (ElementIndex element = elements.FirstChild(ElementIndex_None); element != ElementIndex_None; element = elements.NextSibling(element))
+        if (elements.FirstChild(element) != ElementIndex_None)
+            elements.flags[element] |= ElementFlags_Open | ElementFlags_Expanded;
+    FrameProfiler& profiler = builder->GetProfiler();
+
+    double frame_ms[2] = { 0.0, 0.0 };
+    size_t allocs = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        profiler.SetEnabled(pass == 0);
+        for (int n = 0; n < 3 + frames; n++)
+        {
+            const size_t frame_allocs = HeapAllocCount();
+            start = BenchClock::now();
+            ImGui::NewFrame();
+            builder->Render();
+            ImGui::Render();
+            if (n < 3)
+                continue;
+            frame_ms[pass] += MillisecondsSince(start) / frames;
+            allocs += HeapAllocCount() - frame_allocs;
+        }
+    }
+    profiler.SetEnabled(true);
+
+    // Trace a few frames (the buffer is allocated by StartTrace, not by the frames)
+    const char* path = "builder_benchmark_trace.json";
+    const int trace_frames = 5;
+    profiler.StartTrace(1000000);
+    int scopes_per_frame = 0;
+    for (int n = 0; n < trace_frames; n++)
+    {
+        const size_t frame_allocs = HeapAllocCount();
+        ImGui::NewFrame();
+        builder->Render();
+        ImGui::Render();
+        allocs += HeapAllocCount() - frame_allocs;
+        scopes_per_frame = profiler.GetLastScopeCount();
+    }
+    profiler.StopTrace();
+    std::string error;
+    bool exported = profiler.ExportTrace(path, &error);
+
+    // Read it back: one "ph" key per event
+    int read_events = 0;
+    if (FILE* f = fopen(path, "rb"))
+    {
+        JsonReader reader(f);
+        for (JsonToken token = reader.Next(); token != JsonToken::End; token = reader.Next())
+        {
+            if (token == JsonToken::Error)
+            {
+                exported = false;
+                error = reader.GetError();
+                break;
+            }
+            if (token == JsonToken::Key && strcmp(reader.GetString(), "ph") == 0)
+                read_events++;
+        }
+        fclose(f);
+    }
+    const int trace_events = profiler.GetTraceEventCount();
+    const bool trace_ok = exported && trace_events == scopes_per_frame * trace_frames && read_events == trace_events;
+    printf("%10d %10d %10.1f %10.3f %10.3f %10zu %10d %10s %s\n", element_count, scopes_per_frame, scope_ns, frame_ms[0], frame_ms[1],
+        allocs, trace_events, trace_ok ? "OK" : "FAILED", error.c_str());
+
+    delete builder;
+    ImGui::DestroyContext();
+    remove(path);
+    return trace_ok && allocs == 0;
+}
+
+// Frame scheduling: a simulated clock and synthetic event streams drive a FrameScheduler the way the platform loop
+// does (block until the timeout or the next event, every rendered frame lasts one refresh interval). While serving
+// live applications, the loop must also wake up once per poll interval without rendering more frames.
+struct SchedulerScenario
+{
+    const char* Name;
+    bool RedrawAlways;
+    double EventStart, EventEnd, EventInterval;     // Input events in [start, end)
+    double ActiveStart, ActiveEnd;                  // A widget is being dragged
+    double TextStart, TextEnd;                      // A text box has the keyboard
+    double ChangeInterval;                          // Document edited without input (0: never)
+    double PollInterval;                            // Idle wake-ups to poll sockets (0: none)
+};
+
+static bool RunSchedulerBenchmark(const SchedulerScenario& scenario)
+{
+    const double seconds = 60.0, refresh = 1.0 / 60.0, never = 1e30;
+    const int settle_frames = 3;
+    FrameScheduler scheduler(refresh, settle_frames);
+    scheduler.SetEnabled(!scenario.RedrawAlways);
+    scheduler.SetPollInterval(scenario.PollInterval > 0.0 ? scenario.PollInterval : -1.0);
+
+    double now = 0.0;
+    double next_event = scenario.EventInterval > 0.0 ? scenario.EventStart : never;
+    double next_change = scenario.ChangeInterval > 0.0 ? scenario.ChangeInterval : never;
+    double unserved = never;                        // Oldest event or change no frame has shown yet
+    double max_latency = 0.0;
+    ImU64 revision = 0;
+    int changes = 0;
+    scheduler.NotifyRevision(revision);
+    while (now < seconds)
+    {
+        const double timeout = scheduler.GetTimeout(now);
+        if (timeout != 0.0)
+        {
+            const double wake = timeout < 0.0 ? never : now + timeout;
+            now = std::max(now, std::min(wake, std::min(next_event, next_change)));
+            if (now >= seconds)
+                break;
+        }
+        for (; next_event <= now && next_event < scenario.EventEnd; next_event += scenario.EventInterval)
+        {
+            scheduler.OnEvent(next_event);
+            unserved = std::min(unserved, next_event);
+        }
+        if (next_event >= scenario.EventEnd)
+            next_event = never;
+        for (; next_change <= now; next_change += scenario.ChangeInterval)
+        {
+            revision++;
+            changes++;
+            unserved = std::min(unserved, next_change);
+        }
+        scheduler.NotifyRevision(revision);
+
+        if (!scheduler.ShouldRender(now))
+            continue;
+        if (unserved != never)
+            max_latency = std::max(max_latency, now - unserved);
+        unserved = never;
+        now += refresh;
+        const bool active = now >= scenario.ActiveStart && now < scenario.ActiveEnd;
+        const bool text = now >= scenario.TextStart && now < scenario.TextEnd;
+        scheduler.EndFrame(now, active, text ? 0.4 : -1.0);
+    }
+
+    // Frames needed: settling after each event and change, continuous while dragging, the cursor blinking
+    const FrameSchedulerStats stats = scheduler.GetStats(seconds);
+    const double active_seconds = scenario.ActiveEnd - scenario.ActiveStart;
+    const double text_seconds = scenario.TextEnd - scenario.TextStart;
+    const int needed = 1 + (stats.events + changes) * settle_frames + (int)(active_seconds / refresh) + (int)(text_seconds / 0.4) + 1;
+    bool ok = max_latency <= 2.0 * refresh + 1e-9;
+    if (scenario.RedrawAlways)
+        ok = ok && stats.frames_skipped <= 1;
+    else
+        ok = ok && stats.frames_rendered <= needed && stats.frames_rendered >= (int)(active_seconds / refresh) - 1;
+    // Polling wakes the loop up without rendering
+    if (scenario.PollInterval > 0.0)
+        ok = ok && stats.wakeups >= (int)(seconds / scenario.PollInterval) - stats.frames_rendered - 1;
+    printf("%14s %10.0f %10d %10d %10d %10d %10.1f %10.1f %10s\n", scenario.Name, seconds, stats.events, changes, stats.frames_rendered,
+        stats.frames_skipped, 100.0 * stats.frames_skipped / (stats.frames_rendered + stats.frames_skipped), max_latency * 1000.0, ok ? "OK" : "FAILED");
+    return ok;
+}
+
+// Batch code generation (builder_cli): a cold run generates every project, a second run with the saved cache skips
+// them all, then only an edited project and one whose outputs were deleted are generated again.
+static bool FileMatchesCode(const char* path, const CodeBuffer& code)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+    std::vector<char> data(code.Size() + 1);
+    const size_t size = fread(data.data(), 1, data.size(), f);
+    fclose(f);
+    return size == code.Size() && memcmp(data.data(), code.Begin(), size) == 0;
+}
+
+static bool RunBatchBenchmark(int project_count, int element_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    const ElementStore& elements = builder->GetElements();
+
+    // Every other project is JSON
+    std::vector<BatchProject> projects(project_count);
+    char path[64];
+    for (int n = 0; n < project_count; n++)
+    {
+        snprintf(path, sizeof(path), "builder_batch_%d%s", n, (n & 1) ? ".json" : ".imgb");
+        projects[n].input = path;
+        snprintf(path, sizeof(path), "builder_batch_%d_gen", n);
+        projects[n].output_base = path;
+        snprintf(path, sizeof(path), "Batch%d", n);
+        SaveProjectFile(elements, path, projects[n].input.c_str());
+    }
+    const char* cache_path = "builder_batch_cache.json";
+
+    std::vector<BatchResult> results;
+    BatchCodeGenerator* generator = new BatchCodeGenerator();
+    BenchClock::time_point start = BenchClock::now();
+    const BatchStats cold = generator->Run(projects, results);
+    const double cold_ms = MillisecondsSince(start);
+    bool ok = cold.generated == project_count && generator->SaveCache(cache_path);
+    delete generator;
+
+    // New process: the cache is read back from its file
+    generator = new BatchCodeGenerator();
+    ok = ok && generator->LoadCache(cache_path);
+    start = BenchClock::now();
+    const BatchStats warm = generator->Run(projects, results);
+    const double warm_ms = MillisecondsSince(start);
+    ok = ok && warm.skipped == project_count;
+
+    SaveProjectFile(elements, "Edited", projects[0].input.c_str());
+    snprintf(path, sizeof(path), "%s.cpp", projects[1].output_base.c_str());
+    remove(path);
+    start = BenchClock::now();
+    const BatchStats edit = generator->Run(projects, results);
+    const double edit_ms = MillisecondsSince(start);
+    ok = ok && edit.generated == 2 && edit.skipped == project_count - 2 && edit.failed == 0;
+
+    // Same code as the builder's own export
+    CodeBuffer header, source;
+    GenerateDocumentCode(elements, "Edited", "builder_batch_0_gen.h", header, source);
+    ok = ok && FileMatchesCode("builder_batch_0_gen.h", header) && FileMatchesCode("builder_batch_0_gen.cpp", source);
+
+    printf("%10d %10d %10d %10.2f %10.2f %10.2f %10.1f %10s\n", project_count, element_count, generator->GetThreadCount(), cold_ms, warm_ms, edit_ms,
+        cold.bytes_read / (1024.0 * 1024.0), ok ? "OK" : "FAILED");
+
+    for (const BatchProject& project : projects)
+    {
+        remove(project.input.c_str());
+        remove((project.output_base + ".h").c_str());
+        remove((project.output_base + ".cpp").c_str());
+    }
+    remove(cache_path);
+    delete generator;
+    delete builder;
+    return ok;
+}
+
+// Live preview: a builder serving its document and an application following it over a loopback connection, both
+// polled from this thread. Each random edit is sent and applied before the next one: latency goes from the edit to
+// the application's copy updated. A second application connects halfway, and the first one reconnects at the end:
+// all copies must match the document.
+static bool PollUntilMessage(LiveServer& server, const ElementStore& elements, LiveClient& client, ElementStore& mirror, int messages)
+{
+    BenchClock::time_point start = BenchClock::now();
+    while (client.GetStats().messages < messages)
+    {
+        if (MillisecondsSince(start) > 2000.0)
+            return false;
+        server.Poll(elements);
+        client.Poll(mirror);
+    }
+    return true;
+}
+
+// Until the client caught up with every message already sent
+static bool PollUntilEqual(LiveServer& server, const ElementStore& elements, LiveClient& client, ElementStore& mirror)
+{
+    BenchClock::time_point start = BenchClock::now();
+    while (!DocumentsEqual(elements, mirror))
+    {
+        if (MillisecondsSince(start) > 2000.0)
+            return false;
+        server.Poll(elements);
+        client.Poll(mirror);
+    }
+    return true;
+}
+
+static bool RunLiveBenchmark(int element_count, int edit_count)
+{
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ElementStore& elements = builder->GetElements();
+    EditHistory history;
+    LiveServer server;
+    LiveClient client, late_client;
+    ElementStore* mirror = new ElementStore();
+    ElementStore* late_mirror = new ElementStore();
+    std::string error;
+    if (!server.Listen(0, &error))
+    {
+        printf("%10d %s\n", element_count, error.c_str());
+        delete builder;
+        return false;
+    }
+
+    client.Connect(server.GetPort());
+    BenchClock::time_point start = BenchClock::now();
+    bool ok = PollUntilMessage(server, elements, client, *mirror, 1);
+    const double snapshot_ms = MillisecondsSince(start);
+    const size_t snapshot_bytes = client.GetStats().bytes_received;
+    ok = ok && DocumentsEqual(elements, *mirror);
+
+    std::vector<double> latencies;
+    latencies.reserve(edit_count);
+    size_t delta_bytes = 0;
+    unsigned int seed = 1;
+    for (int edit = 0; edit < edit_count && ok; edit++)
+    {
+        if (edit == edit_count / 2)
+        {
+            late_client.Connect(server.GetPort());
+            ok = PollUntilMessage(server, elements, late_client, *late_mirror, 1);
+        }
+        const int messages = server.GetStats().messages;
+        BenchClock::time_point edit_start = BenchClock::now();
+        RandomRecordedEdit(*builder, history, seed, edit, element_count / 2);
+        server.Poll(elements);
+        if (server.GetStats().messages == messages)
+            continue;   // Refused move, or a value set to what it was
+        const int received = client.GetStats().messages + 1;
+        while (client.GetStats().messages < received && MillisecondsSince(edit_start) < 2000.0)
+            client.Poll(*mirror);
+        latencies.push_back(MillisecondsSince(edit_start));
+        delta_bytes += server.GetStats().last_message_size;
+        ok = client.GetStats().messages == received;
+    }
+    ok = ok && DocumentsEqual(elements, *mirror);
+    ok = ok && PollUntilEqual(server, elements, late_client, *late_mirror);
+
+    // Reconnecting starts again from a snapshot
+    client.Disconnect();
+    client.Connect(server.GetPort());
+    client.ResetStats();
+    ok = ok && PollUntilMessage(server, elements, client, *mirror, 1) && DocumentsEqual(elements, *mirror);
+    ok = ok && server.GetStats().snapshots == 3 && client.GetStats().errors == 0 && late_client.GetStats().errors == 0;
+
+    // A message with a combo selecting past its items must be rejected, not applied
+    {
+        ImGuiBuilder* corrupted = new ImGuiBuilder();
+        ElementStore& corrupted_elements = corrupted->GetElements();
+        const ElementIndex combo = corrupted->AddElement(ElementType::COMBO, "Combo");
+        corrupted_elements.EditItemList(combo)->selected_item = corrupted_elements.GetItemCount(combo);
+        LiveDeltaWriter writer;
+        LiveDeltaReader reader;
+        std::vector<unsigned char> message;
+        ElementStore* corrupted_mirror = new ElementStore();
+        ok = ok && writer.Write(corrupted_elements, message) && !reader.Apply(*corrupted_mirror, message.data(), message.size());
+        delete corrupted_mirror;
+        delete corrupted;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const int deltas = (int)latencies.size();
+    double total_ms = 0.0;
+    for (double latency : latencies)
+        total_ms += latency;
+    const double p99_ms = deltas > 0 ? latencies[(size_t)(deltas * 0.99)] : 0.0;
+    const double max_ms = deltas > 0 ? latencies.back() : 0.0;
+    // An edit must reach the application within one 60 Hz frame
+    ok = ok && max_ms < 1000.0 / 60.0;
+    printf("%10d %10d %10.1f %10.3f %10d %10.0f %10.3f %10.3f %10.3f %10s\n", element_count, edit_count, snapshot_bytes / 1024.0, snapshot_ms,
+        deltas, deltas > 0 ? (double)delta_bytes / deltas : 0.0, deltas > 0 ? total_ms / deltas : 0.0, p99_ms, max_ms, ok ? "OK" : "FAILED");
+
+    server.Close();
+    delete late_mirror;
+    delete mirror;
+    delete builder;
+    return ok;
+}
+
+// Layout runtime: the same document drawn by its generated code (runtime_layout.cpp, compiled into the benchmark)
+// and by a LayoutProgram, alternately in the same window. Only the layout call is timed: the frame around it is
+// the same for both. Both must draw the same vertices, the program must not allocate, and runtime_layout.cpp must
+// still be what the generator writes for the document (regenerate it with GenerateDocumentCode() when it is not).
+static const int RUNTIME_LAYOUT_ELEMENTS = 256;
+
+static bool RunRuntimeBenchmark(int frames)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, RUNTIME_LAYOUT_ELEMENTS);
+    CodeBuffer header, source;
+    GenerateDocumentCode(builder->GetElements(), "Runtime Layout", "runtime_layout.h", header, source);
+    std::string path = __FILE__;
+    path = path.substr(0, path.find_last_of("/\\") + 1) + "runtime_layout.cpp";
+    const bool same_code = FileMatchesCode(path.c_str(), source);
+
+    LayoutProgram* program = new LayoutProgram();
+    BenchClock::time_point start = BenchClock::now();
+    program->Compile(builder->GetElements(), "Runtime Layout");
+    const double compile_ms = MillisecondsSince(start);
+
+    const int warmup_frames = 3;
+    const int pairs = frames * 10;
+    double generated_ms = 0.0, interpreted_ms = 0.0;
+    size_t allocs = 0;
+    bool same_output = true;
+    for (int n = 0; n < warmup_frames + pairs; n++)
+    {
+        const bool measure = (n >= warmup_frames);
+        ImGui::NewFrame();
+        start = BenchClock::now();
+        RenderRuntimeLayout();
+        const double ms = MillisecondsSince(start);
+        ImGui::Render();
+        const int vertices = ImGui::GetDrawData()->TotalVtxCount;
+
+        ImGui::NewFrame();
+        const size_t alloc_count = HeapAllocCount();
+        start = BenchClock::now();
+        program->Render();
+        const double program_ms = MillisecondsSince(start);
+        const size_t program_allocs = HeapAllocCount() - alloc_count;
+        ImGui::Render();
+        same_output &= ImGui::GetDrawData()->TotalVtxCount == vertices;
+        if (!measure)
+            continue;
+        generated_ms += ms;
+        interpreted_ms += program_ms;
+        allocs += program_allocs;
+    }
+    generated_ms /= pairs;
+    interpreted_ms /= pairs;
+
+    const bool ok = same_code && same_output && allocs == 0;
+    printf("%10d %10d %10.1f %10.3f %12.4f %12.4f %10.1f %10.1f %10s\n", RUNTIME_LAYOUT_ELEMENTS, (int)program->GetOps().size(),
+        program->GetMemorySize() / 1024.0, compile_ms, generated_ms, interpreted_ms,
+        generated_ms > 0.0 ? (interpreted_ms / generated_ms - 1.0) * 100.0 : 0.0, (double)allocs / pairs,
+        !same_code ? "STALE" : ok ? "OK" : "FAILED");
+    delete program;
+    delete builder;
+    ImGui::DestroyContext();
+    return ok;
+}
+
+// Background tasks: save, export and load of the whole document started from the UI, while frames keep rendering
+// with an edit in each. Compared with the same operations run inside a frame (the stall the UI used to take).
+// Checks: the file saved and the code exported are those of the document when they were started, the loaded document
+// replaces the edited one, and a task cancelled before it ran leaves nothing behind.
+static bool RunTaskBenchmark(int element_count)
+{
+    const char* project_path = "builder_tasks.imgb";
+    const char* code_path = "builder_tasks";
+    const char* cancelled_path = "builder_tasks_cancelled";
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    builder->SetMenuVisible(true);
+    ElementStore& elements = builder->GetElements();
+    for (int n = 0; n < 3; n++)
+    {
+        ImGui::NewFrame();
+        builder->Render();
+        ImGui::Render();
+    }
+
+    // In a frame
+    BenchClock::time_point start = BenchClock::now();
+    bool ok = builder->SaveProject(project_path);
+    ok &= builder->ExportCode(code_path);
+    ok &= builder->LoadProject(project_path);
+    const double sync_ms = MillisecondsSince(start);
+
+    // As tasks: the document they work on is the one of this moment
+    ElementStore* expected = new ElementStore();
+    expected->CopySnapshot(elements);
+    TaskQueue& tasks = builder->GetTasks();
+    start = BenchClock::now();
+    builder->StartSave(project_path);
+    builder->StartExport(code_path);
+    builder->StartLoad(project_path);
+    tasks.Cancel(builder->StartExport(cancelled_path));
+    const double start_ms = MillisecondsSince(start);
+
+    int frames = 0;
+    double max_frame_ms = 0.0;
+    start = BenchClock::now();
+    while (tasks.IsBusy())
+    {
+        // Edits made meanwhile are discarded by the load
+        const ElementIndex element = (ElementIndex)(frames * 7919 % (int)elements.types.size());
+        if (elements.IsAlive(element))
+        {
+            if (float* value = elements.EditFloat(element))
+                *value += 1.0f;
+            elements.Touch(element);
+        }
+        const BenchClock::time_point frame_start = BenchClock::now();
+        ImGui::NewFrame();
+        builder->Render();
+        ImGui::Render();
+        const double ms = MillisecondsSince(frame_start);
+        max_frame_ms = (ms > max_frame_ms) ? ms : max_frame_ms;
+        frames++;
+    }
+    const double async_ms = MillisecondsSince(start);
+
+    ElementStore* saved = new ElementStore();
+    const char* name = nullptr;
+    ok &= LoadProjectFile(*saved, project_path, &name) && DocumentsEqual(*expected, *saved);
+    CodeBuffer header, source;
+    GenerateDocumentCode(*expected, name, "builder_tasks.h", header, source);
+    ok &= FileMatchesCode("builder_tasks.h", header) && FileMatchesCode("builder_tasks.cpp", source);
+    ok &= DocumentsEqual(*expected, elements);
+    const TaskQueueStats& stats = tasks.GetStats();
+    ok &= stats.done == 3 && stats.cancelled == 1 && stats.failed == 0;
+    FILE* f = fopen("builder_tasks_cancelled.h", "rb");
+    ok &= f == nullptr;
+    if (f)
+        fclose(f);
+    printf("%10d %10.3f %10.3f %10.3f %10d %12.3f %10.3f %10s\n", element_count, sync_ms, start_ms, async_ms, frames, max_frame_ms,
+        stats.max_apply_ms, ok ? "OK" : "FAILED");
+
+    delete saved;
+    delete expected;
+    delete builder;
+    ImGui::DestroyContext();
+    remove(project_path);
+    remove("builder_tasks.h");
+    remove("builder_tasks.cpp");
+    return ok;
+}
+
+// Workspace: many project files opened as tabs. Opening only adds index entries, a body is read when its tab is
+// first shown; switching back to a document in memory is a swap. Checks: each document shown is the one saved under
+// its path, edits survive switching away and back, unmodified bodies are dropped past the limit, a modified document
+// is not closed without asking, saving it before closing writes it even when another document was loaded in between,
+// closing every tab leaves an empty workspace.
+static bool RunWorkspaceBenchmark(int document_count, int element_count)
+{
+    ImGuiBuilder* source = new ImGuiBuilder();
+    BuildSyntheticDocument(*source, element_count);
+    ElementStore& source_elements = source->GetElements();
+    const ElementIndex first = source_elements.FirstChild(ElementIndex_None);
+    char path[64], label[64];
+    bool ok = true;
+    for (int n = 0; n < document_count; n++)
+    {
+        snprintf(path, sizeof(path), "builder_workspace_%d.imgb", n);
+        snprintf(label, sizeof(label), "Document %d", n);
+        source_elements.SetLabel(first, label);
+        ok &= SaveProjectFile(source_elements, label, path);
+    }
+    delete source;
+
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    Workspace& workspace = builder->GetWorkspace();
+    BenchClock::time_point start = BenchClock::now();
+    for (int n = 0; n < document_count; n++)
+    {
+        snprintf(path, sizeof(path), "builder_workspace_%d.imgb", n);
+        builder->OpenDocument(path);
+    }
+    const double open_ms = MillisecondsSince(start);
+    WorkspaceStats stats = workspace.GetStats();
+    // The untitled document the builder started with is the first tab, and the only one in memory
+    ok &= stats.documents == document_count + 1 && stats.loaded == 1;
+    const double index_bytes = (double)stats.index_bytes / stats.documents;
+
+    // First show of a few documents: read on the task queue
+    const int shown = document_count < 32 ? document_count : 32;
+    ElementStore& elements = builder->GetElements();
+    double show_ms = 0.0;
+    for (int n = 0; n < shown; n++)
+    {
+        start = BenchClock::now();
+        builder->ShowDocument(n + 1);
+        builder->GetTasks().WaitIdle();
+        show_ms += MillisecondsSince(start);
+        snprintf(label, sizeof(label), "Document %d", n);
+        ok &= workspace.GetActive() == n + 1 && elements.Size() == element_count && !builder->IsModified() &&
+            strcmp(elements.strings[elements.FirstChild(ElementIndex_None)].label, label) == 0;
+        // Edit the first one: its body must stay in memory, whatever the limit
+        if (n == 0)
+        {
+            elements.SetLabel(elements.FirstChild(ElementIndex_None), "Edited");
+            ok &= builder->IsModified();
+        }
+    }
+    stats = workspace.GetStats();
+    // Limit (8) + the active document + the edited one + the untitled one (never saved)
+    ok &= stats.loaded <= 11;
+
+    // Back to the documents still in memory: a swap, no file access
+    int switches = 0;
+    start = BenchClock::now();
+    for (int n = 0; n < 1000; n++)
+    {
+        const int index = (n & 1) ? 1 : shown;
+        ok &= builder->ShowDocument(index) && workspace.GetActive() == index;
+        switches++;
+    }
+    const double switch_us = MillisecondsSince(start) * 1000.0 / switches;
+    ok &= strcmp(elements.strings[elements.FirstChild(ElementIndex_None)].label, "Edited") == 0 && builder->IsModified();
+
+    // Asked to close, the edited document stays open until the popup is answered, an unmodified one closes
+    const int open_count = workspace.GetCount();
+    builder->RequestCloseDocument(1);
+    ok &= workspace.GetCount() == open_count && builder->IsDocumentModified(1);
+    builder->RequestCloseDocument(2);
+    ok &= workspace.GetCount() == open_count - 1;
+
+    // Saved then closed as a task, while another document loads first and replaces it in the builder: the file gets
+    // the edited document, and only it is closed
+    snprintf(path, sizeof(path), "builder_workspace_%d.imgb", shown + 4);
+    const int next = workspace.Find(path);
+    ok &= workspace.GetActive() == 1 && !builder->ShowDocument(next);
+    builder->StartSaveAndClose(1);
+    builder->GetTasks().WaitIdle();
+    snprintf(label, sizeof(label), "Document %d", shown + 4);
+    ok &= workspace.GetCount() == open_count - 2 && workspace.Find("builder_workspace_0.imgb") < 0 &&
+        strcmp(workspace.Get(workspace.GetActive()).path, path) == 0 &&
+        strcmp(elements.strings[elements.FirstChild(ElementIndex_None)].label, label) == 0;
+    ElementStore* saved = new ElementStore();
+    ok &= LoadProjectFile(*saved, "builder_workspace_0.imgb", nullptr) &&
+        strcmp(saved->strings[saved->FirstChild(ElementIndex_None)].label, "Edited") == 0;
+    delete saved;
+
+    while (workspace.GetCount() > 0)
+        builder->CloseDocument(workspace.GetCount() - 1);
+    ok &= workspace.GetActive() < 0 && elements.Size() == 0 && builder->GetTasks().GetStats().failed == 0;
+
+    printf("%10d %10d %10.3f %10.1f %10.3f %10.3f %10d %10s\n", document_count, element_count, open_ms, index_bytes, show_ms / shown,
+        switch_us, stats.loaded, ok ? "OK" : "FAILED");
+    delete builder;
+    for (int n = 0; n < document_count; n++)
+    {
+        snprintf(path, sizeof(path), "builder_workspace_%d.imgb", n);
+        remove(path);
+    }
+    return ok;
+}
+
+// Components: a block repeated many times, as deep copies ("Duplicate") and as instances of one component, compared
+// on document size (elements, project file) and generated code size. Checks: the incremental and parallel generators
+// write the same code as GenerateDocumentCode() for the instanced document, after edits of the definition and a
+// rename too; the runtime draws every instance (the ops of the copies plus an ID scope each); the project file round
+// trips; a component drawing itself is left out instead of recursing forever; making a component is one undo step,
+// undone back to the original tree and redone. The builder then draws a few frames
+// with an instance selected (preview and properties).
+static ElementIndex BuildSettingsBlock(ImGuiBuilder& builder)
+{
+    const ElementIndex block = builder.AddElement(ElementType::GROUP, "Settings Row");
+    char label[64];
+    for (int n = 0; n < 16; n++)
+    {
+        snprintf(label, sizeof(label), "Setting %d", n);
+        builder.AddElement(g_SyntheticTypes[n % IM_ARRAYSIZE(g_SyntheticTypes)], label, block);
+    }
+    return block;
+}
+
+static int CountOccurrences(const CodeBuffer& code, const char* str)
+{
+    int count = 0;
+    const size_t length = strlen(str);
+    for (const char* p = code.Begin(); p + length <= code.End(); p++)
+        if (*p == *str && memcmp(p, str, length) == 0)
+            count++;
+    return count;
+}
+
+static size_t SavedFileSize(const ElementStore& elements, const char* path)
+{
+    size_t file_size = 0;
+    if (SaveProjectBinary(elements, "Components", path))
+        if (std::shared_ptr<ProjectFileView> view = ProjectFileView::Open(path))
+            file_size = view->GetFileSize();
+    return file_size;
+}
+
+static bool RunComponentBenchmark(int instance_count)
+{
+    ImGuiBuilder* copies = new ImGuiBuilder();
+    ElementStore& copy_elements = copies->GetElements();
+    const ElementIndex block = BuildSettingsBlock(*copies);
+    for (int n = 1; n < instance_count; n++)
+        copy_elements.Append(ElementIndex_None, copy_elements.Duplicate(block));
+
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    ElementStore& elements = builder->GetElements();
+    const ElementIndex first = builder->MakeComponent(BuildSettingsBlock(*builder));
+    const ElementIndex component = elements.LastChild(ElementIndex_None);
+    for (int n = 1; n < instance_count; n++)
+        builder->AddInstance(component);
+    bool ok = elements.types[component] == ElementType::COMPONENT && elements.types[first] == ElementType::INSTANCE;
+
+    // Component, instance and move of the block undo together
+    ImGuiBuilder* original = new ImGuiBuilder();
+    ImGuiBuilder* undone = new ImGuiBuilder();
+    BuildSettingsBlock(*original);
+    BuildSettingsBlock(*undone);
+    undone->MakeComponent(undone->GetElements().LastChild(ElementIndex_None));
+    ok &= undone->GetHistory().GetStats().undo_steps == 1 && undone->Undo() && DocumentsEqual(original->GetElements(), undone->GetElements());
+    ok &= undone->Redo() && undone->GetElements().Size() == original->GetElements().Size() + 2 &&
+        undone->GetElements().types[undone->GetElements().FirstChild(ElementIndex_None)] == ElementType::INSTANCE;
+    delete undone;
+    delete original;
+
+    const size_t copy_file = SavedFileSize(copy_elements, "builder_components_copies.imgb");
+    const size_t file = SavedFileSize(elements, "builder_components.imgb");
+    ElementStore* loaded = new ElementStore();
+    const char* name = nullptr;
+    ok &= LoadProjectBinary(*loaded, "builder_components.imgb", &name) && DocumentsEqual(elements, *loaded);
+    delete loaded;
+
+    CodeBuffer header, copy_source, source;
+    BenchClock::time_point start = BenchClock::now();
+    GenerateDocumentCode(copy_elements, "Components", "components.h", header, copy_source);
+    const double copy_ms = MillisecondsSince(start);
+    start = BenchClock::now();
+    GenerateDocumentCode(elements, "Components", "components.h", header, source);
+    const double ms = MillisecondsSince(start);
+    // One function and state struct, each instance owns a state and passes it
+    ok &= CountOccurrences(source, "\nstatic void Component_") == 1 && CountOccurrences(source, "\nstruct ComponentState_") == 1 &&
+        CountOccurrences(source, "(&") == instance_count && CountOccurrences(source, "ImGui::PushID(") == instance_count;
+    const size_t copy_code = copy_source.Size(), code = source.Size();
+
+    // Incremental and parallel generation, through edits of the definition
+    auto same = [](const CodeBuffer& a, const CodeBuffer& b) { return a.Size() == b.Size() && memcmp(a.Begin(), b.Begin(), a.Size()) == 0; };
+    CodeCache* cache = new CodeCache();
+    ThreadPool* pool = new ThreadPool(4);
+    ParallelCodeGenerator* parallel = new ParallelCodeGenerator();
+    for (int step = 0; step < 4; step++)
+    {
+        const ElementIndex setting = elements.FirstChild(elements.FirstChild(component));
+        ElementIndex loop = ElementIndex_None;
+        if (step == 1)
+            elements.SetLabel(setting, "Edited Setting");
+        else if (step == 2)
+        {
+            // What renaming it in the properties panel does
+            elements.SetLabel(component, "Renamed Row");
+            for (ElementIndex element = elements.FirstChild(ElementIndex_None); element != ElementIndex_None; element = elements.NextSibling(element))
+                if (elements.types[element] == ElementType::INSTANCE)
+                    elements.SetText(element, "Renamed Row");
+        }
+        else if (step == 3)
+        {
+            loop = builder->AddElement(ElementType::INSTANCE, "Loop", elements.FirstChild(component));
+            elements.SetText(loop, "Renamed Row");
+        }
+        GenerateDocumentCode(elements, "Components", "components.h", header, source);
+        cache->GenerateDocument(elements, "Components", "components.h");
+        parallel->GenerateDocument(*pool, elements, "Components", "components.h");
+        ok &= same(cache->GetSource(), source) && same(parallel->GetSource(), source);
+        if (step == 1)
+            ok &= cache->GetReusedCount() > 0;
+        if (step == 3)
+        {
+            LayoutProgram* program = new LayoutProgram();
+            program->Compile(elements, "Components");
+            ok &= CountOccurrences(source, "ComponentState_") == 0 &&
+                CountOccurrences(source, "// No component") == instance_count && program->GetOps().empty();
+            delete program;
+            elements.Remove(loop);
+        }
+    }
+    delete parallel;
+    delete pool;
+    delete cache;
+
+    // Runtime: the copies' ops, plus PushID/PopID per instance
+    LayoutProgram* copy_program = new LayoutProgram();
+    LayoutProgram* program = new LayoutProgram();
+    copy_program->Compile(copy_elements, "Components");
+    program->Compile(elements, "Components");
+    const ElementUid setting_uid = elements.uids[elements.FirstChild(elements.FirstChild(component))];
+    ok &= program->GetOps().size() == copy_program->GetOps().size() + 2 * (size_t)instance_count && !program->GetBool(setting_uid);
+    delete program;
+    delete copy_program;
+
+    // Preview and properties of an instance
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    builder->SelectElement(first);
+    for (int n = 0; n < 3; n++)
+    {
+        ImGui::NewFrame();
+        builder->Render();
+        ImGui::Render();
+    }
+    ImGui::DestroyContext();
+
+    printf("%10d %10d %10d %10.1f %10.1f %10.1f %10.1f %10.3f %10.3f %10s\n", instance_count, copy_elements.Size(), elements.Size(),
+        copy_file / 1024.0, file / 1024.0, copy_code / 1024.0, code / 1024.0, copy_ms, ms, ok ? "OK" : "FAILED");
+    delete builder;
+    delete copies;
+    remove("builder_components_copies.imgb");
+    remove("builder_components.imgb");
+    return ok;
+}
+
+// Folding: a synthetic document with blocks of calls that change nothing appended (a SAME_LINE repeated, an INDENT
+// right before an UNINDENT, an empty combo, a colored spacing, disabled buttons one after the other), against the same
+// document without them. A block makes 18 calls unfolded and 8 folded: the generated code and the program of the
+// document must make exactly 8 more per block than the plain one, and AnalyzeLayout() must count the other 10 as
+// saved. The incremental and parallel generators must then write the same code as GenerateDocumentCode() through
+// edits that only change the folding of siblings (a hidden SAME_LINE, an enabled button...). The builder draws a few
+// frames of the document (preview).
+static const int FOLD_BLOCK_CALLS = 8;
+static const int FOLD_BLOCK_SAVED = 10;
+
+static ElementIndex AddRedundantBlock(ImGuiBuilder& builder)
+{
+    ElementStore& elements = builder.GetElements();
+    const ElementIndex first = builder.AddElement(ElementType::SPACING, "Spacing");
+    elements.styles[first].text_color = ImVec4(1.0f, 0.5f, 0.0f, 1.0f);
+    elements.Touch(first);
+    builder.AddElement(ElementType::INDENT, "Indent");
+    builder.AddElement(ElementType::UNINDENT, "Unindent");
+    elements.SetItems(builder.AddElement(ElementType::COMBO, "Empty"), nullptr, 0);
+    static const ElementType buttons[] = { ElementType::BUTTON, ElementType::SAME_LINE, ElementType::SAME_LINE, ElementType::BUTTON, ElementType::BUTTON };
+    for (ElementType type : buttons)
+    {
+        const ElementIndex element = builder.AddElement(type, type == ElementType::BUTTON ? "Disabled" : "Same Line");
+        if (type == ElementType::BUTTON)
+        {
+            elements.flags[element] &= ~ElementFlags_Enabled;
+            elements.Touch(element);
+        }
+    }
+    builder.AddElement(ElementType::TEXT, "Text");
+    return first;
+}
+
+static bool RunFoldBenchmark(int element_count)
+{
+    const int block_count = element_count / 10;
+    ImGuiBuilder* plain = new ImGuiBuilder();
+    BuildSyntheticDocument(*plain, element_count);
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    std::vector<ElementIndex> blocks;
+    for (int n = 0; n < block_count; n++)
+        blocks.push_back(AddRedundantBlock(*builder));
+    ElementStore& elements = builder->GetElements();
+
+    CodeBuffer header, plain_source, source;
+    GenerateDocumentCode(plain->GetElements(), "Folding", "folding.h", header, plain_source);
+    BenchClock::time_point start = BenchClock::now();
+    GenerateDocumentCode(elements, "Folding", "folding.h", header, source);
+    const double codegen_ms = MillisecondsSince(start);
+    start = BenchClock::now();
+    const LayoutFoldStats stats = AnalyzeLayout(elements);
+    const double analyze_ms = MillisecondsSince(start);
+    const LayoutFoldStats plain_stats = AnalyzeLayout(plain->GetElements());
+    const int calls = CountOccurrences(source, "ImGui::");
+    bool ok = calls == CountOccurrences(plain_source, "ImGui::") + FOLD_BLOCK_CALLS * block_count &&
+        stats.calls_saved == plain_stats.calls_saved + FOLD_BLOCK_SAVED * block_count;
+
+    LayoutProgram* plain_program = new LayoutProgram();
+    LayoutProgram* program = new LayoutProgram();
+    plain_program->Compile(plain->GetElements(), "Folding");
+    program->Compile(elements, "Folding");
+    ok &= program->GetOps().size() == plain_program->GetOps().size() + (size_t)FOLD_BLOCK_CALLS * block_count;
+    const int ops = (int)program->GetOps().size();
+    delete program;
+    delete plain_program;
+
+    // Edits of one element changing the calls of its siblings
+    auto same = [](const CodeBuffer& a, const CodeBuffer& b) { return a.Size() == b.Size() && memcmp(a.Begin(), b.Begin(), a.Size()) == 0; };
+    CodeCache* cache = new CodeCache();
+    ThreadPool* pool = new ThreadPool(4);
+    ParallelCodeGenerator* parallel = new ParallelCodeGenerator();
+    cache->GenerateDocument(elements, "Folding", "folding.h");
+    static const char* const items[] = { "One", "Two" };
+    for (int step = 0; step < 4; step++)
+    {
+        for (int n = step; n < block_count; n += 4)
+        {
+            ElementIndex element = blocks[n];
+            for (int skip = (step == 0) ? 5 : (step == 1) ? 7 : (step == 2) ? 3 : 9; skip > 0; skip--)
+                element = elements.NextSibling(element);
+            if (step == 0 || step == 3)
+                elements.flags[element] &= ~ElementFlags_Visible;   // First SAME_LINE, last text
+            else if (step == 1)
+                elements.flags[element] |= ElementFlags_Enabled;    // Middle button
+            else
+                elements.SetItems(element, items, IM_ARRAYSIZE(items));
+            elements.Touch(element);
+        }
+        GenerateDocumentCode(elements, "Folding", "folding.h", header, source);
+        cache->GenerateDocument(elements, "Folding", "folding.h");
+        parallel->GenerateDocument(*pool, elements, "Folding", "folding.h");
+        ok &= same(cache->GetSource(), source) && same(parallel->GetSource(), source);
+    }
+    delete parallel;
+    delete pool;
+    delete cache;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    for (int n = 0; n < 3; n++)
+    {
+        ImGui::NewFrame();
+        builder->Render();
+        ImGui::Render();
+    }
+    ImGui::DestroyContext();
+
+    printf("%10d %10d %10d %10d %10.1f %10d %10d %10d %10d %10.3f %10.3f %10s\n", elements.Size(), block_count, calls, stats.calls_saved,
+        100.0 * stats.calls_saved / (calls + stats.calls_saved), stats.folded_elements, stats.dropped_scopes, stats.merged_scopes, ops,
+        analyze_ms, codegen_ms, ok ? "OK" : "FAILED");
+    delete builder;
+    delete plain;
+    return ok;
+}
+
+// Style batching: blocks of siblings styled in runs appended to a synthetic document. A block is three red texts
+// with a SAME_LINE and a separator between them, two sliders of the same width and background with a checkbox of the
+// same background between them, two disabled buttons with the same text and background colors, then a plain text field.
+// One scope per element makes 26 style stack calls per block (PushStyleColor() for each color and one
+// PopStyleColor(), PushItemWidth()/PopItemWidth(), BeginDisabled()/EndDisabled()), the runs share them in 11: the
+// generated code and the program of the document must make exactly that, as AnalyzeLayout() counts. The incremental
+// and parallel generators must then write the same code as GenerateDocumentCode() through edits breaking runs (a
+// recolored or hidden text, a resized slider, an enabled button). A preview of the blocks alone is then drawn a few
+// frames, counting the style calls of the visible rows against one scope per element (per frame, on average); the
+// preview of a single block must make the same 11 calls, and the children of an open header be drawn inside its scopes.
+static const int STYLE_BLOCK_CALLS = 11;
+static const int STYLE_BLOCK_MERGED = 15;
+
+static ElementIndex AddStyledBlock(ImGuiBuilder& builder)
+{
+    ElementStore& elements = builder.GetElements();
+    const ImVec4 red(1.0f, 0.3f, 0.3f, 1.0f);
+    const ImVec4 blue(0.1f, 0.2f, 0.5f, 1.0f);
+    const ImVec4 green(0.1f, 0.5f, 0.2f, 1.0f);
+    const ElementIndex first = builder.AddElement(ElementType::TEXT, "Red 1");
+    builder.AddElement(ElementType::SAME_LINE, "Same Line");
+    const ElementIndex second = builder.AddElement(ElementType::TEXT, "Red 2");
+    builder.AddElement(ElementType::SEPARATOR, "Separator");
+    const ElementIndex third = builder.AddElement(ElementType::TEXT, "Red 3");
+    for (ElementIndex element : { first, second, third })
+        elements.styles[element].text_color = red;
+    static const ElementType fields[] = { ElementType::SLIDER_FLOAT, ElementType::CHECKBOX, ElementType::SLIDER_FLOAT };
+    for (ElementType type : fields)
+    {
+        const ElementIndex element = builder.AddElement(type, "Field");
+        elements.styles[element].bg_color = blue;
+        if (type == ElementType::SLIDER_FLOAT)
+            elements.styles[element].size.x = 200.0f;
+    }
+    for (int n = 0; n < 2; n++)
+    {
+        const ElementIndex element = builder.AddElement(ElementType::BUTTON, "Disabled");
+        elements.styles[element].text_color = red;
+        elements.styles[element].bg_color = green;
+        elements.flags[element] &= ~ElementFlags_Enabled;
+    }
+    builder.AddElement(ElementType::INPUT_TEXT, "Plain");
+    for (ElementIndex element = first; element != ElementIndex_None; element = elements.NextSibling(element))
+        elements.Touch(element);
+    return first;
+}
+
+static int CountStyleCalls(const CodeBuffer& code)
+{
+    static const char* const calls[] = { "ImGui::PushStyleColor(", "ImGui::PopStyleColor(", "ImGui::PushItemWidth(", "ImGui::PopItemWidth(",
+        "ImGui::BeginDisabled(", "ImGui::EndDisabled(" };
+    int count = 0;
+    for (const char* call : calls)
+        count += CountOccurrences(code, call);
+    return count;
+}
+
+static bool RunStyleBatchBenchmark(int element_count)
+{
+    const int block_count = element_count / 10;
+    ImGuiBuilder* plain = new ImGuiBuilder();
+    BuildSyntheticDocument(*plain, element_count);
+    ImGuiBuilder* builder = new ImGuiBuilder();
+    BuildSyntheticDocument(*builder, element_count);
+    ImGuiBuilder* styled = new ImGuiBuilder();
+    std::vector<ElementIndex> blocks;
+    for (int n = 0; n < block_count; n++)
+    {
+        blocks.push_back(AddStyledBlock(*builder));
+        AddStyledBlock(*styled);
+    }
+    ElementStore& elements = builder->GetElements();
+
+    CodeBuffer header, source;
+    BenchClock::time_point start = BenchClock::now();
+    GenerateDocumentCode(elements, "Styles", "styles.h", header, source);
+    const double codegen_ms = MillisecondsSince(start);
+    const LayoutFoldStats stats = AnalyzeLayout(elements);
+    const LayoutFoldStats plain_stats = AnalyzeLayout(plain->GetElements());
+    const int calls = CountStyleCalls(source);
+    const int unbatched = stats.style_calls + stats.merged_calls;
+    bool ok = calls == stats.style_calls && stats.style_calls == plain_stats.style_calls + STYLE_BLOCK_CALLS * block_count &&
+        stats.merged_calls == plain_stats.merged_calls + STYLE_BLOCK_MERGED * block_count;
+
+    LayoutProgram* program = new LayoutProgram();
+    program->Compile(elements, "Styles");
+    int ops = 0;
+    for (const LayoutOp& op : program->GetOps())
+        ops += (op.code == LayoutOpCode_BeginDisabled || op.code == LayoutOpCode_EndDisabled || op.code == LayoutOpCode_PushColor ||
+                op.code == LayoutOpCode_PopColor || op.code == LayoutOpCode_PushItemWidth || op.code == LayoutOpCode_PopItemWidth) ? 1 : 0;
+    ok &= ops == calls;
+    delete program;
+
+    // Edits of one element breaking the runs of its siblings
+    auto same = [](const CodeBuffer& a, const CodeBuffer& b) { return a.Size() == b.Size() && memcmp(a.Begin(), b.Begin(), a.Size()) == 0; };
+    CodeCache* cache = new CodeCache();
+    ThreadPool* pool = new ThreadPool(4);
+    ParallelCodeGenerator* parallel = new ParallelCodeGenerator();
+    cache->GenerateDocument(elements, "Styles", "styles.h");
+    for (int step = 0; step < 4; step++)
+    {
+        for (int n = step; n < block_count; n += 4)
+        {
+            ElementIndex element = blocks[n];
+            for (int skip = (step == 0) ? 2 : (step == 1) ? 4 : (step == 2) ? 7 : 8; skip > 0; skip--)
+                element = elements.NextSibling(element);
+            if (step == 0)
+                elements.styles[element].text_color = ImVec4(0.3f, 1.0f, 0.3f, 1.0f); // Middle red text
+            else if (step == 1)
+                elements.flags[element] &= ~ElementFlags_Visible;                       // Last red text
+            else if (step == 2)
+                elements.styles[element].size.x = 300.0f;                               // Second slider
+            else
+                elements.flags[element] |= ElementFlags_Enabled;                        // First button
+            elements.Touch(element);
+        }
+        GenerateDocumentCode(elements, "Styles", "styles.h", header, source);
+        cache->GenerateDocument(elements, "Styles", "styles.h");
+        parallel->GenerateDocument(*pool, elements, "Styles", "styles.h");
+        ok &= same(cache->GetSource(), source) && same(parallel->GetSource(), source) &&
+            CountStyleCalls(source) == AnalyzeLayout(elements).style_calls;
+    }
+    delete parallel;
+    delete pool;
+    delete cache;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = nullptr;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ElementPreview* preview = new ElementPreview();
+    ElementPreview* block_preview = new ElementPreview();
+    ImGuiBuilder* block = new ImGuiBuilder();
+    AddStyledBlock(*block);
+    // An open header, disabled and colored, with children drawn as rows of their own
+    ElementPreview* header_preview = new ElementPreview();
+    ImGuiBuilder* header_block = new ImGuiBuilder();
+    ElementStore& header_elements = header_block->GetElements();
+    const ElementIndex header_element = header_block->AddElement(ElementType::COLLAPSING_HEADER, "Header");
+    header_elements.styles[header_element].text_color = ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
+    header_elements.flags[header_element] = (header_elements.flags[header_element] & ~ElementFlags_Enabled) | ElementFlags_Open;
+    header_block->AddElement(ElementType::TEXT, "Child Text", header_element);
+    header_block->AddElement(ElementType::BUTTON, "Child Button", header_element);
+    CodeBuffer header_source;
+    GenerateDocumentCode(header_elements, "Header", "header.h", header, header_source);
+    const int header_calls = CountStyleCalls(header_source);
+    const int frames = 3;
+    int preview_calls = 0;
+    int preview_unbatched = 0;
+    for (int n = 0; n < frames; n++)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Preview");
+        preview->Render(styled->GetElements());
+        ImGui::End();
+        // One block, every row drawn (first frame, rows not measured yet): the same calls as generated code, disabled
+        // scope included
+        ImGui::Begin("Block");
+        block_preview->Render(block->GetElements());
+        ImGui::End();
+        // Its scopes, then the same again around the rows of its children, which inherit them
+        ImGui::Begin("Header");
+        header_preview->Render(header_elements);
+        ImGui::End();
+        ImGui::Render();
+        preview_calls += preview->GetStyleCalls();
+        preview_unbatched += preview->GetUnbatchedStyleCalls();
+        if (n == 0)
+            ok &= block_preview->GetStyleCalls() == STYLE_BLOCK_CALLS && header_calls == 4 && header_preview->GetStyleCalls() == 2 * header_calls;
+    }
+    preview_calls /= frames;
+    preview_unbatched /= frames;
+    ok &= preview_calls <= preview_unbatched;
+    delete header_block;
+    delete header_preview;
+    delete block;
+    delete block_preview;
+    delete preview;
+    ImGui::DestroyContext();
+
+    printf("%10d %10d %10d %10d %10.1f %10d %10d %10d %10d %10.3f %10s\n", elements.Size(), block_count, calls, unbatched,
+        unbatched > 0 ? 100.0 * (unbatched - calls) / unbatched : 0.0, stats.merged_scopes, ops, preview_calls, preview_unbatched, codegen_ms,
+        ok ? "OK" : "FAILED");
+    delete styled;
+    delete builder;
+    delete plain;
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(BenchMalloc, BenchFree);
+
+    int frames = (argc > 1) ? atoi(argv[1]) : 60;
+    if (frames <= 0)
+        frames = 60;
+    int element_counts[16] = { 1000, 10000, 100000 };
+    int element_counts_count = 3;
+    if (argc > 2)
+        for (element_counts_count = 0; element_counts_count < IM_ARRAYSIZE(element_counts) && element_counts_count + 2 < argc; element_counts_count++)
+            element_counts[element_counts_count] = atoi(argv[element_counts_count + 2]);
+
+    bool ok = true;
+    printf("Dear ImGui %s, %d measured frames per document (steady-state frames must not allocate)\n", IMGUI_VERSION, frames);
+    printf("%10s %10s %10s %10s %12s %12s %12s %10s %10s %10s %10s\n", "elements", "avg ms", "min ms", "max ms", "new/frame", "new KB/fr", "imgui/frame", "vertices",
+        "codegen ms", "code MB", "cg allocs");
+    for (int n = 0; n < element_counts_count; n++)
+    {
+        BenchResult r = RunBenchmark(element_counts[n], frames);
+        printf("%10d %10.3f %10.3f %10.3f %12.1f %12.1f %12.1f %10d %10.3f %10.2f %10d\n",
+            element_counts[n], r.FrameAvgMs, r.FrameMinMs, r.FrameMaxMs,
+            r.NewPerFrame, r.NewBytesPerFrame / 1024.0, r.ImGuiAllocPerFrame, r.Vertices, r.CodegenMs, r.CodeMB, r.CodegenAllocs);
+        ok &= r.NewPerFrame == 0.0 && r.ImGuiAllocPerFrame == 0.0;
+    }
+
+    printf("\nDocument operations (recreate runs on the memory recycled by clear)\n");
+    printf("%10s %10s %8s %10s %8s %10s %8s %10s %8s %10s %10s %10s %10s\n", "elements", "create ms", "allocs", "dup ms", "allocs", "clear ms", "allocs",
+        "recreate", "allocs", "slots", "B/slot", "strings", "string KB");
+    for (int n = 0; n < element_counts_count; n++)
+        RunDocumentBenchmark(element_counts[n]);
+
+    printf("\nElement uids (build = create, duplicate, remove a third of the header children, create again)\n");
+    printf("%10s %10s %10s %10s %14s\n", "elements", "build ms", "check ms", "unique", "reproducible");
+    ok &= RunUidBenchmark(1000000);
+
+    printf("\nProject files\n");
+    printf("%10s %10s %10s %10s %12s\n", "elements", "save ms", "load ms", "size MB", "round trip");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunProjectFileBenchmark(element_counts[n]);
+
+    printf("\nIncremental code generation (regenerate the whole document after each edit)\n");
+    printf("%10s %10s %12s %10s %12s %10s\n", "elements", "full ms", "unchanged ms", "edit ms", "generated", "output");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunCodeCacheBenchmark(element_counts[n]);
+
+    printf("\nParallel code generation (%u hardware threads)\n", std::thread::hardware_concurrency());
+    printf("%10s %10s %10s %10s %10s %10s %10s\n", "elements", "threads", "ms", "speedup", "chunks", "steals", "output");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunParallelCodegenBenchmark(element_counts[n]);
+
+    printf("\nJSON project files\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %12s\n", "elements", "size MB", "save ms", "save MB/s", "allocs", "load ms", "load MB/s", "round trip");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunJsonBenchmark(element_counts[n]);
+
+    printf("\nUndo/redo (random property and structural edits, all undone then redone)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "elements", "edits", "steps", "record ms", "log KB", "undo ms", "max us",
+        "redo ms", "undo", "redo");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunHistoryBenchmark(element_counts[n], 20000);
+
+    printf("\nStructural edits (random moves, reorders, duplicates, inserts and deletes anywhere in the tree)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "elements", "edits", "edit ms", "ns/edit", "moves", "refused",
+        "duplicates", "inserts", "removes", "check ms", "links");
+    ok &= RunStructureBenchmark(element_counts[element_counts_count - 1], 1000000);
+
+    printf("\nElement search (sync = after one label edit, find = average over the queries)\n");
+    printf("%10s %10s %10s %10s %10s %10s\n", "elements", "index ms", "sync ms", "reindexed", "find ms", "results");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunSearchBenchmark(element_counts[n]);
+
+    printf("\nFrame profiler (on/off = frame ms with the profiler enabled/disabled, trace = 5 frames exported and read back)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s\n", "elements", "scopes/fr", "ns/scope", "on ms", "off ms", "allocs", "events", "trace");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunProfilerBenchmark(element_counts[n], frames);
+
+    printf("\nFrame scheduling (simulated clock, 60 Hz display, synthetic input)\n");
+    printf("%14s %10s %10s %10s %10s %10s %10s %10s %10s\n", "scenario", "seconds", "events", "changes", "rendered", "skipped", "skipped %", "latency ms", "check");
+    static const SchedulerScenario scenarios[] =
+    {
+        // Name             Always  Events              Active      Text        Changes
+        { "redraw always",  true,   0, 0, 0,            0, 0,       0, 0,       0,      0 },
+        { "idle",           false,  0, 0, 0,            0, 0,       0, 0,       0,      0 },
+        { "mouse moves",    false,  5, 10, 0.008,       0, 0,       0, 0,       0,      0 },
+        { "typing",         false,  5, 15, 0.15,        0, 0,       0, 60,      0,      0 },
+        { "dragging",       false,  10, 13, 0.016,      10, 13,     0, 0,       0,      0 },
+        { "jobs",           false,  0, 0, 0,            0, 0,       0, 0,       2.0,    0 },
+        { "serving live",   false,  5, 10, 0.008,       0, 0,       0, 0,       0,      1.0 / 60.0 },
+    };
+    for (const SchedulerScenario& scenario : scenarios)
+        ok &= RunSchedulerBenchmark(scenario);
+
+    printf("\nBatch code generation (cold, then warm from the saved cache, then with one project edited and one output deleted)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s\n", "projects", "elements", "threads", "cold ms", "warm ms", "edit ms", "input MB", "check");
+    ok &= RunBatchBenchmark(200, 500);
+
+    printf("\nLive preview (loopback connection, every edit sent and applied before the next one; latency from edit to applied)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "elements", "edits", "snap KB", "snap ms", "deltas", "B/delta", "avg ms", "p99 ms", "max ms", "check");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunLiveBenchmark(element_counts[n], 5000);
+
+    printf("\nLayout runtime (a compiled LayoutProgram against the generated code of the same document, layout call only)\n");
+    printf("%10s %10s %10s %10s %12s %12s %10s %10s %10s\n", "elements", "ops", "program KB", "compile ms", "generated ms", "program ms", "overhead %",
+        "allocs", "check");
+    ok &= RunRuntimeBenchmark(frames);
+
+    printf("\nBackground tasks (save + export + load: in a frame, then as tasks with an edited frame rendered until they are applied)\n");
+    printf("%10s %10s %10s %10s %10s %12s %10s %10s\n", "elements", "sync ms", "start ms", "tasks ms", "frames", "max frame ms", "apply ms", "check");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunTaskBenchmark(element_counts[n]);
+
+    printf("\nWorkspace (documents opened as tabs, a few shown, then switched between those in memory)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s\n", "documents", "elements", "open ms", "index B", "show ms", "switch us", "loaded", "check");
+    ok &= RunWorkspaceBenchmark(500, 1000);
+
+    printf("\nComponents (a block of 17 elements repeated: deep copies against instances of one component)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "blocks", "copy elems", "elements", "copy KB", "file KB", "copy code", "code KB",
+        "copy cg ms", "cg ms", "check");
+    ok &= RunComponentBenchmark(200);
+
+    printf("\nFolding (blocks of no-op calls appended to the document: calls left in the generated code, and saved)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "elements", "blocks", "calls", "saved", "saved %", "folded", "dropped",
+        "merged", "ops", "analyze ms", "cg ms", "check");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunFoldBenchmark(element_counts[n]);
+
+    printf("\nStyle batching (blocks of siblings styled in runs: style stack calls with shared scopes against one per element)\n");
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "elements", "blocks", "calls", "unbatched", "saved %", "merged",
+        "ops", "preview", "pv unbatch", "cg ms", "check");
+    for (int n = 0; n < element_counts_count; n++)
+        ok &= RunStyleBatchBenchmark(element_counts[n]);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,448 @@
+// Generated by ULTIMATE ImGui Builder: "Runtime Layout"
+
+#include "imgui.h"
+#include "runtime_layout.h"
+
+void RenderRuntimeLayout(bool* p_open) {
+    if (ImGui::Begin("Runtime Layout", p_open)) {
+        if (ImGui::CollapsingHeader("Header 0##1")) {
+            static bool element_1_2 = false;
+            ImGui::Checkbox("Element 1##2", &element_1_2);
+            static float element_2_3 = 50.0f;
+            ImGui::SliderFloat("Element 2##3", &element_2_3, 0.0f, 100.0f);
+            static int element_3_4 = 50;
+            ImGui::SliderInt("Element 3##4", &element_3_4, 0, 100);
+            static char element_4_5[256] = "Enter text...";
+            ImGui::InputText("Element 4##5", element_4_5, IM_ARRAYSIZE(element_4_5));
+            static int element_5_6 = 0;
+            ImGui::InputInt("Element 5##6", &element_5_6);
+            static float element_6_7 = 0.0f;
+            ImGui::InputFloat("Element 6##7", &element_6_7);
+            static const char* const element_7_8_items[] = { "Option 1", "Option 2", "Option 3" };
+            static int element_7_8 = 0;
+            ImGui::Combo("Element 7##8", &element_7_8, element_7_8_items, IM_ARRAYSIZE(element_7_8_items));
+            static float element_9_10[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            ImGui::ColorEdit4("Element 9##10", element_9_10);
+            ImGui::Separator();
+            ImGui::TextUnformatted("Sample Text");
+            ImGui::BulletText("%s", "");
+            ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 13");
+            static int element_14_15 = 0;
+            ImGui::RadioButton("Element 14##15", &element_14_15, 1);
+            static bool element_15_16 = false;
+            ImGui::Selectable("Element 15##16", &element_15_16);
+            ImGui::Spacing();
+        }
+        if (ImGui::Button("Element 17##18")) {
+            // Button clicked
+        }
+        static bool element_18_19 = false;
+        ImGui::Checkbox("Element 18##19", &element_18_19);
+        static float element_19_20 = 50.0f;
+        ImGui::SliderFloat("Element 19##20", &element_19_20, 0.0f, 100.0f);
+        static int element_20_21 = 50;
+        ImGui::SliderInt("Element 20##21", &element_20_21, 0, 100);
+        static char element_21_22[256] = "Enter text...";
+        ImGui::InputText("Element 21##22", element_21_22, IM_ARRAYSIZE(element_21_22));
+        static int element_22_23 = 0;
+        ImGui::InputInt("Element 22##23", &element_22_23);
+        static float element_23_24 = 0.0f;
+        ImGui::InputFloat("Element 23##24", &element_23_24);
+        static const char* const element_24_25_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_24_25 = 0;
+        ImGui::Combo("Element 24##25", &element_24_25, element_24_25_items, IM_ARRAYSIZE(element_24_25_items));
+        static float element_26_27[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 26##27", element_26_27);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 30");
+        static int element_31_32 = 0;
+        ImGui::RadioButton("Element 31##32", &element_31_32, 1);
+        static bool element_32_33 = false;
+        ImGui::Selectable("Element 32##33", &element_32_33);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 34##35")) {
+            // Button clicked
+        }
+        static bool element_35_36 = false;
+        ImGui::Checkbox("Element 35##36", &element_35_36);
+        static float element_36_37 = 50.0f;
+        ImGui::SliderFloat("Element 36##37", &element_36_37, 0.0f, 100.0f);
+        static int element_37_38 = 50;
+        ImGui::SliderInt("Element 37##38", &element_37_38, 0, 100);
+        static char element_38_39[256] = "Enter text...";
+        ImGui::InputText("Element 38##39", element_38_39, IM_ARRAYSIZE(element_38_39));
+        static int element_39_40 = 0;
+        ImGui::InputInt("Element 39##40", &element_39_40);
+        static float element_40_41 = 0.0f;
+        ImGui::InputFloat("Element 40##41", &element_40_41);
+        static const char* const element_41_42_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_41_42 = 0;
+        ImGui::Combo("Element 41##42", &element_41_42, element_41_42_items, IM_ARRAYSIZE(element_41_42_items));
+        static float element_43_44[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 43##44", element_43_44);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 47");
+        static int element_48_49 = 0;
+        ImGui::RadioButton("Element 48##49", &element_48_49, 1);
+        static bool element_49_50 = false;
+        ImGui::Selectable("Element 49##50", &element_49_50);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 51##52")) {
+            // Button clicked
+        }
+        static bool element_52_53 = false;
+        ImGui::Checkbox("Element 52##53", &element_52_53);
+        static float element_53_54 = 50.0f;
+        ImGui::SliderFloat("Element 53##54", &element_53_54, 0.0f, 100.0f);
+        static int element_54_55 = 50;
+        ImGui::SliderInt("Element 54##55", &element_54_55, 0, 100);
+        static char element_55_56[256] = "Enter text...";
+        ImGui::InputText("Element 55##56", element_55_56, IM_ARRAYSIZE(element_55_56));
+        static int element_56_57 = 0;
+        ImGui::InputInt("Element 56##57", &element_56_57);
+        static float element_57_58 = 0.0f;
+        ImGui::InputFloat("Element 57##58", &element_57_58);
+        static const char* const element_58_59_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_58_59 = 0;
+        ImGui::Combo("Element 58##59", &element_58_59, element_58_59_items, IM_ARRAYSIZE(element_58_59_items));
+        static float element_60_61[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 60##61", element_60_61);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        if (ImGui::CollapsingHeader("Header 64##65")) {
+            static int element_65_66 = 0;
+            ImGui::RadioButton("Element 65##66", &element_65_66, 1);
+            static bool element_66_67 = false;
+            ImGui::Selectable("Element 66##67", &element_66_67);
+            ImGui::Spacing();
+            if (ImGui::Button("Element 68##69")) {
+                // Button clicked
+            }
+            static bool element_69_70 = false;
+            ImGui::Checkbox("Element 69##70", &element_69_70);
+            static float element_70_71 = 50.0f;
+            ImGui::SliderFloat("Element 70##71", &element_70_71, 0.0f, 100.0f);
+            static int element_71_72 = 50;
+            ImGui::SliderInt("Element 71##72", &element_71_72, 0, 100);
+            static char element_72_73[256] = "Enter text...";
+            ImGui::InputText("Element 72##73", element_72_73, IM_ARRAYSIZE(element_72_73));
+            static int element_73_74 = 0;
+            ImGui::InputInt("Element 73##74", &element_73_74);
+            static float element_74_75 = 0.0f;
+            ImGui::InputFloat("Element 74##75", &element_74_75);
+            static const char* const element_75_76_items[] = { "Option 1", "Option 2", "Option 3" };
+            static int element_75_76 = 0;
+            ImGui::Combo("Element 75##76", &element_75_76, element_75_76_items, IM_ARRAYSIZE(element_75_76_items));
+            static float element_77_78[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            ImGui::ColorEdit4("Element 77##78", element_77_78);
+            ImGui::Separator();
+            ImGui::TextUnformatted("Sample Text");
+            ImGui::BulletText("%s", "");
+        }
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 81");
+        static int element_82_83 = 0;
+        ImGui::RadioButton("Element 82##83", &element_82_83, 1);
+        static bool element_83_84 = false;
+        ImGui::Selectable("Element 83##84", &element_83_84);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 85##86")) {
+            // Button clicked
+        }
+        static bool element_86_87 = false;
+        ImGui::Checkbox("Element 86##87", &element_86_87);
+        static float element_87_88 = 50.0f;
+        ImGui::SliderFloat("Element 87##88", &element_87_88, 0.0f, 100.0f);
+        static int element_88_89 = 50;
+        ImGui::SliderInt("Element 88##89", &element_88_89, 0, 100);
+        static char element_89_90[256] = "Enter text...";
+        ImGui::InputText("Element 89##90", element_89_90, IM_ARRAYSIZE(element_89_90));
+        static int element_90_91 = 0;
+        ImGui::InputInt("Element 90##91", &element_90_91);
+        static float element_91_92 = 0.0f;
+        ImGui::InputFloat("Element 91##92", &element_91_92);
+        static const char* const element_92_93_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_92_93 = 0;
+        ImGui::Combo("Element 92##93", &element_92_93, element_92_93_items, IM_ARRAYSIZE(element_92_93_items));
+        static float element_94_95[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 94##95", element_94_95);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 98");
+        static int element_99_100 = 0;
+        ImGui::RadioButton("Element 99##100", &element_99_100, 1);
+        static bool element_100_101 = false;
+        ImGui::Selectable("Element 100##101", &element_100_101);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 102##103")) {
+            // Button clicked
+        }
+        static bool element_103_104 = false;
+        ImGui::Checkbox("Element 103##104", &element_103_104);
+        static float element_104_105 = 50.0f;
+        ImGui::SliderFloat("Element 104##105", &element_104_105, 0.0f, 100.0f);
+        static int element_105_106 = 50;
+        ImGui::SliderInt("Element 105##106", &element_105_106, 0, 100);
+        static char element_106_107[256] = "Enter text...";
+        ImGui::InputText("Element 106##107", element_106_107, IM_ARRAYSIZE(element_106_107));
+        static int element_107_108 = 0;
+        ImGui::InputInt("Element 107##108", &element_107_108);
+        static float element_108_109 = 0.0f;
+        ImGui::InputFloat("Element 108##109", &element_108_109);
+        static const char* const element_109_110_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_109_110 = 0;
+        ImGui::Combo("Element 109##110", &element_109_110, element_109_110_items, IM_ARRAYSIZE(element_109_110_items));
+        static float element_111_112[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 111##112", element_111_112);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 115");
+        static int element_116_117 = 0;
+        ImGui::RadioButton("Element 116##117", &element_116_117, 1);
+        static bool element_117_118 = false;
+        ImGui::Selectable("Element 117##118", &element_117_118);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 119##120")) {
+            // Button clicked
+        }
+        static bool element_120_121 = false;
+        ImGui::Checkbox("Element 120##121", &element_120_121);
+        static float element_121_122 = 50.0f;
+        ImGui::SliderFloat("Element 121##122", &element_121_122, 0.0f, 100.0f);
+        static int element_122_123 = 50;
+        ImGui::SliderInt("Element 122##123", &element_122_123, 0, 100);
+        static char element_123_124[256] = "Enter text...";
+        ImGui::InputText("Element 123##124", element_123_124, IM_ARRAYSIZE(element_123_124));
+        static int element_124_125 = 0;
+        ImGui::InputInt("Element 124##125", &element_124_125);
+        static float element_125_126 = 0.0f;
+        ImGui::InputFloat("Element 125##126", &element_125_126);
+        static const char* const element_126_127_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_126_127 = 0;
+        ImGui::Combo("Element 126##127", &element_126_127, element_126_127_items, IM_ARRAYSIZE(element_126_127_items));
+        if (ImGui::CollapsingHeader("Header 128##129")) {
+            ImGui::Separator();
+            ImGui::TextUnformatted("Sample Text");
+            ImGui::BulletText("%s", "");
+            ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 132");
+            static int element_133_134 = 0;
+            ImGui::RadioButton("Element 133##134", &element_133_134, 1);
+            static bool element_134_135 = false;
+            ImGui::Selectable("Element 134##135", &element_134_135);
+            ImGui::Spacing();
+            if (ImGui::Button("Element 136##137")) {
+                // Button clicked
+            }
+            static bool element_137_138 = false;
+            ImGui::Checkbox("Element 137##138", &element_137_138);
+            static float element_138_139 = 50.0f;
+            ImGui::SliderFloat("Element 138##139", &element_138_139, 0.0f, 100.0f);
+            static int element_139_140 = 50;
+            ImGui::SliderInt("Element 139##140", &element_139_140, 0, 100);
+            static char element_140_141[256] = "Enter text...";
+            ImGui::InputText("Element 140##141", element_140_141, IM_ARRAYSIZE(element_140_141));
+            static int element_141_142 = 0;
+            ImGui::InputInt("Element 141##142", &element_141_142);
+            static float element_142_143 = 0.0f;
+            ImGui::InputFloat("Element 142##143", &element_142_143);
+            static const char* const element_143_144_items[] = { "Option 1", "Option 2", "Option 3" };
+            static int element_143_144 = 0;
+            ImGui::Combo("Element 143##144", &element_143_144, element_143_144_items, IM_ARRAYSIZE(element_143_144_items));
+        }
+        static float element_145_146[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 145##146", element_145_146);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 149");
+        static int element_150_151 = 0;
+        ImGui::RadioButton("Element 150##151", &element_150_151, 1);
+        static bool element_151_152 = false;
+        ImGui::Selectable("Element 151##152", &element_151_152);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 153##154")) {
+            // Button clicked
+        }
+        static bool element_154_155 = false;
+        ImGui::Checkbox("Element 154##155", &element_154_155);
+        static float element_155_156 = 50.0f;
+        ImGui::SliderFloat("Element 155##156", &element_155_156, 0.0f, 100.0f);
+        static int element_156_157 = 50;
+        ImGui::SliderInt("Element 156##157", &element_156_157, 0, 100);
+        static char element_157_158[256] = "Enter text...";
+        ImGui::InputText("Element 157##158", element_157_158, IM_ARRAYSIZE(element_157_158));
+        static int element_158_159 = 0;
+        ImGui::InputInt("Element 158##159", &element_158_159);
+        static float element_159_160 = 0.0f;
+        ImGui::InputFloat("Element 159##160", &element_159_160);
+        static const char* const element_160_161_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_160_161 = 0;
+        ImGui::Combo("Element 160##161", &element_160_161, element_160_161_items, IM_ARRAYSIZE(element_160_161_items));
+        static float element_162_163[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 162##163", element_162_163);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 166");
+        static int element_167_168 = 0;
+        ImGui::RadioButton("Element 167##168", &element_167_168, 1);
+        static bool element_168_169 = false;
+        ImGui::Selectable("Element 168##169", &element_168_169);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 170##171")) {
+            // Button clicked
+        }
+        static bool element_171_172 = false;
+        ImGui::Checkbox("Element 171##172", &element_171_172);
+        static float element_172_173 = 50.0f;
+        ImGui::SliderFloat("Element 172##173", &element_172_173, 0.0f, 100.0f);
+        static int element_173_174 = 50;
+        ImGui::SliderInt("Element 173##174", &element_173_174, 0, 100);
+        static char element_174_175[256] = "Enter text...";
+        ImGui::InputText("Element 174##175", element_174_175, IM_ARRAYSIZE(element_174_175));
+        static int element_175_176 = 0;
+        ImGui::InputInt("Element 175##176", &element_175_176);
+        static float element_176_177 = 0.0f;
+        ImGui::InputFloat("Element 176##177", &element_176_177);
+        static const char* const element_177_178_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_177_178 = 0;
+        ImGui::Combo("Element 177##178", &element_177_178, element_177_178_items, IM_ARRAYSIZE(element_177_178_items));
+        static float element_179_180[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 179##180", element_179_180);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 183");
+        static int element_184_185 = 0;
+        ImGui::RadioButton("Element 184##185", &element_184_185, 1);
+        static bool element_185_186 = false;
+        ImGui::Selectable("Element 185##186", &element_185_186);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 187##188")) {
+            // Button clicked
+        }
+        static bool element_188_189 = false;
+        ImGui::Checkbox("Element 188##189", &element_188_189);
+        static float element_189_190 = 50.0f;
+        ImGui::SliderFloat("Element 189##190", &element_189_190, 0.0f, 100.0f);
+        static int element_190_191 = 50;
+        ImGui::SliderInt("Element 190##191", &element_190_191, 0, 100);
+        static char element_191_192[256] = "Enter text...";
+        ImGui::InputText("Element 191##192", element_191_192, IM_ARRAYSIZE(element_191_192));
+        if (ImGui::CollapsingHeader("Header 192##193")) {
+            static float element_193_194 = 0.0f;
+            ImGui::InputFloat("Element 193##194", &element_193_194);
+            static const char* const element_194_195_items[] = { "Option 1", "Option 2", "Option 3" };
+            static int element_194_195 = 0;
+            ImGui::Combo("Element 194##195", &element_194_195, element_194_195_items, IM_ARRAYSIZE(element_194_195_items));
+            static float element_196_197[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            ImGui::ColorEdit4("Element 196##197", element_196_197);
+            ImGui::Separator();
+            ImGui::TextUnformatted("Sample Text");
+            ImGui::BulletText("%s", "");
+            ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 200");
+            static int element_201_202 = 0;
+            ImGui::RadioButton("Element 201##202", &element_201_202, 1);
+            static bool element_202_203 = false;
+            ImGui::Selectable("Element 202##203", &element_202_203);
+            ImGui::Spacing();
+            if (ImGui::Button("Element 204##205")) {
+                // Button clicked
+            }
+            static bool element_205_206 = false;
+            ImGui::Checkbox("Element 205##206", &element_205_206);
+            static float element_206_207 = 50.0f;
+            ImGui::SliderFloat("Element 206##207", &element_206_207, 0.0f, 100.0f);
+            static int element_207_208 = 50;
+            ImGui::SliderInt("Element 207##208", &element_207_208, 0, 100);
+            static char element_208_209[256] = "Enter text...";
+            ImGui::InputText("Element 208##209", element_208_209, IM_ARRAYSIZE(element_208_209));
+        }
+        static int element_209_210 = 0;
+        ImGui::InputInt("Element 209##210", &element_209_210);
+        static float element_210_211 = 0.0f;
+        ImGui::InputFloat("Element 210##211", &element_210_211);
+        static const char* const element_211_212_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_211_212 = 0;
+        ImGui::Combo("Element 211##212", &element_211_212, element_211_212_items, IM_ARRAYSIZE(element_211_212_items));
+        static float element_213_214[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 213##214", element_213_214);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 217");
+        static int element_218_219 = 0;
+        ImGui::RadioButton("Element 218##219", &element_218_219, 1);
+        static bool element_219_220 = false;
+        ImGui::Selectable("Element 219##220", &element_219_220);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 221##222")) {
+            // Button clicked
+        }
+        static bool element_222_223 = false;
+        ImGui::Checkbox("Element 222##223", &element_222_223);
+        static float element_223_224 = 50.0f;
+        ImGui::SliderFloat("Element 223##224", &element_223_224, 0.0f, 100.0f);
+        static int element_224_225 = 50;
+        ImGui::SliderInt("Element 224##225", &element_224_225, 0, 100);
+        static char element_225_226[256] = "Enter text...";
+        ImGui::InputText("Element 225##226", element_225_226, IM_ARRAYSIZE(element_225_226));
+        static int element_226_227 = 0;
+        ImGui::InputInt("Element 226##227", &element_226_227);
+        static float element_227_228 = 0.0f;
+        ImGui::InputFloat("Element 227##228", &element_227_228);
+        static const char* const element_228_229_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_228_229 = 0;
+        ImGui::Combo("Element 228##229", &element_228_229, element_228_229_items, IM_ARRAYSIZE(element_228_229_items));
+        static float element_230_231[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 230##231", element_230_231);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 234");
+        static int element_235_236 = 0;
+        ImGui::RadioButton("Element 235##236", &element_235_236, 1);
+        static bool element_236_237 = false;
+        ImGui::Selectable("Element 236##237", &element_236_237);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 238##239")) {
+            // Button clicked
+        }
+        static bool element_239_240 = false;
+        ImGui::Checkbox("Element 239##240", &element_239_240);
+        static float element_240_241 = 50.0f;
+        ImGui::SliderFloat("Element 240##241", &element_240_241, 0.0f, 100.0f);
+        static int element_241_242 = 50;
+        ImGui::SliderInt("Element 241##242", &element_241_242, 0, 100);
+        static char element_242_243[256] = "Enter text...";
+        ImGui::InputText("Element 242##243", element_242_243, IM_ARRAYSIZE(element_242_243));
+        static int element_243_244 = 0;
+        ImGui::InputInt("Element 243##244", &element_243_244);
+        static float element_244_245 = 0.0f;
+        ImGui::InputFloat("Element 244##245", &element_244_245);
+        static const char* const element_245_246_items[] = { "Option 1", "Option 2", "Option 3" };
+        static int element_245_246 = 0;
+        ImGui::Combo("Element 245##246", &element_245_246, element_245_246_items, IM_ARRAYSIZE(element_245_246_items));
+        static float element_247_248[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        ImGui::ColorEdit4("Element 247##248", element_247_248);
+        ImGui::Separator();
+        ImGui::TextUnformatted("Sample Text");
+        ImGui::BulletText("%s", "");
+        ImGui::ProgressBar(0.5f, ImVec2(0.0f, 0.0f), "Element 251");
+        static int element_252_253 = 0;
+        ImGui::RadioButton("Element 252##253", &element_252_253, 1);
+        static bool element_253_254 = false;
+        ImGui::Selectable("Element 253##254", &element_253_254);
+        ImGui::Spacing();
+        if (ImGui::Button("Element 255##256")) {
+            // Button clicked
+        }
+    }
+    ImGui::End();
+}
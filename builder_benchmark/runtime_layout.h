@@ -0,0 +1,6 @@
+// Generated by ULTIMATE ImGui Builder: "Runtime Layout"
+
+#pragma once
+
+// Draw the window. 'p_open' (optional) is cleared when the window is closed.
+void RenderRuntimeLayout(bool* p_open = nullptr);
@@ -0,0 +1,154 @@
+// ULTIMATE ImGui Builder: command line code generator
+// (load project files, generate their C++ and write it out, with NO WINDOW and NO DEAR IMGUI CONTEXT)
+// Usage: builder_cli [options] project...
+//   -o <dir>      Write '<dir>/<project name>.h/.cpp' (default: next to each project file)
+//   -l <file>     Read more project paths from <file>, one per line
+//   -j <threads>  Threads, the main one included (default: one per hardware thread)
+//   -c <file>     Cache of what was generated from what (default: .imgui_builder_cache.json in the output directory,
+//                 or in the current directory without -o)
+//   -f            Regenerate every project, even unchanged ones
+//   -q            Only print errors and the summary
+// Projects whose file and output path did not change since the last run, and whose outputs still exist, are skipped.
+// Exit code: 0 if every project was generated or skipped, 1 otherwise.
+
+#include "imgui_builder_batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+static void PrintUsage()
+{
+    fprintf(stderr, "Usage: builder_cli [-o dir] [-l list] [-j threads] [-c cache] [-f] [-q] project...\n");
+}
+
+// "dir/name.imgb" -> "name"
+static std::string ProjectStem(const std::string& path)
+{
+    const size_t slash = path.find_last_of("/\\");
+    std::string stem = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    const size_t dot = stem.find_last_of('.');
+    if (dot != std::string::npos && dot > 0)
+        stem.resize(dot);
+    return stem;
+}
+
+// "dir/name.imgb" -> "dir/name"
+static std::string ProjectBase(const std::string& path)
+{
+    const size_t slash = path.find_last_of("/\\");
+    const size_t dot = path.find_last_of('.');
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash + 1))
+        return path.substr(0, dot);
+    return path;
+}
+
+static bool ReadProjectList(const char* path, std::vector<std::string>& inputs)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+    char line[4096];
+    while (fgets(line, sizeof(line), f))
+    {
+        size_t length = strlen(line);
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r' || line[length - 1] == ' ' || line[length - 1] == '\t'))
+            line[--length] = 0;
+        if (length > 0 && line[0] != '#')
+            inputs.push_back(line);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> inputs;
+    const char* output_dir = nullptr;
+    const char* cache_path = nullptr;
+    int thread_count = 0;
+    bool force = false, quiet = false;
+    for (int n = 1; n < argc; n++)
+    {
+        const char* arg = argv[n];
+        const bool has_value = n + 1 < argc;
+        if (strcmp(arg, "-o") == 0 && has_value)
+            output_dir = argv[++n];
+        else if (strcmp(arg, "-c") == 0 && has_value)
+            cache_path = argv[++n];
+        else if (strcmp(arg, "-j") == 0 && has_value)
+            thread_count = atoi(argv[++n]);
+        else if (strcmp(arg, "-l") == 0 && has_value)
+        {
+            if (!ReadProjectList(argv[++n], inputs))
+            {
+                fprintf(stderr, "Cannot read %s\n", argv[n]);
+                return 1;
+            }
+        }
+        else if (strcmp(arg, "-f") == 0)
+            force = true;
+        else if (strcmp(arg, "-q") == 0)
+            quiet = true;
+        else if (arg[0] == '-')
+        {
+            PrintUsage();
+            return 1;
+        }
+        else
+            inputs.push_back(arg);
+    }
+    if (inputs.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // Two projects must not write the same files
+    std::vector<BatchProject> projects;
+    std::unordered_set<std::string> outputs;
+    for (const std::string& input : inputs)
+    {
+        BatchProject project;
+        project.input = input;
+        project.output_base = output_dir ? std::string(output_dir) + "/" + ProjectStem(input) : ProjectBase(input);
+        if (!outputs.insert(project.output_base).second)
+        {
+            fprintf(stderr, "%s: %s.h/.cpp is already generated from another project\n", input.c_str(), project.output_base.c_str());
+            return 1;
+        }
+        projects.push_back(project);
+    }
+
+    const std::string default_cache = output_dir ? std::string(output_dir) + "/.imgui_builder_cache.json" : std::string(".imgui_builder_cache.json");
+    if (!cache_path)
+        cache_path = default_cache.c_str();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    BatchCodeGenerator generator(thread_count);
+    generator.SetForce(force);
+    std::string error;
+    if (!generator.LoadCache(cache_path, &error))
+        fprintf(stderr, "%s (ignored, regenerating everything)\n", error.c_str());
+
+    std::vector<BatchResult> results;
+    const BatchStats stats = generator.Run(projects, results);
+    for (size_t n = 0; n < projects.size(); n++)
+    {
+        const BatchResult& result = results[n];
+        if (result.status == BatchStatus_Failed)
+            fprintf(stderr, "%s: %s\n", projects[n].input.c_str(), result.error.c_str());
+        else if (result.status == BatchStatus_Generated && !quiet)
+            printf("%s -> %s.h/.cpp\n", projects[n].input.c_str(), projects[n].output_base.c_str());
+    }
+    if (!generator.SaveCache(cache_path, &error))
+        fprintf(stderr, "%s\n", error.c_str());
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("%d projects: %d generated, %d unchanged, %d failed (%.1f ms, %d threads)\n", (int)projects.size(),
+        stats.generated, stats.skipped, stats.failed, ms, generator.GetThreadCount());
+    return stats.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,1274 @@
+// ULTIMATE ImGui Builder: platform-neutral builder core
+// See imgui_builder.h
+
+#include "imgui_builder.h"
+#include "imgui_builder_codegen.h"
+#include "imgui_builder_fold.h"
+#include "imgui_builder_project.h"
+#include "imgui_builder_rows.h"
+#include "imgui_builder_types.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Idle wake-ups of the platform loop while serving live applications: one per refresh at 60 Hz, no frame rendered
+static const double LIVE_POLL_INTERVAL = 1.0 / 60.0;
+
+void ImGuiBuilder::Render() {
+    profiler.BeginFrame();
+
+    // Results of the background tasks land here, before anything looks at the document this frame
+    tasks.Update();
+    // The last task using the snapshot is gone: stop holding the strings of the document, keep the arrays for the next one
+    if (snapshot_pinned && snapshot.use_count() == 1) {
+        snapshot->string_pool.Reset();
+        snapshot_pinned = false;
+    }
+    // A tab was picked: its document replaces the active one before anything is drawn
+    const int requested_document = workspace.GetRequested();
+    if (requested_document >= 0 && requested_document != workspace.GetActive()) {
+        ShowDocument(requested_document);
+    }
+
+    // Main menu bar
+    if (ImGui::BeginMainMenuBar()) {
+        if (ImGui::BeginMenu("File")) {
+            if (ImGui::MenuItem("New Menu")) {
+                create_menu = true;
+            }
+            if (ImGui::MenuItem("Save Menu")) {
+                StartSave(project_path);
+            }
+            if (ImGui::MenuItem("Load Menu")) {
+                // With tabs, in a tab of its own: loaded into the active one, it would be saved under that tab's path
+                if (workspace.GetCount() > 0) {
+                    ShowDocument(OpenDocument(project_path));
+                } else {
+                    StartLoad(project_path);
+                }
+            }
+            if (ImGui::MenuItem("Open in New Tab")) {
+                ShowDocument(OpenDocument(project_path));
+            }
+            if (ImGui::MenuItem("Close Tab", nullptr, false, workspace.GetActive() >= 0)) {
+                RequestCloseDocument(workspace.GetActive());
+            }
+            ImGui::Separator();
+            if (ImGui::MenuItem("Export Code")) {
+                StartExport(code_path);
+            }
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("Edit")) {
+            if (ImGui::MenuItem("Undo", "Ctrl+Z", false, history.CanUndo())) {
+                Undo();
+            }
+            if (ImGui::MenuItem("Redo", "Ctrl+Y", false, history.CanRedo())) {
+                Redo();
+            }
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("View")) {
+            ImGui::MenuItem("Properties", nullptr, &show_properties);
+            ImGui::MenuItem("Element Tree", nullptr, &show_element_tree);
+            ImGui::MenuItem("Preview", nullptr, &show_preview);
+            ImGui::MenuItem("Profiler", nullptr, &show_profiler);
+            ImGui::MenuItem("Documents", nullptr, &show_documents);
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("Live")) {
+            RenderLiveMenu();
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("Help")) {
+            if (ImGui::MenuItem("About")) {
+                // About dialog
+            }
+            ImGui::EndMenu();
+        }
+
+        ImGui::EndMainMenuBar();
+    }
+
+    // Text fields have their own undo while they are being edited
+    if (!ImGui::IsAnyItemActive()) {
+        if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_Z, ImGuiInputFlags_RouteGlobal)) {
+            Undo();
+        }
+        if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_Y, ImGuiInputFlags_RouteGlobal)) {
+            Redo();
+        }
+    }
+
+    // Create Menu Checkbox
+    ImGui::SetNextWindowPos(ImVec2(10, 30), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(300, 100), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Menu Creator", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+
+    ImGui::Checkbox("Make Menu", &create_menu);
+    if (create_menu) {
+        ImGui::InputText("Menu Name", menu_name, sizeof(menu_name));
+        if (ImGui::Button("Create New Menu")) {
+            show_menu = true;
+            create_menu = false;
+        }
+    }
+
+    ImGui::InputText("Project File", project_path, sizeof(project_path));
+    ImGui::InputText("Code File", code_path, sizeof(code_path));
+    ImGui::Checkbox("Parallel Export", &parallel_export);
+    if (!project_status.empty()) {
+        ImGui::TextUnformatted(project_status.c_str());
+    }
+    RenderTasks();
+
+    ImGui::End();
+
+    // Documents Window: one tab per open document
+    if (show_documents && workspace.GetCount() > 0) {
+        ImGui::SetNextWindowPos(ImVec2(320, 30), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(350, 110), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Documents", &show_documents);
+        RenderDocumentTabs();
+        ImGui::End();
+    }
+    RenderCloseConfirmation();
+
+    // Element Tree Window
+    if (show_element_tree) {
+        ImGui::SetNextWindowPos(ImVec2(10, 150), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(300, 400), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Element Tree", &show_element_tree);
+
+        {
+            ProfileScope scope(profiler, ProfileZone_ElementTree);
+            RenderElementTree();
+        }
+
+        ImGui::End();
+    }
+
+    // Properties Window
+    if (show_properties) {
+        ImGui::SetNextWindowPos(ImVec2(320, 150), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(350, 400), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Properties", &show_properties);
+
+        {
+            ProfileScope scope(profiler, ProfileZone_Properties);
+            RenderProperties();
+        }
+
+        ImGui::End();
+    }
+
+    // Preview Window
+    if (show_preview && show_menu) {
+        ImGui::SetNextWindowPos(ImVec2(680, 30), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(500, 600), ImGuiCond_FirstUseEver);
+        ImGui::Begin(menu_name, &show_menu);
+
+        {
+            ProfileScope scope(profiler, ProfileZone_Preview);
+            RenderPreview();
+        }
+
+        ImGui::End();
+    }
+
+    // A drag or a typing session is one step: it ends when its widget is released
+    if (!ImGui::IsAnyItemActive()) {
+        history.Seal();
+    }
+
+    // Edits of this frame go out to the live applications right away. While serving, the idle loop still wakes up
+    // every refresh to poll (see GetLiveServer()): a new application gets its snapshot, and what the sockets could
+    // not take yet is flushed, without waiting for input.
+    live_server.Poll(elements);
+    scheduler.SetPollInterval(live_server.IsListening() ? LIVE_POLL_INTERVAL : -1.0);
+    // Keep frames coming while tasks run: progress moves, and results are applied as soon as they are ready
+    if (tasks.IsBusy()) {
+        scheduler.RequestFrames(1);
+    }
+
+    profiler.EndFrame();
+    // Shows the frames before this one: drawing the profiler is not part of what it measures
+    if (show_profiler) {
+        profiler.RenderWindow(&show_profiler);
+        if (show_profiler) {
+            RenderSchedulerStats();
+        }
+    }
+}
+
+ElementIndex ImGuiBuilder::AddElement(ElementType type, const char* label, ElementIndex parent) {
+    ElementIndex element = elements.Create(type, label);
+
+    // Default values declared by the type
+    const ElementTypeInfo& info = GetElementTypeInfo(type);
+    ElementValues value;
+    value.int_value = info.int_value;
+    value.float_value = info.float_value;
+    value.min_value = info.min_value;
+    value.max_value = info.max_value;
+    elements.SetValues(element, value);
+    if (info.text[0]) {
+        elements.SetText(element, info.text);
+    }
+    if (info.items_count > 0) {
+        elements.SetItems(element, info.items, info.items_count);
+    }
+
+    elements.Append(parent, element);
+    return element;
+}
+
+void ImGuiBuilder::ClearElements() {
+    elements.Clear();
+    history.Clear();
+    selected_element = ElementIndex_None;
+}
+
+bool ImGuiBuilder::Undo() {
+    if (!history.Undo(elements)) {
+        return false;
+    }
+    // Undo may bring back elements in other slots, or take the selected one away
+    if (!elements.IsAlive(selected_element)) {
+        selected_element = ElementIndex_None;
+    }
+    tree_rows_dirty = true;
+    preview.Invalidate();
+    return true;
+}
+
+bool ImGuiBuilder::Redo() {
+    if (!history.Redo(elements)) {
+        return false;
+    }
+    if (!elements.IsAlive(selected_element)) {
+        selected_element = ElementIndex_None;
+    }
+    tree_rows_dirty = true;
+    preview.Invalidate();
+    return true;
+}
+
+bool ImGuiBuilder::SaveProject(const char* path) {
+    tasks.WaitIdle();
+    if (!SaveProjectFile(elements, menu_name, path, &project_status)) {
+        return false;
+    }
+    project_status = "Saved ";
+    project_status += path;
+    saved_revision = elements.GetRevision();
+    return true;
+}
+
+bool ImGuiBuilder::LoadProject(const char* path) {
+    tasks.WaitIdle();
+    const char* name = nullptr;
+    if (!LoadProjectFile(elements, path, &name, &project_status)) {
+        return false;
+    }
+    selected_element = ElementIndex_None;
+    history.Clear();
+    snprintf(menu_name, sizeof(menu_name), "%s", name);
+    show_menu = true;
+    saved_revision = elements.GetRevision();
+    project_status = "Loaded ";
+    project_status += path;
+    return true;
+}
+
+// ", 12 ImGui calls folded away": what exported code saves per frame
+static std::string FoldSummary(const LayoutFoldStats& stats) {
+    if (stats.calls_saved == 0) {
+        return std::string();
+    }
+    char summary[64];
+    snprintf(summary, sizeof(summary), ", %d ImGui calls folded away", stats.calls_saved);
+    return summary;
+}
+
+bool ImGuiBuilder::ExportCode(const char* base_path) {
+    tasks.WaitIdle();
+    bool ok;
+    if (parallel_export) {
+        if (!export_pool) {
+            export_pool.reset(new ThreadPool());
+        }
+        ok = ExportDocumentCode(parallel_code, *export_pool, elements, menu_name, base_path, &project_status);
+    } else {
+        ok = ExportDocumentCode(code_cache, elements, menu_name, base_path, &project_status);
+    }
+    if (!ok) {
+        return false;
+    }
+    project_status = "Exported ";
+    project_status += base_path;
+    project_status += ".h/.cpp";
+    project_status += FoldSummary(AnalyzeLayout(elements));
+    return true;
+}
+
+std::shared_ptr<const ElementStore> ImGuiBuilder::GetSnapshot() {
+    if (snapshot_pinned && snapshot.use_count() > 1 && snapshot->GetRevision() == elements.GetRevision()) {
+        return snapshot;
+    }
+    // Still used by the tasks of an older revision: they keep it, the new copy gets memory of its own
+    if (!snapshot || snapshot.use_count() > 1) {
+        snapshot = std::make_shared<ElementStore>();
+    }
+    snapshot->CopySnapshot(elements);
+    snapshot_pinned = true;
+    return snapshot;
+}
+
+void ImGuiBuilder::ReportTask(TaskStatus status, const char* done, const std::string& path, const std::string& error) {
+    if (status == TaskStatus_Done) {
+        project_status = done;
+        project_status += path;
+    } else if (status == TaskStatus_Failed) {
+        project_status = error;
+    } else {
+        project_status = "Cancelled: ";
+        project_status += path;
+    }
+}
+
+TaskId ImGuiBuilder::StartSave(const char* path) {
+    std::shared_ptr<const ElementStore> document = GetSnapshot();
+    std::string name = menu_name;
+    std::string file = path;
+    std::shared_ptr<std::string> error = std::make_shared<std::string>();
+    return tasks.Start("Saving", [document, name, file, error](TaskContext& context) {
+        context.SetProgress(-1.0f, "Writing");
+        return SaveProjectFile(*document, name.c_str(), file.c_str(), error.get());
+    }, [this, document, file, error](TaskStatus status) {
+        // Revisions are unique across documents: if another one was shown meanwhile, it is only seen as modified
+        if (status == TaskStatus_Done) {
+            saved_revision = document->GetRevision();
+        }
+        ReportTask(status, "Saved ", file, *error);
+    });
+}
+
+TaskId ImGuiBuilder::StartLoad(const char* path) {
+    // Read into a store of its own, swapped in by the apply
+    std::shared_ptr<ElementStore> loaded = std::make_shared<ElementStore>();
+    std::shared_ptr<const char*> name = std::make_shared<const char*>(nullptr);
+    std::string file = path;
+    std::shared_ptr<std::string> error = std::make_shared<std::string>();
+    return tasks.Start("Loading", [loaded, name, file, error](TaskContext& context) {
+        context.SetProgress(-1.0f, "Reading");
+        return LoadProjectFile(*loaded, file.c_str(), name.get(), error.get());
+    }, [this, loaded, name, file, error](TaskStatus status) {
+        if (status == TaskStatus_Done) {
+            // The name is interned in the loaded store, it moves with it. The replaced document is freed with the task.
+            elements.Swap(*loaded);
+            selected_element = ElementIndex_None;
+            history.Clear();
+            snprintf(menu_name, sizeof(menu_name), "%s", *name);
+            show_menu = true;
+            saved_revision = elements.GetRevision();
+            tree_rows_dirty = true;
+            preview.Invalidate();
+        }
+        ReportTask(status, "Loaded ", file, *error);
+    });
+}
+
+TaskId ImGuiBuilder::StartExport(const char* base_path) {
+    std::shared_ptr<const ElementStore> document = GetSnapshot();
+    std::string name = menu_name;
+    std::string base = base_path;
+    std::shared_ptr<std::string> error = std::make_shared<std::string>();
+    std::shared_ptr<LayoutFoldStats> fold = std::make_shared<LayoutFoldStats>();
+    // The cache and the pool are the worker's while the task runs: ExportCode() waits for it
+    ThreadPool* pool = nullptr;
+    if (parallel_export) {
+        if (!export_pool) {
+            export_pool.reset(new ThreadPool());
+        }
+        pool = export_pool.get();
+    }
+    return tasks.Start("Exporting", [this, document, name, base, error, fold, pool](TaskContext& context) {
+        context.SetProgress(-1.0f, "Generating code");
+        *fold = AnalyzeLayout(*document);
+        if (pool) {
+            return ExportDocumentCode(parallel_code, *pool, *document, name.c_str(), base.c_str(), error.get());
+        }
+        return ExportDocumentCode(code_cache, *document, name.c_str(), base.c_str(), error.get());
+    }, [this, base, error, fold](TaskStatus status) {
+        ReportTask(status, "Exported ", base + ".h/.cpp" + FoldSummary(*fold), *error);
+    });
+}
+
+int ImGuiBuilder::OpenDocument(const char* path) {
+    if (workspace.GetCount() == 0 && workspace.GetActive() < 0) {
+        const int current = workspace.Add(project_path);
+        workspace.Get(current).state = WorkspaceDocumentState_Loaded;
+        workspace.SetActive(current);
+    }
+    return workspace.Add(path);
+}
+
+bool ImGuiBuilder::ShowDocument(int index) {
+    if (index == workspace.GetActive()) {
+        return true;
+    }
+    workspace.Request(index);
+    WorkspaceDocument& document = workspace.Get(index);
+    if (document.state == WorkspaceDocumentState_Loaded) {
+        ActivateDocument(index);
+        return true;
+    }
+    if (document.state != WorkspaceDocumentState_Loading) {
+        StartDocumentLoad(index);
+    }
+    return false;
+}
+
+void ImGuiBuilder::CloseDocument(int index) {
+    if (index == workspace.GetActive()) {
+        WorkspaceBody empty;
+        SwapDocument(empty);
+    }
+    workspace.Remove(index);
+    if (workspace.GetActive() < 0 && workspace.GetRequested() < 0 && workspace.GetCount() > 0) {
+        workspace.Request(index < workspace.GetCount() ? index : workspace.GetCount() - 1);
+    }
+}
+
+void ImGuiBuilder::RequestCloseDocument(int index) {
+    if (IsDocumentModified(index)) {
+        close_pending = workspace.Get(index).path;
+    } else {
+        CloseDocument(index);
+        selected_tab = -1;
+    }
+}
+
+bool ImGuiBuilder::IsDocumentModified(int index) const {
+    if (index == workspace.GetActive()) {
+        return IsModified();
+    }
+    const WorkspaceDocument& document = workspace.Get(index);
+    return document.body && document.body->elements.GetRevision() != document.body->saved_revision;
+}
+
+TaskId ImGuiBuilder::StartSaveAndClose(int index) {
+    const WorkspaceDocument& document = workspace.Get(index);
+    std::shared_ptr<const ElementStore> snapshot;
+    std::string name;
+    if (index == workspace.GetActive()) {
+        snapshot = GetSnapshot();
+        name = menu_name;
+    } else {
+        std::shared_ptr<ElementStore> copy = std::make_shared<ElementStore>();
+        copy->CopySnapshot(document.body->elements);
+        snapshot = copy;
+        name = document.body->menu_name;
+    }
+    std::string file = document.path;
+    std::shared_ptr<std::string> error = std::make_shared<std::string>();
+    return tasks.Start("Saving", [snapshot, name, file, error](TaskContext& context) {
+        context.SetProgress(-1.0f, "Writing");
+        return SaveProjectFile(*snapshot, name.c_str(), file.c_str(), error.get());
+    }, [this, snapshot, file, error](TaskStatus status) {
+        // A failed save keeps the document open, the error in the project status
+        ReportTask(status, "Saved ", file, *error);
+        const int index = workspace.Find(file.c_str());
+        if (status != TaskStatus_Done || index < 0) {
+            return;
+        }
+        // The document may have been shown, hidden or edited meanwhile: only what was written is closed
+        const bool active = index == workspace.GetActive();
+        WorkspaceBody* body = workspace.Get(index).body.get();
+        if (!active && !body) {
+            return;
+        }
+        if ((active ? elements.GetRevision() : body->elements.GetRevision()) != snapshot->GetRevision()) {
+            return;
+        }
+        CloseDocument(index);
+        selected_tab = -1;
+    });
+}
+
+// Save / Discard / Cancel for the document RequestCloseDocument() kept open. Found by path: tabs may have been closed
+// meanwhile, shifting indices.
+void ImGuiBuilder::RenderCloseConfirmation() {
+    if (!close_pending) {
+        return;
+    }
+    const int index = workspace.Find(close_pending);
+    if (index < 0) {
+        close_pending = nullptr;
+        close_popup_open = false;
+        return;
+    }
+    if (!close_popup_open) {
+        ImGui::OpenPopup("Unsaved Changes");
+        close_popup_open = true;
+    }
+    if (ImGui::BeginPopupModal("Unsaved Changes", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::Text("%s has unsaved changes.", workspace.Get(index).title);
+        bool answered = false;
+        bool close = false;
+        if (ImGui::Button("Save")) {
+            StartSaveAndClose(index);
+            answered = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Discard")) {
+            close = answered = true;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel")) {
+            answered = true;
+        }
+        if (close) {
+            CloseDocument(index);
+            selected_tab = -1;
+        }
+        if (answered) {
+            close_pending = nullptr;
+            close_popup_open = false;
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+}
+
+// Reads the body of a document on the task queue. Documents are named by path in the apply: tabs may have been
+// closed meanwhile, shifting indices.
+void ImGuiBuilder::StartDocumentLoad(int index) {
+    WorkspaceDocument& document = workspace.Get(index);
+    document.state = WorkspaceDocumentState_Loading;
+    std::shared_ptr<WorkspaceBody> body = std::make_shared<WorkspaceBody>();
+    std::string file = document.path;
+    std::shared_ptr<std::string> error = std::make_shared<std::string>();
+    tasks.Start("Opening", [body, file, error](TaskContext& context) {
+        context.SetProgress(-1.0f, "Reading");
+        const char* name = nullptr;
+        if (!LoadProjectFile(body->elements, file.c_str(), &name, error.get())) {
+            return false;
+        }
+        snprintf(body->menu_name, sizeof(body->menu_name), "%s", name);
+        body->saved_revision = body->elements.GetRevision();
+        return true;
+    }, [this, body, file, error](TaskStatus status) {
+        ReportTask(status, "Opened ", file, *error);
+        const int index = workspace.Find(file.c_str());
+        if (index < 0 || workspace.Get(index).state != WorkspaceDocumentState_Loading) {
+            return;
+        }
+        WorkspaceDocument& document = workspace.Get(index);
+        if (status != TaskStatus_Done) {
+            document.state = status == TaskStatus_Failed ? WorkspaceDocumentState_Failed : WorkspaceDocumentState_Unloaded;
+            if (workspace.GetRequested() == index) {
+                workspace.Request(-1);
+            }
+            return;
+        }
+        document.body = body;
+        document.state = WorkspaceDocumentState_Loaded;
+        if (workspace.GetRequested() == index) {
+            ActivateDocument(index);
+        } else {
+            workspace.Trim();
+        }
+    });
+}
+
+void ImGuiBuilder::ActivateDocument(int index) {
+    const int previous = workspace.GetActive();
+    std::shared_ptr<WorkspaceBody> body = std::move(workspace.Get(index).body);
+    SwapDocument(*body);
+    // The document shown so far keeps its body, unless it had no tab
+    if (previous >= 0) {
+        workspace.Get(previous).body = std::move(body);
+    }
+    workspace.SetActive(index);
+    snprintf(project_path, sizeof(project_path), "%s", workspace.Get(index).path);
+    workspace.Trim();
+}
+
+// Exchange everything the builder keeps per document with 'body'. What is derived from the document (rows,
+// search results, generated code) is rebuilt from the revisions; the rows are dropped, their slots mean nothing now.
+void ImGuiBuilder::SwapDocument(WorkspaceBody& body) {
+    elements.Swap(body.elements);
+    std::swap(history, body.history);
+    std::swap(selected_element, body.selected_element);
+    std::swap(menu_name, body.menu_name);
+    std::swap(saved_revision, body.saved_revision);
+    tree_rows.clear();
+    tree_rows_dirty = true;
+    tree_rows_filtered = false;
+    preview.Invalidate();
+    generated_code_element = ElementIndex_None;
+    show_menu = true;
+}
+
+// One tab per open document. Only a change of the selected tab is a request: the tab bar keeps the old selection
+// for the frame after a document was shown from elsewhere.
+void ImGuiBuilder::RenderDocumentTabs() {
+    if (!ImGui::BeginTabBar("##Documents", ImGuiTabBarFlags_FittingPolicyScroll | ImGuiTabBarFlags_TabListPopupButton)) {
+        return;
+    }
+    const int target = workspace.GetRequested() >= 0 ? workspace.GetRequested() : workspace.GetActive();
+    int close = -1;
+    for (int n = 0; n < workspace.GetCount(); n++) {
+        const WorkspaceDocument& document = workspace.Get(n);
+        const bool active = n == workspace.GetActive();
+        ImGuiTabItemFlags flags = ImGuiTabItemFlags_None;
+        if (IsDocumentModified(n)) {
+            flags |= ImGuiTabItemFlags_UnsavedDocument;
+        }
+        if (n == target && n != selected_tab) {
+            flags |= ImGuiTabItemFlags_SetSelected;
+        }
+        // Paths are interned: the address identifies the document whatever its index
+        ImGui::PushID((const void*)document.path);
+        bool open = true;
+        if (ImGui::BeginTabItem(document.title, &open, flags)) {
+            if (n != selected_tab) {
+                selected_tab = n;
+                if (!active) {
+                    workspace.Request(n);
+                }
+            }
+            if (document.state == WorkspaceDocumentState_Loading) {
+                ImGui::TextDisabled("Loading %s...", document.path);
+            } else if (document.state == WorkspaceDocumentState_Failed) {
+                ImGui::TextDisabled("%s could not be read", document.path);
+            } else {
+                ImGui::Text("%s: %d elements", document.path, active ? elements.Size() : document.body ? document.body->elements.Size() : 0);
+            }
+            ImGui::EndTabItem();
+        }
+        ImGui::PopID();
+        if (!open) {
+            close = n;
+        }
+    }
+    ImGui::EndTabBar();
+    if (close >= 0) {
+        RequestCloseDocument(close);
+    }
+}
+
+// Runs the query typed in the search box against a snapshot of the document
+void ImGuiBuilder::StartSearch() {
+    std::shared_ptr<const ElementStore> document = GetSnapshot();
+    search_query = search_text;
+    search_task = tasks.Start("Searching", [this, document](TaskContext& context) {
+        context.SetProgress(0.0f, "Indexing");
+        search_index.Sync(*document);
+        if (context.IsCancelled()) {
+            return false;
+        }
+        context.SetProgress(0.5f, "Matching");
+        search_index.Find(*document, search_query.c_str(), search_results);
+        context.SetProgress(1.0f);
+        return true;
+    }, [this, document](TaskStatus status) {
+        search_task = 0;
+        // The slots of the matches only mean something in a tree of the same shape, and only for the query still typed.
+        // Otherwise the rows stay out of date and the next frame searches again.
+        if (status != TaskStatus_Done || search_query != search_text || document->GetStructureRevision() != elements.GetStructureRevision()) {
+            return;
+        }
+        search_matches.swap(search_results);
+        BuildFilteredTreeRows(elements, search_matches, search_marks, tree_rows);
+        tree_rows_revision = document->GetRevision();
+        tree_rows_dirty = false;
+        tree_rows_filtered = true;
+    });
+}
+
+// Progress of the background tasks, each with a button to cancel it
+void ImGuiBuilder::RenderTasks() {
+    tasks.GetTasks(task_infos);
+    for (const TaskInfo& task : task_infos) {
+        ImGui::PushID(task.id);
+        char overlay[96];
+        if (task.status == TaskStatus_Queued) {
+            snprintf(overlay, sizeof(overlay), "%s (waiting)", task.name);
+        } else {
+            snprintf(overlay, sizeof(overlay), "%s%s%s (%.1f s)", task.name, task.step ? ": " : "", task.step ? task.step : "", task.seconds);
+        }
+        // Unknown progress: the bar moves back and forth
+        ImGui::ProgressBar(task.progress >= 0.0f ? task.progress : -1.0f * (float)ImGui::GetTime(), ImVec2(220.0f, 0.0f), overlay);
+        ImGui::SameLine();
+        ImGui::BeginDisabled(task.status == TaskStatus_Cancelled);
+        if (ImGui::SmallButton("Cancel")) {
+            tasks.Cancel(task.id);
+        }
+        ImGui::EndDisabled();
+        ImGui::PopID();
+    }
+}
+
+// Serve the document to running applications (see imgui_builder_live.h)
+void ImGuiBuilder::RenderLiveMenu() {
+    const bool serving = live_server.IsListening();
+    if (ImGui::MenuItem("Serve Document", nullptr, serving)) {
+        if (serving) {
+            live_server.Close();
+            live_status.clear();
+        } else if (live_server.Listen(live_port, &live_status)) {
+            live_status.clear();
+        }
+    }
+    if (!serving) {
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::InputInt("Port", &live_port);
+    } else {
+        const LiveServerStats& stats = live_server.GetStats();
+        ImGui::Text("127.0.0.1:%d, %d application(s) connected", live_server.GetPort(), stats.clients);
+        ImGui::Text("%d deltas, last %d bytes written in %.3f ms", stats.messages, (int)stats.last_message_size, stats.last_write_ms);
+    }
+    if (!live_status.empty()) {
+        ImGui::TextUnformatted(live_status.c_str());
+    }
+}
+
+// Appended to the profiler window
+void ImGuiBuilder::RenderSchedulerStats() {
+    if (ImGui::Begin("Profiler")) {
+        ImGui::Separator();
+        bool event_driven = scheduler.IsEnabled();
+        if (ImGui::Checkbox("Redraw only on changes", &event_driven)) {
+            scheduler.SetEnabled(event_driven);
+        }
+        const FrameSchedulerStats stats = scheduler.GetStats();
+        ImGui::Text("%d frames rendered, %d skipped, %d events", stats.frames_rendered, stats.frames_skipped, stats.events);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Reset")) {
+            scheduler.ResetStats();
+        }
+    }
+    ImGui::End();
+}
+
+void ImGuiBuilder::RenderElementTree() {
+    ImGui::Text("ImGui Elements Library");
+    ImGui::Separator();
+
+    // Element categories
+    if (ImGui::TreeNode("Basic Elements")) {
+        AddElementButton("Button", ElementType::BUTTON);
+        AddElementButton("Checkbox", ElementType::CHECKBOX);
+        AddElementButton("Text", ElementType::TEXT);
+        AddElementButton("Separator", ElementType::SEPARATOR);
+        AddElementButton("Spacing", ElementType::SPACING);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Input Elements")) {
+        AddElementButton("Text Input", ElementType::INPUT_TEXT);
+        AddElementButton("Integer Input", ElementType::INPUT_INT);
+        AddElementButton("Float Input", ElementType::INPUT_FLOAT);
+        AddElementButton("Slider Float", ElementType::SLIDER_FLOAT);
+        AddElementButton("Slider Int", ElementType::SLIDER_INT);
+        AddElementButton("Color Picker", ElementType::COLOR_PICKER);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Selection Elements")) {
+        AddElementButton("Combo Box", ElementType::COMBO);
+        AddElementButton("List Box", ElementType::LISTBOX);
+        AddElementButton("Radio Button", ElementType::RADIO_BUTTON);
+        AddElementButton("Selectable", ElementType::SELECTABLE);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Layout Elements")) {
+        AddElementButton("Tree Node", ElementType::TREE_NODE);
+        AddElementButton("Collapsing Header", ElementType::COLLAPSING_HEADER);
+        AddElementButton("Tab Bar", ElementType::TAB_BAR);
+        AddElementButton("Tab Item", ElementType::TAB_ITEM);
+        AddElementButton("Child Window", ElementType::CHILD_WINDOW);
+        AddElementButton("Columns", ElementType::COLUMNS);
+        AddElementButton("Table", ElementType::TABLE);
+        AddElementButton("Group", ElementType::GROUP);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Menu Elements")) {
+        AddElementButton("Menu Bar", ElementType::MENU_BAR);
+        AddElementButton("Menu Item", ElementType::MENU_ITEM);
+        AddElementButton("Popup", ElementType::POPUP);
+        AddElementButton("Tooltip", ElementType::TOOLTIP);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Visual Elements")) {
+
+        AddElementButton("Bullet Text", ElementType::BULLET_TEXT);
+        AddElementButton("Plot Lines", ElementType::PLOT_LINES);
+        AddElementButton("Plot Histogram", ElementType::PLOT_HISTOGRAM);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Utility Elements")) {
+        AddElementButton("Same Line", ElementType::SAME_LINE);
+        AddElementButton("New Line", ElementType::NEW_LINE);
+        AddElementButton("Indent", ElementType::INDENT);
+        AddElementButton("Unindent", ElementType::UNINDENT);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNode("Components")) {
+        AddElementButton("Component", ElementType::COMPONENT);
+        AddElementButton("Instance", ElementType::INSTANCE);
+        ImGui::TreePop();
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Created Elements:");
+    if (ImGui::InputTextWithHint("##Search", "Search labels, texts and types", search_text, sizeof(search_text))) {
+        tree_rows_dirty = true;
+    }
+    const bool searching = search_text[0] != 0;
+    if (searching) {
+        ImGui::SameLine();
+        ImGui::Text("%d found", (int)search_matches.size());
+    }
+
+    // Only the rows scrolled into view are submitted. While searching any edit can change the matches: they are
+    // found by a task, the rows of the last results are shown until the new ones are applied.
+    const ElementRevision rows_revision = searching ? elements.GetRevision() : elements.GetStructureRevision();
+    if (tree_rows_dirty || tree_rows_revision != rows_revision || tree_rows_filtered != searching) {
+        if (searching) {
+            if (search_task == 0) {
+                StartSearch();
+            }
+        } else {
+            search_matches.clear();
+            BuildTreeRows(elements, tree_rows);
+            tree_rows_revision = rows_revision;
+            tree_rows_dirty = false;
+            tree_rows_filtered = false;
+        }
+    }
+    ImGuiListClipper clipper;
+    clipper.Begin((int)tree_rows.size());
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            // Rows of an element deleted this frame are left for the next rebuild
+            if (elements.IsAlive(tree_rows[row].element)) {
+                RenderElementInTree(tree_rows[row]);
+            }
+        }
+    }
+
+    if (ImGui::Button("Clear All Elements")) {
+        ClearElements();
+    }
+}
+
+void ImGuiBuilder::AddElementButton(const char* name, ElementType type) {
+    if (ImGui::Button(name)) {
+        selected_element = AddElement(type, name);
+        history.RecordInsert(elements, selected_element);
+    }
+}
+
+void ImGuiBuilder::RenderElementInTree(const ElementRow& row) {
+    const ElementIndex element = row.element;
+    const bool leaf = elements.FirstChild(element) == ElementIndex_None;
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    if (leaf) {
+        flags |= ImGuiTreeNodeFlags_Leaf;
+    }
+    if (element == selected_element) {
+        flags |= ImGuiTreeNodeFlags_Selected;
+    }
+
+    // Elements are told apart by uid, labels may repeat
+    ImGui::PushID((int)elements.uids[element]);
+    if (row.depth > 0) {
+        ImGui::SetCursorPosX(ImGui::GetCursorPosX() + row.depth * ImGui::GetStyle().IndentSpacing);
+    }
+    // Rows are flat (no TreePush): the expanded state lives in the element, children are rows of their own.
+    // Search results show the path to every match, whatever was expanded.
+    const bool filtered = tree_rows_filtered;
+    const bool expanded = filtered ? (search_marks[element] & TreeRowMark_Ancestor) != 0 : (elements.flags[element] & ElementFlags_Expanded) != 0;
+    ImGui::SetNextItemOpen(expanded);
+    if (ImGui::TreeNodeEx(elements.strings[element].label, flags) != expanded && !leaf && !filtered) {
+        elements.flags[element] ^= ElementFlags_Expanded;
+        tree_rows_dirty = true;
+    }
+    const float row_middle = (ImGui::GetItemRectMin().y + ImGui::GetItemRectMax().y) * 0.5f;
+
+    if (ImGui::IsItemClicked()) {
+        selected_element = element;
+    }
+
+    // Drag and drop: the upper half of a row drops before it, the lower half inside it (last child).
+    // The payload is the uid, the slot may be deleted and reused while the mouse button is down.
+    if (ImGui::BeginDragDropSource()) {
+        const ElementUid uid = elements.uids[element];
+        ImGui::SetDragDropPayload("BUILDER_ELEMENT", &uid, sizeof(uid));
+        ImGui::TextUnformatted(elements.strings[element].label);
+        ImGui::EndDragDropSource();
+    }
+    if (ImGui::BeginDragDropTarget()) {
+        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("BUILDER_ELEMENT")) {
+            ElementUid uid;
+            memcpy(&uid, payload->Data, sizeof(uid));
+            const ElementIndex dragged = elements.FindByUid(uid);
+            if (dragged != ElementIndex_None) {
+                if (ImGui::GetMousePos().y < row_middle) {
+                    MoveElement(dragged, elements.Parent(element), element);
+                } else if (!elements.IsDescendantOrSelf(element, dragged)) {
+                    MoveElement(dragged, element, ElementIndex_None);
+                    elements.flags[element] |= ElementFlags_Expanded;
+                }
+            }
+        }
+        ImGui::EndDragDropTarget();
+    }
+
+    // Context menu
+    if (ImGui::BeginPopupContextItem()) {
+        if (ImGui::MenuItem("Delete")) {
+            if (selected_element != ElementIndex_None && elements.IsDescendantOrSelf(selected_element, element)) {
+                selected_element = ElementIndex_None;
+            }
+            history.RecordRemove(elements, element);
+            elements.Remove(element);
+        } else if (ImGui::MenuItem("Duplicate")) {
+            ElementIndex new_element = elements.Duplicate(element);
+            char new_label[256];
+            snprintf(new_label, sizeof(new_label), "%s Copy", elements.strings[new_element].label);
+            elements.SetLabel(new_element, new_label);
+            elements.Insert(elements.Parent(element), elements.NextSibling(element), new_element);
+            history.RecordInsert(elements, new_element);
+        }
+        if (elements.types[element] == ElementType::COMPONENT) {
+            if (ImGui::MenuItem("Add Instance")) {
+                selected_element = AddInstance(element);
+            }
+        } else if (ImGui::MenuItem("Make Component")) {
+            selected_element = MakeComponent(element);
+        }
+        ImGui::Separator();
+        const ElementIndex parent = elements.Parent(element);
+        const ElementIndex prev = elements.PrevSibling(element);
+        const ElementIndex next = elements.NextSibling(element);
+        if (ImGui::MenuItem("Move Up", nullptr, false, prev != ElementIndex_None)) {
+            MoveElement(element, parent, prev);
+        }
+        if (ImGui::MenuItem("Move Down", nullptr, false, next != ElementIndex_None)) {
+            MoveElement(element, parent, elements.NextSibling(next));
+        }
+        if (ImGui::MenuItem("Move Out", nullptr, false, parent != ElementIndex_None)) {
+            MoveElement(element, elements.Parent(parent), elements.NextSibling(parent));
+        }
+        ImGui::EndPopup();
+    }
+    ImGui::PopID();
+}
+
+const ComponentTable& ImGuiBuilder::GetComponents() {
+    if (components.IsStale(elements)) {
+        components.Build(elements);
+    }
+    return components;
+}
+
+ElementIndex ImGuiBuilder::MakeComponent(ElementIndex element) {
+    // "Row", "Row 2", "Row 3"...: instances find their component by name
+    const char* label = elements.strings[element].label;
+    char name[256];
+    snprintf(name, sizeof(name), "%s", label);
+    for (int n = 2; GetComponents().Contains(name); n++) {
+        snprintf(name, sizeof(name), "%s %d", label, n);
+    }
+    // Inserting the component and the instance, then moving the element in, undo as one step
+    history.BeginGroup();
+    const ElementIndex component = AddElement(ElementType::COMPONENT, name);
+    history.RecordInsert(elements, component);
+
+    const ElementIndex instance = elements.Create(ElementType::INSTANCE, name);
+    elements.SetText(instance, name);
+    elements.Insert(elements.Parent(element), element, instance);
+    history.RecordInsert(elements, instance);
+    MoveElement(element, component, ElementIndex_None);
+    history.EndGroup();
+    return instance;
+}
+
+ElementIndex ImGuiBuilder::AddInstance(ElementIndex component) {
+    const char* name = elements.strings[component].label;
+    const ElementIndex instance = AddElement(ElementType::INSTANCE, name);
+    elements.SetText(instance, name);
+    history.RecordInsert(elements, instance);
+    return instance;
+}
+
+// Instances following a component while its label is edited. They are found by 'name', the label before the edit,
+// once when it starts: a name typed on the way may be another component's, whose instances must not follow.
+// None if another component has the same name: its instances cannot be told apart.
+void ImGuiBuilder::TrackInstances(ElementIndex component, const char* name) {
+    renamed_component = elements.uids[component];
+    renamed_instances.clear();
+    for (ElementIndex element = 0; element < (ElementIndex)elements.types.size(); element++) {
+        if (!elements.IsAlive(element)) {
+            continue;
+        }
+        if (elements.types[element] == ElementType::COMPONENT && element != component && strcmp(elements.strings[element].label, name) == 0) {
+            renamed_instances.clear();
+            return;
+        }
+        if (elements.types[element] == ElementType::INSTANCE && strcmp(elements.strings[element].text_value, name) == 0) {
+            renamed_instances.push_back(elements.uids[element]);
+        }
+    }
+}
+
+void ImGuiBuilder::RenameInstances(ElementIndex component) {
+    if (elements.uids[component] != renamed_component) {
+        return;
+    }
+    const char* name = elements.strings[component].label;
+    for (ElementUid uid : renamed_instances) {
+        const ElementIndex instance = elements.FindByUid(uid);
+        if (instance != ElementIndex_None && elements.types[instance] == ElementType::INSTANCE) {
+            history.BeginEdit(elements, instance);
+            elements.SetText(instance, name);
+            history.EndEdit(elements);
+        }
+    }
+}
+
+void ImGuiBuilder::MoveElement(ElementIndex element, ElementIndex parent, ElementIndex before) {
+    const ElementIndex old_parent = elements.Parent(element);
+    const ElementIndex old_before = elements.NextSibling(element);
+    if (before == element || (parent == old_parent && before == old_before)) {
+        return;
+    }
+    if (elements.Move(element, parent, before)) {
+        history.RecordMove(elements, element, old_parent, old_before);
+    }
+}
+
+bool ImGuiBuilder::InputString(const char* label, const char* text, bool multiline) {
+    return ::InputString(label, text, text_buffer, multiline);
+}
+
+void ImGuiBuilder::RenderProperties() {
+    if (selected_element == ElementIndex_None) {
+        ImGui::Text("No element selected");
+        ImGui::Text("Select an element from the tree to edit its properties");
+        return;
+    }
+
+    ElementStrings& strings = elements.strings[selected_element];
+    ElementFlags& flags = elements.flags[selected_element];
+    ElementStyle& style = elements.styles[selected_element];
+    const ElementType type = elements.types[selected_element];
+    const char* const old_label = strings.label;
+    // Whatever the widgets below change becomes one undo step, with the instances of a renamed component
+    if (type == ElementType::COMPONENT) {
+        history.BeginGroup();
+    }
+    history.BeginEdit(elements, selected_element);
+
+    ImGui::Text("Element Properties");
+    ImGui::SameLine();
+    ImGui::TextDisabled("(uid %llu)", (unsigned long long)elements.uids[selected_element]);
+    ImGui::Separator();
+
+    // Basic properties
+    if (InputString("Label", strings.label)) {
+        elements.SetLabel(selected_element, text_buffer.data());
+    }
+    if (type == ElementType::COMPONENT && ImGui::IsItemActivated()) {
+        TrackInstances(selected_element, old_label);
+    }
+
+    // Widgets below write the element directly: record the change for revision based caches
+    bool edited = false;
+    edited |= ImGui::CheckboxFlags("Enabled", &flags, ElementFlags_Enabled);
+    if (ImGui::CheckboxFlags("Visible", &flags, ElementFlags_Visible)) {
+        preview.Invalidate();
+        edited = true;
+    }
+
+    // Properties of the type's payload
+    const ElementTypeInfo& info = GetElementTypeInfo(type);
+    edited |= info.edit(*this, selected_element);
+
+    // Style properties
+    ImGui::Separator();
+    ImGui::Text("Style Properties");
+
+    edited |= ImGui::DragFloat2("Size", (float*)&style.size);
+    edited |= ImGui::ColorEdit4("Text Color", (float*)&style.text_color);
+    if (info.background >= 0) {
+        edited |= ImGui::ColorEdit4("Background Color", (float*)&style.bg_color);
+    }
+
+    if (edited) {
+        elements.Touch(selected_element);
+    }
+    history.EndEdit(elements);
+    if (type == ElementType::COMPONENT) {
+        if (elements.strings[selected_element].label != old_label) {
+            RenameInstances(selected_element);
+        }
+        history.EndGroup();
+    }
+
+    // Code generation
+    ImGui::Separator();
+    if (ImGui::Button("Generate Code")) {
+        ImGui::OpenPopup("Generated Code");
+    }
+
+    if (ImGui::BeginPopupModal("Generated Code", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::Text("Generated C++ Code:");
+        ImGui::Separator();
+
+        // Regenerated only when the element changed, drawn one visible line at a time
+        UpdateGeneratedCode(selected_element);
+        ImGui::BeginChild("Code", ImVec2(600, 400), true, ImGuiWindowFlags_HorizontalScrollbar);
+        ImGuiListClipper clipper;
+        clipper.Begin((int)generated_code_lines.size() - 1);
+        while (clipper.Step()) {
+            for (int line = clipper.DisplayStart; line < clipper.DisplayEnd; line++) {
+                ImGui::TextUnformatted(generated_code.Begin() + generated_code_lines[line], generated_code.Begin() + generated_code_lines[line + 1] - 1);
+            }
+        }
+        ImGui::EndChild();
+
+        if (ImGui::Button("Close")) {
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Payload properties, the edit hooks of the element type table
+//-----------------------------------------------------------------------------
+
+// Every field of the type's payload
+bool ElementTraitsDefaults::Edit(ImGuiBuilder& builder, ElementIndex element) {
+    ElementStore& elements = builder.elements;
+    const ElementTypeInfo& info = GetElementTypeInfo(elements.types[element]);
+    bool edited = false;
+    if (info.payload & ElementPayload_Bool) {
+        edited |= ImGui::CheckboxFlags("Default Value", &elements.flags[element], ElementFlags_BoolValue);
+    }
+    ElementRange* range = elements.EditRange(element);
+    if (range) {
+        edited |= ImGui::DragFloat("Min Value", &range->min_value);
+        edited |= ImGui::DragFloat("Max Value", &range->max_value);
+    }
+    // The value stays within the element's range, or within the fixed bounds of its type (slider)
+    const bool bounded = !range && info.value_min < info.value_max;
+    const float value_min = range ? range->min_value : info.value_min;
+    const float value_max = range ? range->max_value : info.value_max;
+    if (float* float_value = elements.EditFloat(element)) {
+        edited |= bounded ?
+            ImGui::SliderFloat(info.value_label, float_value, value_min, value_max) :
+            ImGui::DragFloat(info.value_label, float_value, 1.0f, value_min, value_max);
+    }
+    if (int* int_value = elements.EditInt(element)) {
+        edited |= bounded ?
+            ImGui::SliderInt(info.value_label, int_value, (int)value_min, (int)value_max) :
+            ImGui::DragInt(info.value_label, int_value, 1.0f, (int)value_min, (int)value_max);
+    }
+    if (info.payload & ElementPayload_Text) {
+        if (builder.InputString("Text Content", elements.strings[element].text_value, true)) {
+            elements.SetText(element, builder.text_buffer.data());
+        }
+    }
+    if (info.payload & ElementPayload_Items) {
+        ImGui::Text("Items:");
+        for (int i = 0; i < elements.GetItemCount(element); ++i) {
+            ImGui::PushID(i);
+            if (builder.InputString("##item", elements.GetItems(element)[i])) {
+                elements.SetItem(element, i, builder.text_buffer.data());
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("X")) {
+                elements.RemoveItem(element, i);
+                --i;
+            }
+            ImGui::PopID();
+        }
+        if (ImGui::Button("Add Item")) {
+            elements.AddItem(element, "New Item");
+        }
+        ElementItemList& list = *elements.EditItemList(element);
+        if (list.selected_item >= list.count) {
+            list.selected_item = list.count > 0 ? list.count - 1 : 0;
+            edited = true;
+        }
+        if (list.count > 1) {
+            edited |= ImGui::SliderInt("Selected Item", &list.selected_item, 0, list.count - 1);
+        }
+    }
+    if (info.payload & ElementPayload_Color) {
+        edited |= ImGui::ColorEdit4("Default Color", (float*)elements.EditColor(element));
+    }
+    return edited;
+}
+
+// The text of an instance is the name of its component
+bool ElementTraits<ElementType::INSTANCE>::Edit(ImGuiBuilder& builder, ElementIndex element) {
+    ElementStore& elements = builder.elements;
+    const char* name = elements.strings[element].text_value;
+    const ComponentTable& table = builder.GetComponents();
+    if (ImGui::BeginCombo("Component", name)) {
+        for (int n = 0; n < table.GetCount(); n++) {
+            const char* component = elements.strings[table.Get(n)].label;
+            if (ImGui::Selectable(component, strcmp(component, name) == 0)) {
+                elements.SetText(element, component);
+            }
+        }
+        ImGui::EndCombo();
+    }
+    name = elements.strings[element].text_value;
+    if (table.Find(name) == ElementIndex_None) {
+        ImGui::TextDisabled(table.Contains(name) ? "(draws itself, not drawn)" : "(no such component)");
+    }
+    return false;
+}
+
+void ImGuiBuilder::UpdateGeneratedCode(ElementIndex element) {
+    if (element == generated_code_element && elements.revisions[element] == generated_code_revision) {
+        return;
+    }
+    GenerateElementCode(elements, element, generated_code);
+    generated_code_element = element;
+    generated_code_revision = elements.revisions[element];
+
+    // Line start offsets, plus the end of the last line
+    generated_code_lines.clear();
+    generated_code_lines.push_back(0);
+    for (const char* p = generated_code.Begin(); p < generated_code.End(); p++) {
+        if (*p == '\n') {
+            generated_code_lines.push_back((int)(p + 1 - generated_code.Begin()));
+        }
+    }
+    if (generated_code_lines.back() != (int)generated_code.Size()) {
+        generated_code_lines.push_back((int)generated_code.Size() + 1);
+    }
+}
+
+void ImGuiBuilder::RenderPreview() {
+    preview.Render(elements);
+}
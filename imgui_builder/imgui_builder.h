@@ -0,0 +1,208 @@
+// ULTIMATE ImGui Builder: platform-neutral builder core
+// This file has no dependency on any platform or renderer backend: it only talks to the Dear ImGui API,
+// so it can be driven by the DirectX 9 application, by a null backend or by headless tools/benchmarks.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_codegen.h"
+#include "imgui_builder_components.h"
+#include "imgui_builder_history.h"
+#include "imgui_builder_jobs.h"
+#include "imgui_builder_live.h"
+#include "imgui_builder_preview.h"
+#include "imgui_builder_profiler.h"
+#include "imgui_builder_scheduler.h"
+#include "imgui_builder_rows.h"
+#include "imgui_builder_search.h"
+#include "imgui_builder_store.h"
+#include "imgui_builder_tasks.h"
+#include "imgui_builder_workspace.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// ImGui Builder Classes
+class ImGuiBuilder {
+private:
+    ElementStore elements;
+    ElementIndex selected_element = ElementIndex_None;
+    // Undo/redo of the edits made through the UI
+    EditHistory history;
+    bool show_menu = false;
+    bool show_properties = true;
+    bool show_element_tree = true;
+    bool show_preview = true;
+    bool show_profiler = false;
+    bool show_documents = true;
+    FrameProfiler profiler;
+    // Driven by the platform loop, shown in the profiler window
+    FrameScheduler scheduler;
+
+    // Builder state
+    char new_element_name[256] = "New Element";
+    ElementType selected_type = ElementType::BUTTON;
+
+    // Menu creation
+    bool create_menu = false;
+    char menu_name[256] = "My Menu";
+
+    // Live applications following the document
+    LiveServer live_server;
+    int live_port = LIVE_DEFAULT_PORT;
+    std::string live_status;
+
+    // Project file
+    char project_path[260] = "menu.imgb";
+    char code_path[260] = "menu";
+    std::string project_status;
+    ElementRevision saved_revision = 0;         // Revision of the document when last loaded or saved
+
+    // Open documents, one tab each: the one above is the active one (see imgui_builder_workspace.h)
+    Workspace workspace;
+    int selected_tab = -1;                      // Tab the tab bar showed last frame
+    const char* close_pending = nullptr;        // Modified document asked to close: its interned path, until answered
+    bool close_popup_open = false;
+
+    // Virtualized element tree: flat rows, rebuilt when the tree changes shape or a node opens/closes
+    std::vector<ElementRow> tree_rows;
+    ElementRevision tree_rows_revision = 0;     // Structure revision, document revision while searching
+    bool tree_rows_dirty = true;
+    bool tree_rows_filtered = false;            // Built from search matches
+    // Search box of the element tree: only matches and their ancestors are listed.
+    // Matching runs as a task (see StartSearch()): the index, query and results are the worker's while it runs.
+    char search_text[128] = "";
+    TaskId search_task = 0;
+    ElementSearchIndex search_index;
+    std::string search_query;
+    std::vector<ElementIndex> search_results;
+    std::vector<ElementIndex> search_matches;
+    std::vector<unsigned char> search_marks;    // TreeRowMark_ per slot
+    // Preview window, virtualized the same way
+    ElementPreview preview{ &profiler };
+    // Components of the document, for the menus and the property editor (see GetComponents())
+    ComponentTable components;
+    // Instances of the component whose label is being edited, found by name when the edit started (see TrackInstances())
+    ElementUid renamed_component = ElementUid_None;
+    std::vector<ElementUid> renamed_instances;
+
+    // Text being edited by InputString(): one buffer for every text field of the builder, grown by ImGui as the text grows
+    std::vector<char> text_buffer;
+
+    // "Generated Code" window content, kept until the element changes
+    CodeBuffer generated_code;
+    std::vector<int> generated_code_lines;
+    ElementIndex generated_code_element = ElementIndex_None;
+    ElementRevision generated_code_revision = 0;
+    // Whole document code, regenerated incrementally by "Export Code"
+    CodeCache code_cache;
+    // Or from scratch on every core ("Parallel Export"): the pool is started on first use
+    bool parallel_export = false;
+    std::unique_ptr<ThreadPool> export_pool;
+    ParallelCodeGenerator parallel_code;
+
+    // Immutable copy of the document the background tasks work on, shared by the tasks started on the same revision
+    std::shared_ptr<ElementStore> snapshot;
+    bool snapshot_pinned = false;               // Holds the strings of the document (see StringPool::Pin())
+    std::vector<TaskInfo> task_infos;
+    // Saving, loading, exporting and searching off the UI thread. Declared last: destroyed first, so the tasks
+    // still running never see the members they use destroyed.
+    TaskQueue tasks;
+
+public:
+    // Full builder UI (main menu bar + all panels). Call between ImGui::NewFrame() and ImGui::Render().
+    void Render();
+
+    // Document access, used by the UI and by headless drivers (benchmarks, tools).
+    // AddElement() applies the same per-type defaults as the "ImGui Elements Library" buttons.
+    ElementIndex AddElement(ElementType type, const char* label, ElementIndex parent = ElementIndex_None);
+    void ClearElements();
+    ElementStore& GetElements() { return elements; }
+    const ElementStore& GetElements() const { return elements; }
+    void SetMenuVisible(bool visible) { show_menu = visible; }
+    void SetParallelExport(bool parallel) { parallel_export = parallel; }
+    // Element shown in the "Properties" window
+    void SelectElement(ElementIndex element) { selected_element = element; }
+    // Components (see imgui_builder_components.h). MakeComponent() moves 'element' into a new component, named
+    // after its label, and puts an instance of it in its place; AddInstance() appends an instance of 'component'
+    // to the top level. Both return the instance and can be undone.
+    ElementIndex MakeComponent(ElementIndex element);
+    ElementIndex AddInstance(ElementIndex component);
+
+    // Edits made through the UI can be undone. Headless drivers editing GetElements() directly record them
+    // into GetHistory() themselves if they want them undoable.
+    bool Undo();
+    bool Redo();
+    EditHistory& GetHistory() { return history; }
+    FrameProfiler& GetProfiler() { return profiler; }
+    FrameScheduler& GetScheduler() { return scheduler; }
+    // Serves the document while listening (the "Live" menu). Render() sends the edits of each frame; platform
+    // loops that sleep between frames also poll it while idle, to accept applications and flush to them: while it
+    // listens, the scheduler's timeout wakes them up once per refresh for that.
+    LiveServer& GetLiveServer() { return live_server; }
+
+    // Project files: binary (see imgui_builder_project.h), or JSON when the path ends in ".json"
+    // (see imgui_builder_json.h). Failures are reported in the "Menu Creator" window.
+    // These run on the calling thread, after waiting for the tasks started before.
+    bool SaveProject(const char* path);
+    bool LoadProject(const char* path);
+    // Generated C++ for the whole document: '<base_path>.h' and '<base_path>.cpp' (see imgui_builder_codegen.h).
+    // Incremental by default, generated on a ThreadPool with SetParallelExport(true).
+    bool ExportCode(const char* base_path);
+
+    // Same, as background tasks (what the "File" menu does): saving and exporting work on a snapshot of the
+    // document taken now, a loaded document replaces the current one at the start of the frame after it was read,
+    // discarding the edits made meanwhile. Progress is shown in the "Menu Creator" window, where tasks can be cancelled.
+    // Loading keeps the path of the active tab: once tabs are open, the "File" menu opens the file as a tab instead.
+    TaskId StartSave(const char* path);
+    TaskId StartLoad(const char* path);
+    TaskId StartExport(const char* base_path);
+    TaskQueue& GetTasks() { return tasks; }
+    // Immutable copy of the current document for the background tasks (see ElementStore::CopySnapshot())
+    std::shared_ptr<const ElementStore> GetSnapshot();
+
+    // Workspace: documents open as tabs (see imgui_builder_workspace.h). OpenDocument() only adds an entry, the
+    // document edited so far becoming the first tab. ShowDocument() makes a document the edited one, right away if
+    // its body is in memory, otherwise once a task read it (returns false meanwhile). Closing the active document
+    // leaves an empty one until another tab is shown. CloseDocument() drops unsaved changes, RequestCloseDocument()
+    // (what the tabs and the "File" menu do) first asks whether to save them, in a popup. StartSaveAndClose() saves
+    // the document under its path as a task, closing it once written unless it was edited meanwhile.
+    int OpenDocument(const char* path);
+    bool ShowDocument(int index);
+    void CloseDocument(int index);
+    void RequestCloseDocument(int index);
+    TaskId StartSaveAndClose(int index);
+    Workspace& GetWorkspace() { return workspace; }
+    // Unsaved changes in the active document
+    bool IsModified() const { return elements.GetRevision() != saved_revision; }
+    bool IsDocumentModified(int index) const;
+
+    // Individual panels (each expects to be called inside a window)
+    void RenderElementTree();
+    void RenderProperties();
+    void RenderPreview();
+
+private:
+    // The edit hooks draw the properties of the element payloads (see imgui_builder_types.h)
+    friend struct ElementTraitsDefaults;
+    template <ElementType Type> friend struct ElementTraits;
+
+    void AddElementButton(const char* name, ElementType type);
+    void RenderElementInTree(const ElementRow& row);
+    void MoveElement(ElementIndex element, ElementIndex parent, ElementIndex before);
+    const ComponentTable& GetComponents();
+    void TrackInstances(ElementIndex component, const char* name);
+    void RenameInstances(ElementIndex component);
+    bool InputString(const char* label, const char* text, bool multiline = false);
+    void RenderSchedulerStats();
+    void RenderLiveMenu();
+    void RenderTasks();
+    void RenderDocumentTabs();
+    void RenderCloseConfirmation();
+    void StartDocumentLoad(int index);
+    void ActivateDocument(int index);
+    void SwapDocument(WorkspaceBody& body);
+    void StartSearch();
+    void ReportTask(TaskStatus status, const char* done, const std::string& path, const std::string& error);
+    void UpdateGeneratedCode(ElementIndex element);
+};
@@ -0,0 +1,195 @@
+// ULTIMATE ImGui Builder: arena allocation for element strings
+// See imgui_builder_arena.h
+
+#include "imgui_builder_arena.h"
+#include <string.h>
+#include <atomic>
+#include <utility>
+
+static const size_t STRING_POOL_BLOCK_SIZE = 64 * 1024;
+
+static ImU32 HashString(const char* str, size_t length) {
+    // FNV-1a
+    ImU32 hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)str[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static std::atomic<ImU32> g_LastPoolGeneration(0);
+
+static ImU32 NewPoolGeneration() {
+    return ++g_LastPoolGeneration;
+}
+
+StringPool::StringPool() : generation(NewPoolGeneration()) {
+}
+
+StringPool::~StringPool() {
+    Release();
+}
+
+char* StringPool::AllocString(size_t size) {
+    while (current_block < (int)blocks.size()) {
+        Block& block = blocks[current_block];
+        if (block.size - block.used >= size) {
+            char* str = block.data + block.used;
+            block.used += size;
+            return str;
+        }
+        // Keep filling the current block with small strings, move on only when it is almost full.
+        if (size <= STRING_POOL_BLOCK_SIZE / 4 || current_block + 1 < (int)blocks.size()) {
+            current_block++;
+        } else {
+            break;
+        }
+    }
+
+    Block block;
+    block.size = (size > STRING_POOL_BLOCK_SIZE / 4) ? size : STRING_POOL_BLOCK_SIZE;
+    block.data = (char*)IM_ALLOC(block.size);
+    block.used = size;
+    stats.block_allocs++;
+    stats.bytes_reserved += block.size;
+    if (current_block < (int)blocks.size()) {
+        // Oversized string: give it a dedicated block behind the current one, keep filling the current one.
+        blocks.insert(blocks.begin() + current_block, block);
+        current_block++;
+    } else {
+        blocks.push_back(block);
+        current_block = (int)blocks.size() - 1;
+    }
+    return block.data;
+}
+
+void StringPool::GrowTable() {
+    std::vector<Entry> old_table;
+    old_table.swap(table);
+    table.assign(old_table.empty() ? 1024 : old_table.size() * 2, Entry());
+    stats.table_allocs++;
+
+    const size_t mask = table.size() - 1;
+    for (const Entry& entry : old_table) {
+        if (!entry.str) {
+            continue;
+        }
+        size_t slot = entry.hash & mask;
+        while (table[slot].str) {
+            slot = (slot + 1) & mask;
+        }
+        table[slot] = entry;
+    }
+}
+
+const char* StringPool::Intern(const char* str, const char* str_end) {
+    const size_t length = str_end ? (size_t)(str_end - str) : strlen(str);
+    const ImU32 hash = HashString(str, length);
+    stats.intern_calls++;
+
+    if ((size_t)(stats.strings + 1) * 2 > table.size()) {
+        GrowTable();
+    }
+
+    const size_t mask = table.size() - 1;
+    size_t slot = hash & mask;
+    for (; table[slot].str; slot = (slot + 1) & mask) {
+        const Entry& entry = table[slot];
+        if (entry.hash == hash && entry.length == length && memcmp(entry.str, str, length) == 0) {
+            stats.intern_hits++;
+            return entry.str;
+        }
+    }
+
+    char* copy = AllocString(length + 1);
+    memcpy(copy, str, length);
+    copy[length] = 0;
+    table[slot].str = copy;
+    table[slot].hash = hash;
+    table[slot].length = (ImU32)length;
+    stats.strings++;
+    stats.bytes_used += length + 1;
+    return copy;
+}
+
+void StringPool::Reset() {
+    Unpin();
+    for (Block& block : blocks) {
+        block.used = 0;
+    }
+    current_block = 0;
+    external_storage.clear();
+    if (stats.strings > 0) {
+        memset(table.data(), 0, table.size() * sizeof(Entry));
+    }
+    stats.strings = 0;
+    stats.bytes_used = 0;
+    generation = NewPoolGeneration();
+}
+
+void StringPool::Release() {
+    Unpin();
+    for (Block& block : blocks) {
+        IM_FREE(block.data);
+    }
+    blocks.clear();
+    blocks.shrink_to_fit();
+    table.clear();
+    table.shrink_to_fit();
+    external_storage.clear();
+    current_block = 0;
+    stats.strings = 0;
+    stats.bytes_used = 0;
+    stats.bytes_reserved = 0;
+    generation = NewPoolGeneration();
+}
+
+void StringPool::Swap(StringPool& other) {
+    blocks.swap(other.blocks);
+    std::swap(current_block, other.current_block);
+    table.swap(other.table);
+    external_storage.swap(other.external_storage);
+    std::swap(stats, other.stats);
+    std::swap(generation, other.generation);
+    pin.swap(other.pin);
+}
+
+StringPool::Pinned::~Pinned() {
+    for (char* data : blocks) {
+        IM_FREE(data);
+    }
+}
+
+std::shared_ptr<const void> StringPool::Pin() const {
+    if (!pin) {
+        pin = std::make_shared<Pinned>();
+    }
+    return pin;
+}
+
+void StringPool::Share(const StringPool& source) {
+    Reset();
+    KeepAlive(source.Pin());
+    // Same strings, same addresses: caches keyed on the source strings stay valid for this pool
+    generation = source.generation;
+}
+
+void StringPool::Unpin() {
+    if (!pin) {
+        return;
+    }
+    // Still held by a reader: hand the blocks over, the pool starts again from new ones
+    if (pin.use_count() > 1) {
+        for (Block& block : blocks) {
+            pin->blocks.push_back(block.data);
+        }
+        for (std::shared_ptr<const void>& storage : external_storage) {
+            pin->external_storage.push_back(std::move(storage));
+        }
+        blocks.clear();
+        external_storage.clear();
+        current_block = 0;
+        stats.bytes_reserved = 0;
+    }
+    pin.reset();
+}
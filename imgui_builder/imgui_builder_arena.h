@@ -0,0 +1,86 @@
+// ULTIMATE ImGui Builder: arena allocation for element strings
+// Labels, text values and combo items are interned into a StringPool: identical strings share one copy,
+// storage is carved out of large blocks, and the whole pool is released (or recycled) at once.
+// Interned strings are immutable and stay valid until the pool is Reset(): editing a string interns a new one.
+// Strings may also point into external read-only memory (e.g. a memory-mapped project file) that the pool
+// keeps alive with KeepAlive(); those are not deduplicated against interned strings.
+
+#pragma once
+
+#include "imgui.h"
+#include <vector>
+#include <memory>
+
+struct StringPoolStats {
+    int block_allocs = 0;       // Heap allocations made for string blocks
+    int table_allocs = 0;       // Heap allocations made for the hash table
+    int strings = 0;            // Distinct strings currently interned
+    int intern_calls = 0;
+    int intern_hits = 0;        // Intern() calls answered with an existing copy
+    size_t bytes_used = 0;
+    size_t bytes_reserved = 0;
+};
+
+class StringPool {
+public:
+    StringPool();
+    ~StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Return the unique, zero-terminated copy of [str, str_end) (str_end = nullptr: up to the terminator).
+    // Two interned strings with the same content always have the same address.
+    const char* Intern(const char* str, const char* str_end = nullptr);
+
+    // Keep external string storage alive until the next Reset()/Release().
+    void KeepAlive(std::shared_ptr<const void> storage) { external_storage.push_back(std::move(storage)); }
+
+    // Forget every string but keep the blocks and the hash table for reuse: no heap traffic.
+    void Reset();
+    // Give all the memory back.
+    void Release();
+    void Swap(StringPool& other);
+
+    // Keep every string interned so far valid, whatever happens to the pool, until the returned pointer is released.
+    // Strings interned later in the same blocks are covered too, until the next Reset()/Release().
+    std::shared_ptr<const void> Pin() const;
+    // Replace the content with the strings of 'source', shared rather than copied (pinned): an immutable copy of a
+    // document only costs its element arrays. Interning into this pool afterwards makes copies of its own.
+    void Share(const StringPool& source);
+
+    const StringPoolStats& GetStats() const { return stats; }
+    // Changes whenever strings handed out so far may have been freed (Reset/Release). Unique across pools, so that
+    // a cache keyed on string addresses can tell that they no longer mean anything.
+    ImU32 GetGeneration() const { return generation; }
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+        size_t used;
+    };
+    struct Entry {
+        const char* str;    // nullptr = empty slot
+        ImU32 hash;
+        ImU32 length;
+    };
+
+    // Memory a Reset()/Release() gave up while pinned
+    struct Pinned {
+        std::vector<char*> blocks;
+        std::vector<std::shared_ptr<const void>> external_storage;
+        ~Pinned();
+    };
+
+    char* AllocString(size_t size);
+    void GrowTable();
+    void Unpin();
+
+    std::vector<Block> blocks;
+    int current_block = 0;
+    std::vector<Entry> table;       // Open addressing, power of two size, at most half full
+    std::vector<std::shared_ptr<const void>> external_storage;
+    StringPoolStats stats;
+    ImU32 generation;
+    mutable std::shared_ptr<Pinned> pin;
+};
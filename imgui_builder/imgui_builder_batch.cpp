@@ -0,0 +1,230 @@
+// ULTIMATE ImGui Builder: batch code generation
+// See imgui_builder_batch.h
+
+#include "imgui_builder_batch.h"
+#include "imgui_builder_json.h"
+#include "imgui_builder_project.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BATCH_CACHE_FORMAT      "imgui-builder-cache"
+#define BATCH_CACHE_VERSION     1
+
+ImU64 HashBytes(const void* data, size_t size, ImU64 hash) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static bool FileExists(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    fclose(f);
+    return true;
+}
+
+// Whole file into 'out'
+static bool ReadFile(const char* path, std::vector<char>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    out.clear();
+    char buffer[16 * 1024];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        out.insert(out.end(), buffer, buffer + read);
+    }
+    const bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+BatchCodeGenerator::BatchCodeGenerator(int thread_count) : pool(thread_count) {
+    for (int n = 0; n < pool.GetThreadCount(); n++) {
+        workers.emplace_back(new Worker());
+    }
+}
+
+bool BatchCodeGenerator::LoadCache(const char* path, std::string* error) {
+    cache.clear();
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return true;
+    }
+    // { "format": ..., "version": 1, "generator": N, "entries": [ { "output": "...", "hash": "<16 hex digits>" } ] }
+    // Anything else (older generator, unknown version) leaves the cache empty.
+    std::unique_ptr<JsonReader> reader(new JsonReader(f));
+    std::string key, output;
+    bool valid = true, ok = true;
+    int depth = 0;
+    ImU64 hash = 0;
+    for (JsonToken token = reader->Next(); token != JsonToken::End && ok; token = reader->Next()) {
+        switch (token) {
+        case JsonToken::Error:
+            ok = false;
+            break;
+        case JsonToken::ObjectBegin:
+            depth++;
+            output.clear();
+            hash = 0;
+            break;
+        case JsonToken::ObjectEnd:
+            if (depth-- == 2 && !output.empty() && hash != 0) {
+                cache[output] = hash;
+            }
+            break;
+        case JsonToken::Key:
+            key = reader->GetString();
+            break;
+        case JsonToken::String:
+            if (depth == 1 && key == "format") {
+                valid = valid && strcmp(reader->GetString(), BATCH_CACHE_FORMAT) == 0;
+            } else if (depth == 2 && key == "output") {
+                output = reader->GetString();
+            } else if (depth == 2 && key == "hash") {
+                hash = (ImU64)strtoull(reader->GetString(), nullptr, 16);
+            }
+            break;
+        case JsonToken::Number:
+            if (depth == 1 && key == "version") {
+                valid = valid && reader->GetNumber() == BATCH_CACHE_VERSION;
+            } else if (depth == 1 && key == "generator") {
+                valid = valid && reader->GetNumber() == CODE_GENERATOR_VERSION;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    fclose(f);
+    if (!ok) {
+        cache.clear();
+        if (error) {
+            *error = path;
+            *error += ": ";
+            *error += reader->GetError();
+        }
+        return false;
+    }
+    if (!valid) {
+        cache.clear();
+    }
+    return true;
+}
+
+bool BatchCodeGenerator::SaveCache(const char* path, std::string* error) const {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        if (error) {
+            *error = "Cannot open ";
+            *error += path;
+        }
+        return false;
+    }
+    bool ok;
+    {
+        std::unique_ptr<JsonWriter> writer(new JsonWriter(f));
+        writer->BeginObject();
+        writer->Key("format");
+        writer->String(BATCH_CACHE_FORMAT);
+        writer->Key("version");
+        writer->Int(BATCH_CACHE_VERSION);
+        writer->Key("generator");
+        writer->Int(CODE_GENERATOR_VERSION);
+        writer->Key("entries");
+        writer->BeginArray();
+        for (const auto& entry : cache) {
+            char hash[17];
+            snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)entry.second);
+            writer->BeginObject();
+            writer->Key("output");
+            writer->String(entry.first.c_str());
+            writer->Key("hash");
+            writer->String(hash);
+            writer->EndObject();
+        }
+        writer->EndArray();
+        writer->EndObject();
+        ok = writer->Flush();
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok && error) {
+        *error = "Cannot write ";
+        *error += path;
+    }
+    return ok;
+}
+
+void BatchCodeGenerator::RunProject(Worker& worker, const BatchProject& project, BatchResult& result) const {
+    result.status = BatchStatus_Failed;
+    result.hash = 0;
+    result.input_size = 0;
+    result.error.clear();
+    if (!ReadFile(project.input.c_str(), worker.file)) {
+        result.error = "Cannot read ";
+        result.error += project.input;
+        return;
+    }
+    // The output path is part of the hash: it names the generated header the source includes
+    const ImU32 version = CODE_GENERATOR_VERSION;
+    ImU64 hash = HashBytes(worker.file.data(), worker.file.size());
+    hash = HashBytes(project.output_base.c_str(), project.output_base.size() + 1, hash);
+    hash = HashBytes(&version, sizeof(version), hash);
+    result.hash = hash;
+    result.input_size = worker.file.size();
+
+    const std::string header_path = project.output_base + ".h";
+    const std::string source_path = project.output_base + ".cpp";
+    if (!force) {
+        const auto cached = cache.find(project.output_base);
+        if (cached != cache.end() && cached->second == hash && FileExists(header_path) && FileExists(source_path)) {
+            result.status = BatchStatus_Skipped;
+            return;
+        }
+    }
+
+    const char* name = nullptr;
+    if (!LoadProjectFile(worker.store, project.input.c_str(), &name, &result.error)) {
+        return;
+    }
+    // A cache holds on to the previous document's revisions: start from scratch for every project
+    worker.code.Clear();
+    if (!ExportDocumentCode(worker.code, worker.store, name, project.output_base.c_str(), &result.error)) {
+        return;
+    }
+    result.status = BatchStatus_Generated;
+}
+
+BatchStats BatchCodeGenerator::Run(const std::vector<BatchProject>& projects, std::vector<BatchResult>& results) {
+    results.clear();
+    results.resize(projects.size());
+    pool.ParallelFor((int)projects.size(), [&](int index, int thread) {
+        RunProject(*workers[thread], projects[index], results[index]);
+    });
+
+    BatchStats stats;
+    for (size_t n = 0; n < projects.size(); n++) {
+        const BatchResult& result = results[n];
+        switch (result.status) {
+        case BatchStatus_Generated:
+            stats.generated++;
+            cache[projects[n].output_base] = result.hash;
+            break;
+        case BatchStatus_Skipped:
+            stats.skipped++;
+            break;
+        default:
+            stats.failed++;
+            cache.erase(projects[n].output_base);
+            break;
+        }
+        stats.bytes_read += result.input_size;
+    }
+    return stats;
+}
@@ -0,0 +1,78 @@
+// ULTIMATE ImGui Builder: batch code generation
+// Generates the code of many project files at once, without a window or a Dear ImGui context (builder_cli).
+// Projects are spread over a ThreadPool, each thread loading into its own ElementStore and generating through its
+// own CodeCache, so the memory of one project is recycled for the next.
+// A project is skipped when its outputs exist and were generated from the same input: the cache maps each output
+// to a hash of the project file bytes, the output path and CODE_GENERATOR_VERSION.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_codegen.h"
+#include "imgui_builder_jobs.h"
+#include "imgui_builder_store.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct BatchProject {
+    std::string input;          // Project file, binary or JSON (see LoadProjectFile())
+    std::string output_base;    // Code goes to '<output_base>.h' and '<output_base>.cpp'
+};
+
+enum BatchStatus_ {
+    BatchStatus_Generated,
+    BatchStatus_Skipped,        // Unchanged since the outputs were generated
+    BatchStatus_Failed,
+};
+
+struct BatchResult {
+    int status = BatchStatus_Failed;
+    ImU64 hash = 0;             // Of the input, 0 if it could not be read
+    size_t input_size = 0;
+    std::string error;
+};
+
+struct BatchStats {
+    int generated = 0;
+    int skipped = 0;
+    int failed = 0;
+    size_t bytes_read = 0;      // Project files hashed
+};
+
+// 64-bit FNV-1a, continued from 'hash'
+ImU64 HashBytes(const void* data, size_t size, ImU64 hash = 0xCBF29CE484222325ull);
+
+class BatchCodeGenerator {
+public:
+    // 'thread_count' includes the calling thread. 0: one per hardware thread.
+    explicit BatchCodeGenerator(int thread_count = 0);
+
+    // Cache file written by SaveCache(). A missing file is an empty cache, not an error.
+    bool LoadCache(const char* path, std::string* error = nullptr);
+    bool SaveCache(const char* path, std::string* error = nullptr) const;
+    void ClearCache() { cache.clear(); }
+    // Regenerate projects even if the cache says they did not change
+    void SetForce(bool force) { this->force = force; }
+
+    // Generate every project, results[n] being the result of projects[n]. The cache is updated with the projects
+    // generated successfully.
+    BatchStats Run(const std::vector<BatchProject>& projects, std::vector<BatchResult>& results);
+
+    int GetThreadCount() const { return pool.GetThreadCount(); }
+
+private:
+    struct Worker {
+        ElementStore store;
+        CodeCache code;
+        std::vector<char> file;
+    };
+
+    void RunProject(Worker& worker, const BatchProject& project, BatchResult& result) const;
+
+    ThreadPool pool;
+    std::vector<std::unique_ptr<Worker>> workers;   // One per pool thread
+    std::unordered_map<std::string, ImU64> cache;   // Output base -> hash of what generated it
+    bool force = false;
+};
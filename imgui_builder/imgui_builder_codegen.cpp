@@ -0,0 +1,1124 @@
+// ULTIMATE ImGui Builder: C++ code generation
+// See imgui_builder_codegen.h
+
+#include "imgui_builder_codegen.h"
+#include "imgui_builder_components.h"
+#include "imgui_builder_fold.h"
+#include "imgui_builder_jobs.h"
+#include "imgui_builder_types.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// CodeBuffer
+//-----------------------------------------------------------------------------
+
+void CodeBuffer::Grow(size_t min_capacity) {
+    size_t capacity = data.empty() ? 4096 : data.size() * 2;
+    while (capacity < min_capacity) {
+        capacity *= 2;
+    }
+    data.resize(capacity);
+    alloc_count++;
+}
+
+const char* CodeBuffer::c_str() {
+    if (size == data.size()) {
+        Grow(size + 1);
+    }
+    data[size] = 0;
+    return data.data();
+}
+
+void CodeBuffer::Append(const char* str, size_t length) {
+    if (size + length > data.size()) {
+        Grow(size + length);
+    }
+    memcpy(data.data() + size, str, length);
+    size += length;
+}
+
+void CodeBuffer::Append(const char* str) {
+    Append(str, strlen(str));
+}
+
+void CodeBuffer::AppendIndent(int depth) {
+    static const char spaces[] = "                                                                ";
+    for (size_t count = (size_t)depth * 4; count > 0; ) {
+        const size_t n = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+        Append(spaces, n);
+        count -= n;
+    }
+}
+
+void CodeBuffer::AppendInt(int value) {
+    if (value < 0) {
+        AppendChar('-');
+    }
+    AppendUnsigned(value < 0 ? 0u - (unsigned int)value : (unsigned int)value);
+}
+
+void CodeBuffer::AppendUnsigned(ImU64 value) {
+    char buf[24];
+    char* p = buf + sizeof(buf);
+    do {
+        *--p = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    Append(p, (size_t)(buf + sizeof(buf) - p));
+}
+
+void CodeBuffer::AppendFloat(float value) {
+    if (value != value) {
+        value = 0.0f;
+    } else if (value > FLT_MAX) {
+        value = FLT_MAX;
+    } else if (value < -FLT_MAX) {
+        value = -FLT_MAX;
+    }
+    // Whole numbers (sizes, ranges, most colors) skip printf
+    if (value >= -1e7f && value <= 1e7f && value == (float)(int)value) {
+        if (value == 0.0f && signbit(value)) {
+            AppendChar('-');
+        }
+        AppendInt((int)value);
+        Append(".0f", 3);
+        return;
+    }
+    char buf[32];
+    int length = snprintf(buf, sizeof(buf), "%.6g", value);
+    if (strtof(buf, nullptr) != value) {
+        length = snprintf(buf, sizeof(buf), "%.9g", value);
+    }
+    Append(buf, (size_t)length);
+    if (!strpbrk(buf, ".e")) {
+        Append(".0", 2);
+    }
+    AppendChar('f');
+}
+
+void CodeBuffer::AppendStringLiteral(const char* str) {
+    AppendChar('"');
+    AppendEscaped(str);
+    AppendChar('"');
+}
+
+void CodeBuffer::AppendEscaped(const char* str) {
+    const char* run = str;
+    for (const char* p = str; *p; p++) {
+        const unsigned char c = (unsigned char)*p;
+        if (c >= 0x20 && c != '"' && c != '\\' && c != 0x7F) {
+            continue;
+        }
+        Append(run, (size_t)(p - run));
+        run = p + 1;
+        switch (c) {
+        case '"': Append("\\\"", 2); break;
+        case '\\': Append("\\\\", 2); break;
+        case '\n': Append("\\n", 2); break;
+        case '\r': Append("\\r", 2); break;
+        case '\t': Append("\\t", 2); break;
+        default: {
+            // Octal escapes stop after 3 digits, whatever follows
+            const char escape[4] = { '\\', (char)('0' + (c >> 6)), (char)('0' + ((c >> 3) & 7)), (char)('0' + (c & 7)) };
+            Append(escape, 4);
+            break;
+        }
+        }
+    }
+    Append(run, strlen(run));
+}
+
+char* CodeBuffer::Extend(size_t length) {
+    if (size + length > data.size()) {
+        Grow(size + length);
+    }
+    char* str = data.data() + size;
+    size += length;
+    return str;
+}
+
+//-----------------------------------------------------------------------------
+// Generator
+//-----------------------------------------------------------------------------
+
+static const int MAX_VARIABLE_LABEL_LENGTH = 24;
+
+static const size_t NO_OFFSET = (size_t)-1;
+
+struct CodeGenerator {
+    const ElementStore& store;
+    CodeBuffer& out;
+    const ComponentTable* components = nullptr;     // Resolves instances (nullptr: the document has none)
+    CodeBuffer* state = nullptr;                    // Generating a component: members of the state of its instances
+    size_t static_begin = 0;                        // Where the last BeginStatic() started
+    char variable[64];
+
+    // Incremental generation: clean children are copied from the previous output of the cache.
+    // Spans are relative to the parent's begin, so a copied subtree keeps its own spans valid.
+    CodeCache* cache = nullptr;
+    const char* previous = nullptr;
+    ElementIndex current_parent = ElementIndex_None;
+    size_t parent_begin = 0;                // In 'out'
+    size_t parent_old_begin = NO_OFFSET;    // In 'previous', NO_OFFSET when the parent was not in it
+
+    CodeGenerator(const ElementStore& s, CodeBuffer& o) : store(s), out(o) {}
+
+    // "Volume (dB)" -> "volume_db_12": lowercase label characters valid in an identifier, plus the element uid
+    const char* MakeVariable(ElementIndex element) {
+        int length = 0;
+        bool separator = false;
+        for (const char* p = store.strings[element].label; *p && length < MAX_VARIABLE_LABEL_LENGTH; p++) {
+            char c = *p;
+            if (c == '#' && p[1] == '#') {
+                break;
+            }
+            if (c >= 'A' && c <= 'Z') {
+                c = (char)(c - 'A' + 'a');
+            }
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                if (separator && length > 0) {
+                    variable[length++] = '_';
+                }
+                if (length == 0 && c <= '9') {
+                    variable[length++] = 'v';
+                    variable[length++] = '_';
+                }
+                variable[length++] = c;
+                separator = false;
+            } else {
+                separator = true;
+            }
+        }
+        if (length == 0) {
+            memcpy(variable, "element", 7);
+            length = 7;
+        }
+        char digits[24];
+        char* p = digits + sizeof(digits);
+        for (ElementUid n = store.uids[element]; p == digits + sizeof(digits) || n != 0; n /= 10) {
+            *--p = (char)('0' + n % 10);
+        }
+        variable[length++] = '_';
+        while (p < digits + sizeof(digits)) {
+            variable[length++] = *p++;
+        }
+        variable[length] = 0;
+        return variable;
+    }
+
+    // "Component_settings_row_5": the function drawing a component
+    void ComponentFunction(ElementIndex component) {
+        out.Append("Component_");
+        out.Append(MakeVariable(component));
+    }
+
+    // "ComponentState_settings_row_5": what one instance of it keeps
+    void ComponentState(CodeBuffer& to, ElementIndex component) {
+        to.Append("ComponentState_");
+        to.Append(MakeVariable(component));
+    }
+
+    // The state struct then the function, written once: every instance calls it with a state of its own. The
+    // statics of the elements become members of the struct, the body refers to those of the instance drawn.
+    void ComponentDefinition(ElementIndex component) {
+        CodeBuffer members, body;
+        CodeGenerator generator(store, body);
+        generator.components = components;
+        generator.state = &members;
+        generator.Children(component, 1);
+
+        out.Append("// Component ");
+        out.AppendStringLiteral(store.strings[component].label);
+        out.Append("\nstruct ");
+        ComponentState(out, component);
+        out.Append(" {\n");
+        out.Append(members.Begin(), members.Size());
+        out.Append("};\n\nstatic void ");
+        ComponentFunction(component);
+        out.AppendChar('(');
+        ComponentState(out, component);
+        out.Append(members.Empty() ? "*) {\n" : "* state) {\n");
+        out.Append(body.Begin(), body.Size());
+        out.Append("}\n");
+    }
+
+    void Line(int depth, const char* text) {
+        out.AppendIndent(depth);
+        out.Append(text);
+        out.AppendChar('\n');
+    }
+
+    void Vec2(const ImVec2& v) {
+        out.Append("ImVec2(", 7);
+        out.AppendFloat(v.x);
+        out.Append(", ", 2);
+        out.AppendFloat(v.y);
+        out.AppendChar(')');
+    }
+
+    void Vec4(const ImVec4& v) {
+        out.Append("ImVec4(", 7);
+        out.AppendFloat(v.x);
+        out.Append(", ", 2);
+        out.AppendFloat(v.y);
+        out.Append(", ", 2);
+        out.AppendFloat(v.z);
+        out.Append(", ", 2);
+        out.AppendFloat(v.w);
+        out.AppendChar(')');
+    }
+
+    void PushStyleColor(int depth, ImGuiCol idx, const ImVec4& color) {
+        out.AppendIndent(depth);
+        out.Append("ImGui::PushStyleColor(ImGuiCol_");
+        out.Append(ImGui::GetStyleColorName(idx));
+        out.Append(", ", 2);
+        Vec4(color);
+        out.Append(");\n");
+    }
+
+    // "static <type> <name> = " ... the caller writes the initializer, then calls EndStatic() if it is widget state
+    void BeginStatic(int depth, const char* type, const char* name, const char* suffix = "") {
+        static_begin = out.Size();
+        out.AppendIndent(depth);
+        out.Append("static ");
+        out.Append(type);
+        out.AppendChar(' ');
+        out.Append(name);
+        out.Append(suffix);
+        out.Append(" = ", 3);
+    }
+
+    // In a component, the state of each instance: the declaration moves into the state struct, without "static",
+    // and a reference to the member of the instance drawn takes its place
+    void EndStatic(int depth, const char* name) {
+        if (!state) {
+            return;
+        }
+        const size_t declaration = static_begin + (size_t)depth * 4 + 7;
+        state->AppendIndent(1);
+        state->Append(out.Begin() + declaration, out.Size() - declaration);
+        out.Truncate(static_begin);
+        out.AppendIndent(depth);
+        out.Append("auto& ");
+        out.Append(name);
+        out.Append(" = state->");
+        out.Append(name);
+        out.Append(";\n");
+    }
+
+    // "Volume##12": the label shown, the uid keeps the ImGui ID unique
+    void Label(ElementIndex element) {
+        out.AppendChar('"');
+        out.AppendEscaped(store.strings[element].label);
+        out.Append("##", 2);
+        out.AppendUnsigned(store.uids[element]);
+        out.AppendChar('"');
+    }
+
+    // "<call>(<label>" ... the caller writes the remaining arguments
+    void BeginCall(int depth, const char* call, ElementIndex element) {
+        out.AppendIndent(depth);
+        out.Append(call);
+        out.AppendChar('(');
+        Label(element);
+    }
+
+    // "<call>("<text>"" ... the caller writes the remaining arguments
+    void BeginCall(int depth, const char* call, const char* text) {
+        out.AppendIndent(depth);
+        out.Append(call);
+        out.AppendChar('(');
+        out.AppendStringLiteral(text);
+    }
+
+    void BeginVariableCall(int depth, const char* call, ElementIndex element, const char* name) {
+        BeginCall(depth, call, element);
+        out.Append(", &", 3);
+        out.Append(name);
+    }
+
+    // "static float <name> = <value>;" and its name
+    const char* FloatStatic(int depth, ElementIndex element) {
+        const char* name = MakeVariable(element);
+        BeginStatic(depth, "float", name);
+        out.AppendFloat(store.GetFloat(element));
+        out.Append(";\n");
+        EndStatic(depth, name);
+        return name;
+    }
+
+    const char* IntStatic(int depth, ElementIndex element) {
+        const char* name = MakeVariable(element);
+        BeginStatic(depth, "int", name);
+        out.AppendInt(store.GetInt(element));
+        out.Append(";\n");
+        EndStatic(depth, name);
+        return name;
+    }
+
+    // Checkbox, Selectable
+    void BoolWidget(int depth, const char* call, ElementIndex element) {
+        const char* name = MakeVariable(element);
+        BeginStatic(depth, "bool", name);
+        out.Append((store.flags[element] & ElementFlags_BoolValue) ? "true;\n" : "false;\n");
+        EndStatic(depth, name);
+        BeginVariableCall(depth, call, element, name);
+        out.Append(");\n");
+    }
+
+    // Combo, ListBox
+    void ItemsWidget(int depth, const char* call, ElementIndex element) {
+        const char* name = MakeVariable(element);
+        const char* const* items = store.GetItems(element);
+        const int items_count = store.GetItemCount(element);
+        if (items_count > 0) {
+            BeginStatic(depth, "const char* const", name, "_items[]");
+            out.Append("{ ", 2);
+            for (int n = 0; n < items_count; n++) {
+                if (n > 0) {
+                    out.Append(", ", 2);
+                }
+                out.AppendStringLiteral(items[n]);
+            }
+            out.Append(" };\n");
+        }
+        BeginStatic(depth, "int", name);
+        out.AppendInt(store.GetItemList(element).selected_item);
+        out.Append(";\n");
+        EndStatic(depth, name);
+        BeginVariableCall(depth, call, element, name);
+        if (items_count > 0) {
+            out.Append(", ", 2);
+            out.Append(name);
+            out.Append("_items, IM_ARRAYSIZE(");
+            out.Append(name);
+            out.Append("_items));\n");
+        } else {
+            out.Append(", nullptr, 0);\n");
+        }
+    }
+
+    // PlotLines, PlotHistogram
+    void PlotWidget(int depth, const char* call, ElementIndex element) {
+        const ElementRange& range = store.GetRange(element);
+        const char* name = MakeVariable(element);
+        Line(depth, "// Fill with the values to plot");
+        BeginStatic(depth, "float", name, "[32]");
+        out.Append("{};\n");
+        EndStatic(depth, name);
+        BeginCall(depth, call, element);
+        out.Append(", ", 2);
+        out.Append(name);
+        out.Append(", IM_ARRAYSIZE(");
+        out.Append(name);
+        out.Append("), 0, nullptr, ");
+        out.AppendFloat(range.min_value);
+        out.Append(", ", 2);
+        out.AppendFloat(range.max_value);
+        out.Append(", ", 2);
+        Vec2(store.styles[element].size);
+        out.Append(");\n");
+    }
+
+    // "if (<call>(<label>)) {" children, then the end call if any and "}"
+    void Block(int depth, const char* call, ElementIndex element, const char* end) {
+        BeginCall(depth, call, element);
+        out.Append(")) {\n");
+        Children(element, depth + 1);
+        if (end) {
+            Line(depth + 1, end);
+        }
+        Line(depth, "}");
+    }
+
+    void Children(ElementIndex element, int depth) {
+        for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+            Child(child, depth);
+        }
+    }
+
+    // Element() through the cache: copy the previous output of an unchanged subtree, generate the others
+    void Child(ElementIndex child, int depth) {
+        if (!cache) {
+            Element(child, depth);
+            return;
+        }
+        CodeCache::Span& span = cache->spans[child];
+        const size_t begin = out.Size();
+        // Siblings decide some of the calls (see imgui_builder_fold.h): they may change without the revision
+        const ElementCalls calls = GetElementCalls(store, child);
+        const bool same_place = span.revision != 0 && span.parent == current_parent && span.depth == depth && parent_old_begin != NO_OFFSET;
+        if (same_place && span.revision == store.revisions[child] && span.calls == calls) {
+            out.Append(previous + parent_old_begin + span.begin, span.length);
+            cache->reused_count++;
+        } else {
+            const ElementIndex saved_parent = current_parent;
+            const size_t saved_begin = parent_begin;
+            const size_t saved_old_begin = parent_old_begin;
+            current_parent = child;
+            parent_begin = begin;
+            // Hidden elements leave no output: their children were not in the previous output either
+            parent_old_begin = (same_place && span.length > 0) ? saved_old_begin + span.begin : NO_OFFSET;
+            Element(child, depth);
+            current_parent = saved_parent;
+            parent_begin = saved_begin;
+            parent_old_begin = saved_old_begin;
+            cache->generated_count++;
+        }
+        span.revision = store.revisions[child];
+        span.calls = calls;
+        span.parent = current_parent;
+        span.depth = depth;
+        span.begin = begin - parent_begin;
+        span.length = out.Size() - begin;
+    }
+
+    int ChildCount(ElementIndex element) const {
+        int count = 0;
+        for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+            count++;
+        }
+        return count;
+    }
+
+    // Statement code for one element and its subtree, at indentation 'depth'
+    void Element(ElementIndex element, int depth) {
+        // Hidden, a component definition (drawn by its instances) or folded away
+        const ElementCalls calls = GetElementCalls(store, element);
+        if (!(calls & ElementCalls_Draw)) {
+            return;
+        }
+        const ElementType type = store.types[element];
+        const ElementStyle& style = store.styles[element];
+
+        if (calls & ElementCalls_BeginDisabled) {
+            Line(depth, "ImGui::BeginDisabled();");
+        }
+        // Scopes shared with the next siblings are opened by the first one of the run, closed by the last one
+        if ((calls & ElementCalls_PushColors) && (calls & ElementCalls_TextColor)) {
+            PushStyleColor(depth, ImGuiCol_Text, style.text_color);
+        }
+        if ((calls & ElementCalls_PushColors) && (calls & ElementCalls_BgColor)) {
+            PushStyleColor(depth, GetElementTypeInfo(type).background, style.bg_color);
+        }
+        if (calls & ElementCalls_PushItemWidth) {
+            out.AppendIndent(depth);
+            out.Append("ImGui::PushItemWidth(");
+            out.AppendFloat(style.size.x);
+            out.Append(");\n");
+        }
+
+        // Containers draw their children themselves, the children of other elements simply follow them
+        GetElementTypeInfo(type).emit(*this, element, depth);
+        if (!HasTypeFlags(type, ElementTypeFlags_Container)) {
+            Children(element, depth);
+        }
+
+        if (calls & ElementCalls_PopItemWidth) {
+            Line(depth, "ImGui::PopItemWidth();");
+        }
+        if (calls & ElementCalls_PopColors) {
+            Line(depth, GetColorCount(calls) > 1 ? "ImGui::PopStyleColor(2);" : "ImGui::PopStyleColor();");
+        }
+        if (calls & ElementCalls_EndDisabled) {
+            Line(depth, "ImGui::EndDisabled();");
+        }
+    }
+};
+
+// Per-type code, the emit hooks of the element type table
+
+void ElementTraits<ElementType::BUTTON>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const ElementStyle& style = generator.store.styles[element];
+    generator.BeginCall(depth, "if (ImGui::Button", element);
+    if (style.size.x != 0 || style.size.y != 0) {
+        generator.out.Append(", ", 2);
+        generator.Vec2(style.size);
+    }
+    generator.out.Append(")) {\n");
+    generator.Line(depth + 1, "// Button clicked");
+    generator.Line(depth, "}");
+}
+
+void ElementTraits<ElementType::CHECKBOX>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.BoolWidget(depth, "ImGui::Checkbox", element);
+}
+
+void ElementTraits<ElementType::SLIDER_FLOAT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const ElementRange& range = generator.store.GetRange(element);
+    const char* name = generator.FloatStatic(depth, element);
+    generator.BeginVariableCall(depth, "ImGui::SliderFloat", element, name);
+    generator.out.Append(", ", 2);
+    generator.out.AppendFloat(range.min_value);
+    generator.out.Append(", ", 2);
+    generator.out.AppendFloat(range.max_value);
+    generator.out.Append(");\n");
+}
+
+void ElementTraits<ElementType::SLIDER_INT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const ElementRange& range = generator.store.GetRange(element);
+    const char* name = generator.IntStatic(depth, element);
+    generator.BeginVariableCall(depth, "ImGui::SliderInt", element, name);
+    generator.out.Append(", ", 2);
+    generator.out.AppendInt((int)range.min_value);
+    generator.out.Append(", ", 2);
+    generator.out.AppendInt((int)range.max_value);
+    generator.out.Append(");\n");
+}
+
+void ElementTraits<ElementType::INPUT_TEXT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const char* text = generator.store.strings[element].text_value;
+    size_t capacity = 256;
+    while (capacity <= strlen(text)) {
+        capacity *= 2;
+    }
+    const char* name = generator.MakeVariable(element);
+    char size[24];
+    snprintf(size, sizeof(size), "[%d]", (int)capacity);
+    generator.BeginStatic(depth, "char", name, size);
+    generator.out.AppendStringLiteral(text);
+    generator.out.Append(";\n");
+    generator.EndStatic(depth, name);
+    generator.BeginCall(depth, "ImGui::InputText", element);
+    generator.out.Append(", ", 2);
+    generator.out.Append(name);
+    generator.out.Append(", IM_ARRAYSIZE(");
+    generator.out.Append(name);
+    generator.out.Append("));\n");
+}
+
+void ElementTraits<ElementType::INPUT_INT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const char* name = generator.IntStatic(depth, element);
+    generator.BeginVariableCall(depth, "ImGui::InputInt", element, name);
+    generator.out.Append(");\n");
+}
+
+void ElementTraits<ElementType::INPUT_FLOAT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const char* name = generator.FloatStatic(depth, element);
+    generator.BeginVariableCall(depth, "ImGui::InputFloat", element, name);
+    generator.out.Append(");\n");
+}
+
+void ElementTraits<ElementType::COMBO>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.ItemsWidget(depth, "ImGui::Combo", element);
+}
+
+void ElementTraits<ElementType::LISTBOX>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.ItemsWidget(depth, "ImGui::ListBox", element);
+}
+
+void ElementTraits<ElementType::COLOR_PICKER>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    CodeBuffer& out = generator.out;
+    const ImVec4& color = generator.store.GetColor(element);
+    const char* name = generator.MakeVariable(element);
+    generator.BeginStatic(depth, "float", name, "[4]");
+    out.Append("{ ", 2);
+    out.AppendFloat(color.x);
+    out.Append(", ", 2);
+    out.AppendFloat(color.y);
+    out.Append(", ", 2);
+    out.AppendFloat(color.z);
+    out.Append(", ", 2);
+    out.AppendFloat(color.w);
+    out.Append(" };\n");
+    generator.EndStatic(depth, name);
+    generator.BeginCall(depth, "ImGui::ColorEdit4", element);
+    out.Append(", ", 2);
+    out.Append(name);
+    out.Append(");\n");
+}
+
+void ElementTraits<ElementType::SEPARATOR>::Emit(CodeGenerator& generator, ElementIndex, int depth) {
+    generator.Line(depth, "ImGui::Separator();");
+}
+
+void ElementTraits<ElementType::TEXT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.BeginCall(depth, "ImGui::TextUnformatted", generator.store.strings[element].text_value);
+    generator.out.Append(");\n");
+}
+
+void ElementTraits<ElementType::BULLET_TEXT>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.out.AppendIndent(depth);
+    generator.out.Append("ImGui::BulletText(\"%s\", ");
+    generator.out.AppendStringLiteral(generator.store.strings[element].text_value);
+    generator.out.Append(");\n");
+}
+
+void ElementTraits<ElementType::TREE_NODE>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.Block(depth, "if (ImGui::TreeNode", element, "ImGui::TreePop();");
+}
+
+void ElementTraits<ElementType::COLLAPSING_HEADER>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.Block(depth, "if (ImGui::CollapsingHeader", element, nullptr);
+}
+
+void ElementTraits<ElementType::TAB_BAR>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.Block(depth, "if (ImGui::BeginTabBar", element, "ImGui::EndTabBar();");
+}
+
+void ElementTraits<ElementType::TAB_ITEM>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.Block(depth, "if (ImGui::BeginTabItem", element, "ImGui::EndTabItem();");
+}
+
+void ElementTraits<ElementType::MENU_BAR>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.Line(depth, "if (ImGui::BeginMenuBar()) {");
+    generator.Children(element, depth + 1);
+    generator.Line(depth + 1, "ImGui::EndMenuBar();");
+    generator.Line(depth, "}");
+}
+
+void ElementTraits<ElementType::MENU_ITEM>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    // A menu item with children is a sub-menu
+    if (generator.store.FirstChild(element) != ElementIndex_None) {
+        generator.Block(depth, "if (ImGui::BeginMenu", element, "ImGui::EndMenu();");
+        return;
+    }
+    generator.BeginCall(depth, "if (ImGui::MenuItem", element);
+    generator.out.Append(")) {\n");
+    generator.Line(depth + 1, "// Menu item clicked");
+    generator.Line(depth, "}");
+}
+
+void ElementTraits<ElementType::POPUP>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.BeginCall(depth, "if (ImGui::Button", element);
+    generator.out.Append(")) {\n");
+    generator.BeginCall(depth + 1, "ImGui::OpenPopup", element);
+    generator.out.Append(");\n");
+    generator.Line(depth, "}");
+    generator.Block(depth, "if (ImGui::BeginPopup", element, "ImGui::EndPopup();");
+}
+
+void ElementTraits<ElementType::TOOLTIP>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    // Tooltip of the previous item
+    const char* text = generator.store.strings[element].text_value;
+    generator.Line(depth, "if (ImGui::BeginItemTooltip()) {");
+    if (text[0]) {
+        generator.BeginCall(depth + 1, "ImGui::TextUnformatted", text);
+        generator.out.Append(");\n");
+    }
+    generator.Children(element, depth + 1);
+    generator.Line(depth + 1, "ImGui::EndTooltip();");
+    generator.Line(depth, "}");
+}
+
+void ElementTraits<ElementType::PROGRESS_BAR>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    CodeBuffer& out = generator.out;
+    out.AppendIndent(depth);
+    out.Append("ImGui::ProgressBar(");
+    out.AppendFloat(generator.store.GetFloat(element));
+    out.Append(", ", 2);
+    generator.Vec2(generator.store.styles[element].size);
+    out.Append(", ", 2);
+    out.AppendStringLiteral(generator.store.strings[element].label);
+    out.Append(");\n");
+}
+
+void ElementTraits<ElementType::IMAGE_BUTTON>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    CodeBuffer& out = generator.out;
+    const ImVec2& size = generator.store.styles[element].size;
+    const char* name = generator.MakeVariable(element);
+    generator.Line(depth, "// Bind a texture before drawing");
+    generator.BeginStatic(depth, "ImTextureID", name, "_texture");
+    out.Append("0;\n");
+    generator.BeginCall(depth, "if (ImGui::ImageButton", element);
+    out.Append(", ", 2);
+    out.Append(name);
+    out.Append("_texture, ");
+    generator.Vec2((size.x > 0 && size.y > 0) ? size : ImVec2(32.0f, 32.0f));
+    out.Append(")) {\n");
+    generator.Line(depth + 1, "// Image button clicked");
+    generator.Line(depth, "}");
+}
+
+void ElementTraits<ElementType::RADIO_BUTTON>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const char* name = generator.IntStatic(depth, element);
+    generator.BeginVariableCall(depth, "ImGui::RadioButton", element, name);
+    generator.out.Append(", 1);\n");
+}
+
+void ElementTraits<ElementType::SELECTABLE>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.BoolWidget(depth, "ImGui::Selectable", element);
+}
+
+void ElementTraits<ElementType::SPACING>::Emit(CodeGenerator& generator, ElementIndex, int depth) {
+    generator.Line(depth, "ImGui::Spacing();");
+}
+
+void ElementTraits<ElementType::SAME_LINE>::Emit(CodeGenerator& generator, ElementIndex, int depth) {
+    generator.Line(depth, "ImGui::SameLine();");
+}
+
+void ElementTraits<ElementType::NEW_LINE>::Emit(CodeGenerator& generator, ElementIndex, int depth) {
+    generator.Line(depth, "ImGui::NewLine();");
+}
+
+void ElementTraits<ElementType::INDENT>::Emit(CodeGenerator& generator, ElementIndex, int depth) {
+    generator.Line(depth, "ImGui::Indent();");
+}
+
+void ElementTraits<ElementType::UNINDENT>::Emit(CodeGenerator& generator, ElementIndex, int depth) {
+    generator.Line(depth, "ImGui::Unindent();");
+}
+
+void ElementTraits<ElementType::GROUP>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.Line(depth, "ImGui::BeginGroup();");
+    generator.Children(element, depth);
+    generator.Line(depth, "ImGui::EndGroup();");
+}
+
+void ElementTraits<ElementType::CHILD_WINDOW>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.BeginCall(depth, "if (ImGui::BeginChild", element);
+    generator.out.Append(", ", 2);
+    generator.Vec2(generator.store.styles[element].size);
+    generator.out.Append(", true)) {\n");
+    generator.Children(element, depth + 1);
+    generator.Line(depth, "}");
+    generator.Line(depth, "ImGui::EndChild();");
+}
+
+void ElementTraits<ElementType::COLUMNS>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const ElementStore& store = generator.store;
+    // One column per child unless a count was set
+    int columns = store.GetInt(element) > 0 ? store.GetInt(element) : generator.ChildCount(element);
+    columns = columns < 1 ? 1 : columns > 64 ? 64 : columns;
+    generator.out.AppendIndent(depth);
+    generator.out.Append("ImGui::Columns(");
+    generator.out.AppendInt(columns);
+    generator.out.Append(", ", 2);
+    generator.Label(element);
+    generator.out.Append(");\n");
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        generator.Child(child, depth);
+        generator.Line(depth, "ImGui::NextColumn();");
+    }
+    generator.Line(depth, "ImGui::Columns(1);");
+}
+
+void ElementTraits<ElementType::TABLE>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    const ElementStore& store = generator.store;
+    int columns = store.GetInt(element) > 0 ? store.GetInt(element) : generator.ChildCount(element);
+    columns = columns < 1 ? 1 : columns > 512 ? 512 : columns;
+    generator.BeginCall(depth, "if (ImGui::BeginTable", element);
+    generator.out.Append(", ", 2);
+    generator.out.AppendInt(columns);
+    generator.out.Append(")) {\n");
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        generator.Line(depth + 1, "ImGui::TableNextColumn();");
+        generator.Child(child, depth + 1);
+    }
+    generator.Line(depth + 1, "ImGui::EndTable();");
+    generator.Line(depth, "}");
+}
+
+void ElementTraits<ElementType::PLOT_LINES>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.PlotWidget(depth, "ImGui::PlotLines", element);
+}
+
+void ElementTraits<ElementType::PLOT_HISTOGRAM>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    generator.PlotWidget(depth, "ImGui::PlotHistogram", element);
+}
+
+void ElementTraits<ElementType::INSTANCE>::Emit(CodeGenerator& generator, ElementIndex element, int depth) {
+    CodeBuffer& out = generator.out;
+    const ElementStore& store = generator.store;
+    const char* name = store.strings[element].text_value;
+    const ElementIndex component = generator.components ? generator.components->Find(name) : ElementIndex_None;
+    if (component == ElementIndex_None) {
+        out.AppendIndent(depth);
+        out.Append("// No component ");
+        out.AppendStringLiteral(name);
+        out.AppendChar('\n');
+        return;
+    }
+    out.AppendIndent(depth);
+    out.Append("ImGui::PushID(");
+    out.AppendInt((int)store.uids[element]);
+    out.Append(");\n");
+    // Its state: a static, or inside a component a member of the state of the enclosing instance
+    CodeBuffer* state = generator.state;
+    CodeBuffer& declaration = state ? *state : out;
+    declaration.AppendIndent(state ? 1 : depth);
+    if (!state) {
+        declaration.Append("static ");
+    }
+    generator.ComponentState(declaration, component);
+    declaration.AppendChar(' ');
+    declaration.Append(generator.MakeVariable(element));
+    declaration.Append(";\n");
+    out.AppendIndent(depth);
+    generator.ComponentFunction(component);
+    out.Append(state ? "(&state->" : "(&");
+    out.Append(generator.MakeVariable(element));
+    out.Append(");\n");
+    generator.Line(depth, "ImGui::PopID();");
+}
+
+void GenerateElementCode(const ElementStore& store, ElementIndex element, CodeBuffer& out) {
+    out.Clear();
+    ComponentTable components;
+    components.Build(store);
+    CodeGenerator generator(store, out);
+    generator.components = &components;
+    if (store.types[element] == ElementType::COMPONENT) {
+        generator.ComponentDefinition(element);
+    } else {
+        generator.Element(element, 0);
+    }
+}
+
+// "My Menu" -> "RenderMyMenu"
+static void AppendFunctionName(CodeBuffer& out, const char* menu_name) {
+    out.Append("Render");
+    bool upper = true;
+    for (const char* p = menu_name; *p; p++) {
+        const char c = *p;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+            out.AppendChar((upper && c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c);
+            upper = false;
+        } else {
+            upper = true;
+        }
+    }
+}
+
+static void GenerateHeader(const char* menu_name, CodeBuffer& header) {
+    header.Clear();
+    header.Append("// Generated by ULTIMATE ImGui Builder: ");
+    header.AppendStringLiteral(menu_name);
+    header.Append("\n\n#pragma once\n\n// Draw the window. 'p_open' (optional) is cleared when the window is closed.\nvoid ");
+    AppendFunctionName(header, menu_name);
+    header.Append("(bool* p_open = nullptr);\n");
+}
+
+// Instances found in the subtree of 'element' need their component defined first: its state is a member of theirs.
+// Usable components do not draw themselves, so this ends.
+static void DefineUsedComponents(CodeGenerator& generator, const ComponentTable& components, ElementIndex element, std::vector<unsigned char>& defined);
+
+static void DefineComponent(CodeGenerator& generator, const ComponentTable& components, ElementIndex component, std::vector<unsigned char>& defined) {
+    if (defined[component]) {
+        return;
+    }
+    defined[component] = 1;
+    DefineUsedComponents(generator, components, component, defined);
+    generator.out.AppendChar('\n');
+    generator.ComponentDefinition(component);
+}
+
+static void DefineUsedComponents(CodeGenerator& generator, const ComponentTable& components, ElementIndex element, std::vector<unsigned char>& defined) {
+    const ElementStore& store = generator.store;
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        if (store.types[child] == ElementType::INSTANCE) {
+            const ElementIndex used = components.Find(store.strings[child].text_value);
+            if (used != ElementIndex_None) {
+                DefineComponent(generator, components, used, defined);
+            }
+        }
+        DefineUsedComponents(generator, components, child, defined);
+    }
+}
+
+// Everything up to the first element: the components are defined before the window function, each after those it uses
+static void GenerateSourceBegin(const ElementStore& store, const ComponentTable& components, const char* menu_name, const char* header_name, CodeBuffer& source) {
+    // A menu bar at the top level needs the window flag
+    bool menu_bar = false;
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        menu_bar |= store.types[root] == ElementType::MENU_BAR && (store.flags[root] & ElementFlags_Visible);
+    }
+
+    source.Clear();
+    source.Append("// Generated by ULTIMATE ImGui Builder: ");
+    source.AppendStringLiteral(menu_name);
+    source.Append("\n\n#include \"imgui.h\"\n#include ");
+    source.AppendStringLiteral(header_name);
+    source.AppendChar('\n');
+    if (components.GetCount() > 0) {
+        CodeGenerator generator(store, source);
+        generator.components = &components;
+        std::vector<unsigned char> defined(store.types.size(), 0);
+        for (int n = 0; n < components.GetCount(); n++) {
+            if (components.IsUsable(n)) {
+                DefineComponent(generator, components, components.Get(n), defined);
+            }
+        }
+    }
+    source.Append("\nvoid ");
+    AppendFunctionName(source, menu_name);
+    source.Append("(bool* p_open) {\n    if (ImGui::Begin(");
+    source.AppendStringLiteral(menu_name);
+    source.Append(menu_bar ? ", p_open, ImGuiWindowFlags_MenuBar)) {\n" : ", p_open)) {\n");
+}
+
+static void GenerateSourceEnd(CodeBuffer& source) {
+    source.Append("    }\n    ImGui::End();\n}\n");
+}
+
+void GenerateDocumentCode(const ElementStore& store, const char* menu_name, const char* header_name, CodeBuffer& header, CodeBuffer& source) {
+    ComponentTable components;
+    components.Build(store);
+    GenerateHeader(menu_name, header);
+    GenerateSourceBegin(store, components, menu_name, header_name, source);
+    CodeGenerator generator(store, source);
+    generator.components = &components;
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        generator.Element(root, 2);
+    }
+    GenerateSourceEnd(source);
+}
+
+//-----------------------------------------------------------------------------
+// CodeCache
+//-----------------------------------------------------------------------------
+
+void CodeCache::GenerateDocument(const ElementStore& store, const char* menu_name, const char* header_name) {
+    if (spans.size() < store.types.size()) {
+        spans.resize(store.types.size());
+    }
+    const int previous_index = current;
+    current ^= 1;
+    const CodeBuffer& previous = sources[previous_index];
+    CodeBuffer& source = sources[current];
+
+    // Instances only name their component: when what names resolve to changed, none of the previous output is reused
+    components.Build(store);
+    const bool components_changed = components.GetSignature() != components_signature;
+    components_signature = components.GetSignature();
+
+    GenerateHeader(menu_name, header);
+    GenerateSourceBegin(store, components, menu_name, header_name, source);
+    const size_t previous_body_begin = body_begin;
+    body_begin = source.Size();
+
+    generated_count = 0;
+    reused_count = 0;
+    CodeGenerator generator(store, source);
+    generator.components = &components;
+    generator.cache = this;
+    generator.previous = previous.Begin();
+    generator.parent_begin = body_begin;
+    generator.parent_old_begin = (previous.Empty() || components_changed) ? NO_OFFSET : previous_body_begin;
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        generator.Child(root, 2);
+    }
+    GenerateSourceEnd(source);
+}
+
+void CodeCache::Clear() {
+    spans.clear();
+    header.Clear();
+    sources[0].Clear();
+    sources[1].Clear();
+    body_begin = 0;
+}
+
+//-----------------------------------------------------------------------------
+// ParallelCodeGenerator
+//-----------------------------------------------------------------------------
+
+// More chunks than threads, so that a thread done early can steal from a slower one
+static const int CHUNKS_PER_THREAD = 8;
+
+// Elements in the subtree of 'root', 'root' included
+static int SubtreeSize(const ElementStore& store, ElementIndex root) {
+    int count = 1;
+    ElementIndex element = store.FirstChild(root);
+    while (element != ElementIndex_None) {
+        count++;
+        if (store.FirstChild(element) != ElementIndex_None) {
+            element = store.FirstChild(element);
+            continue;
+        }
+        while (element != root && store.NextSibling(element) == ElementIndex_None) {
+            element = store.links[element].parent;
+        }
+        element = (element == root) ? ElementIndex_None : store.NextSibling(element);
+    }
+    return count;
+}
+
+void ParallelCodeGenerator::GenerateDocument(ThreadPool& pool, const ElementStore& store, const char* menu_name, const char* header_name) {
+    // Cut the top-level elements into chunks of about 'chunk_elements' elements
+    int chunk_elements = store.Size() / (pool.GetThreadCount() * CHUNKS_PER_THREAD);
+    chunk_elements = chunk_elements < 1 ? 1 : chunk_elements;
+    chunk_count = 0;
+    int elements_in_chunk = 0;
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        if (elements_in_chunk == 0) {
+            if (chunk_count == (int)chunks.size()) {
+                chunks.emplace_back();
+            }
+            chunks[chunk_count++].first = root;
+        }
+        elements_in_chunk += SubtreeSize(store, root);
+        if (elements_in_chunk >= chunk_elements) {
+            chunks[chunk_count - 1].end = store.NextSibling(root);
+            elements_in_chunk = 0;
+        }
+    }
+    if (chunk_count > 0) {
+        chunks[chunk_count - 1].end = ElementIndex_None;
+    }
+
+    components.Build(store);
+    pool.ParallelFor(chunk_count, [this, &store](int index, int) {
+        Chunk& chunk = chunks[index];
+        chunk.code.Clear();
+        CodeGenerator generator(store, chunk.code);
+        generator.components = &components;
+        for (ElementIndex root = chunk.first; root != chunk.end; root = store.NextSibling(root)) {
+            generator.Element(root, 2);
+        }
+    });
+
+    GenerateHeader(menu_name, header);
+    GenerateSourceBegin(store, components, menu_name, header_name, source);
+    size_t body_size = 0;
+    for (int n = 0; n < chunk_count; n++) {
+        chunks[n].offset = body_size;
+        body_size += chunks[n].code.Size();
+    }
+    char* body = source.Extend(body_size);
+    pool.ParallelFor(chunk_count, [this, body](int index, int) {
+        const Chunk& chunk = chunks[index];
+        memcpy(body + chunk.offset, chunk.code.Begin(), chunk.code.Size());
+    });
+    GenerateSourceEnd(source);
+}
+
+//-----------------------------------------------------------------------------
+// Export
+//-----------------------------------------------------------------------------
+
+static bool WriteCodeFile(const std::string& path, const CodeBuffer& code, std::string* error) {
+    FILE* f = fopen(path.c_str(), "wb");
+    bool ok = f && fwrite(code.Begin(), 1, code.Size(), f) == code.Size();
+    ok = f && (fclose(f) == 0) && ok;
+    if (!ok && error) {
+        *error = "Cannot write file: " + path;
+    }
+    return ok;
+}
+
+// "dir/menu" -> "menu.h"
+static std::string HeaderName(const std::string& header_path) {
+    const size_t separator = header_path.find_last_of("/\\");
+    return (separator == std::string::npos) ? header_path : header_path.substr(separator + 1);
+}
+
+bool ExportDocumentCode(CodeCache& cache, const ElementStore& store, const char* menu_name, const char* base_path, std::string* error) {
+    const std::string header_path = std::string(base_path) + ".h";
+    const std::string source_path = std::string(base_path) + ".cpp";
+    cache.GenerateDocument(store, menu_name, HeaderName(header_path).c_str());
+    return WriteCodeFile(header_path, cache.GetHeader(), error) && WriteCodeFile(source_path, cache.GetSource(), error);
+}
+
+bool ExportDocumentCode(ParallelCodeGenerator& generator, ThreadPool& pool, const ElementStore& store, const char* menu_name, const char* base_path, std::string* error) {
+    const std::string header_path = std::string(base_path) + ".h";
+    const std::string source_path = std::string(base_path) + ".cpp";
+    generator.GenerateDocument(pool, store, menu_name, HeaderName(header_path).c_str());
+    return WriteCodeFile(header_path, generator.GetHeader(), error) && WriteCodeFile(source_path, generator.GetSource(), error);
+}
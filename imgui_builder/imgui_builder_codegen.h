@@ -0,0 +1,142 @@
+// ULTIMATE ImGui Builder: C++ code generation
+// A whole document is written in a single linear pass over the element tree into one growable CodeBuffer.
+// Buffers keep their capacity between generations: regenerating a document of the same size does not allocate.
+// Widget state becomes function-local statics named after the element label and uid ("static float volume_12 = 0.5f;"),
+// widget labels carry the uid as their ID part ("Volume##12") so that elements with the same label do not collide.
+// The code of an element only depends on the element, its subtree, its depth and the calls folding leaves it (see
+// imgui_builder_fold.h): CodeCache regenerates the elements whose revision or folding changed and copies everything
+// else from its previous output.
+// For the same reason top-level elements can be generated independently: ParallelCodeGenerator spreads them over a
+// ThreadPool and joins the pieces in document order.
+// Components (see imgui_builder_components.h) become one function each, defined before the window function after the
+// components they use, and a struct holding what was statics in their subtree. Every instance owns one such struct and
+// passes it: "static ComponentState_settings_row_5 row_45; Component_settings_row_5(&row_45);", so instances keep
+// their own widget state while the code is written once.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_components.h"
+#include "imgui_builder_fold.h"
+#include "imgui_builder_store.h"
+#include <string>
+#include <vector>
+
+// Bump when the generated code changes for the same document: batch generation caches regenerate everything.
+#define CODE_GENERATOR_VERSION  2
+
+class ThreadPool;
+
+class CodeBuffer {
+public:
+    // Forget the content, keep the memory.
+    void Clear() { size = 0; }
+
+    const char* Begin() const { return data.data(); }
+    const char* End() const { return data.data() + size; }
+    size_t Size() const { return size; }
+    bool Empty() const { return size == 0; }
+    const char* c_str();
+    int GetAllocCount() const { return alloc_count; }
+
+    void Append(const char* str, size_t length);
+    void Append(const char* str);
+    void AppendChar(char c) { if (size == data.size()) Grow(size + 1); data[size++] = c; }
+    void AppendIndent(int depth);
+    void AppendInt(int value);
+    void AppendUnsigned(ImU64 value);
+    // C++ float literal that reads back to the same value: "0.5f", "100.0f", "1e+30f"
+    void AppendFloat(float value);
+    // Quoted C++ string literal
+    void AppendStringLiteral(const char* str);
+    // Content of a string literal, without the quotes
+    void AppendEscaped(const char* str);
+    // Make room for 'length' bytes at the end and return them: the caller fills them in.
+    char* Extend(size_t length);
+    // Drop what was written past the first 'length' bytes
+    void Truncate(size_t length) { size = length < size ? length : size; }
+
+private:
+    void Grow(size_t min_capacity);
+
+    std::vector<char> data;
+    size_t size = 0;
+    int alloc_count = 0;
+};
+
+class CodeCache {
+public:
+    // Same output as GenerateDocumentCode(). Unchanged subtrees (same revision, parent, depth and folding as in
+    // the previous output) are copied in one piece: after an edit only the edited element and its ancestors are
+    // generated again, the rest of the cost is copying bytes.
+    void GenerateDocument(const ElementStore& store, const char* menu_name, const char* header_name);
+    const CodeBuffer& GetHeader() const { return header; }
+    const CodeBuffer& GetSource() const { return sources[current]; }
+    // Elements generated / copied with their subtree by the last GenerateDocument()
+    int GetGeneratedCount() const { return generated_count; }
+    int GetReusedCount() const { return reused_count; }
+    // Forget the previous output: the next generation starts from scratch.
+    void Clear();
+
+private:
+    friend struct CodeGenerator;
+
+    // Where the code of an element was in the previous output
+    struct Span {
+        ElementRevision revision = 0;   // 0: never generated
+        ElementCalls calls = 0;         // Folding of the element when generated
+        ElementIndex parent = ElementIndex_None;
+        int depth = 0;
+        size_t begin = 0;               // Relative to the parent's begin (to the first element for top-level ones)
+        size_t length = 0;
+    };
+
+    std::vector<Span> spans;            // Per slot
+    ComponentTable components;
+    ImU64 components_signature = 0;     // Of the components the previous output was generated with
+    CodeBuffer header;
+    CodeBuffer sources[2];              // Current and previous output, swapped on each generation
+    int current = 0;
+    size_t body_begin = 0;              // Offset of the first element in the current output
+    int generated_count = 0;
+    int reused_count = 0;
+};
+
+class ParallelCodeGenerator {
+public:
+    // Same output as GenerateDocumentCode(), byte for byte, whatever the number of threads of 'pool'.
+    // Consecutive top-level elements are grouped into chunks of about the same number of elements, several per
+    // thread so that stealing can even out the load; each chunk is generated into its own buffer, then the chunks
+    // are copied (in parallel too) to their final offsets. A document with a single huge top-level element does not
+    // split: its subtree is generated by one thread.
+    void GenerateDocument(ThreadPool& pool, const ElementStore& store, const char* menu_name, const char* header_name);
+    const CodeBuffer& GetHeader() const { return header; }
+    const CodeBuffer& GetSource() const { return source; }
+    int GetChunkCount() const { return chunk_count; }
+
+private:
+    struct Chunk {
+        ElementIndex first = ElementIndex_None;
+        ElementIndex end = ElementIndex_None;   // Top-level element following the chunk
+        size_t offset = 0;                      // In 'source'
+        CodeBuffer code;
+    };
+
+    std::vector<Chunk> chunks;                  // Buffers are kept between generations, only 'chunk_count' are used
+    ComponentTable components;
+    int chunk_count = 0;
+    CodeBuffer header;
+    CodeBuffer source;
+};
+
+// Code drawing 'element' and its subtree, as statements (the "Generated Code" window).
+void GenerateElementCode(const ElementStore& store, ElementIndex element, CodeBuffer& out);
+
+// Code drawing a whole document in a window titled 'menu_name', as a header/source pair.
+// 'header_name' is the file name the source includes.
+void GenerateDocumentCode(const ElementStore& store, const char* menu_name, const char* header_name, CodeBuffer& header, CodeBuffer& source);
+
+// Generate a whole document through 'cache' and write it to '<base_path>.h' and '<base_path>.cpp'.
+bool ExportDocumentCode(CodeCache& cache, const ElementStore& store, const char* menu_name, const char* base_path, std::string* error = nullptr);
+// Same, generated from scratch on 'pool'.
+bool ExportDocumentCode(ParallelCodeGenerator& generator, ThreadPool& pool, const ElementStore& store, const char* menu_name, const char* base_path, std::string* error = nullptr);
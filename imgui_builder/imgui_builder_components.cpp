@@ -0,0 +1,83 @@
+// ULTIMATE ImGui Builder: reusable components
+// See imgui_builder_components.h
+
+#include "imgui_builder_components.h"
+#include <string.h>
+#include <algorithm>
+
+void ComponentTable::Build(const ElementStore& store) {
+    entries.clear();
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        if (store.types[root] == ElementType::COMPONENT) {
+            entries.push_back(Entry{ store.strings[root].label, root, true });
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [&store](const Entry& a, const Entry& b) {
+        const int order = strcmp(a.name, b.name);
+        return order != 0 ? order < 0 : store.uids[a.element] < store.uids[b.element];
+    });
+
+    // Depth-first through the instances of each component: an instance of a component still being visited closes a
+    // cycle. Every cycle has one (the instance leading back to the first of its components visited), so once the
+    // components on them are not usable, instances of usable components only ever lead to usable ones.
+    if (!entries.empty()) {
+        std::vector<unsigned char> states(entries.size(), 0);     // 0: not visited, 1: being visited, 2: done
+        std::vector<int> path;
+        for (int n = 0; n < (int)entries.size(); n++) {
+            if (states[n] == 0) {
+                Visit(store, n, states, path);
+            }
+        }
+    }
+
+    // FNV-1a of what instances resolve to
+    ImU64 hash = 14695981039346656037ull;
+    for (const Entry& entry : entries) {
+        for (const char* p = entry.name; *p; p++) {
+            hash = (hash ^ (unsigned char)*p) * 1099511628211ull;
+        }
+        hash = (hash ^ store.uids[entry.element]) * 1099511628211ull;
+        hash = (hash ^ (entry.usable ? 1u : 2u)) * 1099511628211ull;
+    }
+    signature = entries.empty() ? 0 : hash;
+    revision = store.GetRevision();
+}
+
+void ComponentTable::Visit(const ElementStore& store, int entry, std::vector<unsigned char>& states, std::vector<int>& path) {
+    states[entry] = 1;
+    path.push_back(entry);
+    VisitSubtree(store, entries[entry].element, states, path);
+    path.pop_back();
+    states[entry] = 2;
+}
+
+void ComponentTable::VisitSubtree(const ElementStore& store, ElementIndex parent, std::vector<unsigned char>& states, std::vector<int>& path) {
+    for (ElementIndex child = store.FirstChild(parent); child != ElementIndex_None; child = store.NextSibling(child)) {
+        if (store.types[child] == ElementType::INSTANCE) {
+            const int target = FindEntry(store.strings[child].text_value);
+            if (target >= 0 && states[target] == 1) {
+                for (int n = (int)path.size() - 1; n >= 0; n--) {
+                    entries[path[n]].usable = false;
+                    if (path[n] == target) {
+                        break;
+                    }
+                }
+            } else if (target >= 0 && states[target] == 0) {
+                Visit(store, target, states, path);
+            }
+        }
+        VisitSubtree(store, child, states, path);
+    }
+}
+
+int ComponentTable::FindEntry(const char* name) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), name, [](const Entry& entry, const char* value) {
+        return strcmp(entry.name, value) < 0;
+    });
+    return (it != entries.end() && strcmp(it->name, name) == 0) ? (int)(it - entries.begin()) : -1;
+}
+
+ElementIndex ComponentTable::Find(const char* name) const {
+    const int entry = FindEntry(name);
+    return (entry >= 0 && entries[entry].usable) ? entries[entry].element : ElementIndex_None;
+}
@@ -0,0 +1,58 @@
+// ULTIMATE ImGui Builder: reusable components
+// A block repeated across a document (a settings row, a labelled slider pair...) is defined once and drawn by
+// lightweight instances instead of being duplicated:
+// - a COMPONENT element at the top level of the document is a definition. Its label is the component name and its
+//   children are its content. It draws nothing where it is;
+// - an INSTANCE element draws the component named by its text where it is, inside its own ImGui ID scope, so the
+//   widgets of two instances never collide. Its own flags and style are the per-instance overrides: a disabled or
+//   hidden instance disables or hides its copy only, its text color and item width apply around it.
+// An instance costs one element however large the component, and generated code has one function per component,
+// called once per instance with a state struct of its own (see imgui_builder_codegen.h): editing the definition
+// edits every instance. The preview only has the values of the definition, which all of its instances show.
+//
+// ComponentTable resolves names: built from a document in O(top-level elements), it finds a component by name in
+// O(log components). Components drawing themselves, directly or through other components, would never end: they
+// are found but not usable, their instances draw nothing like those naming a missing component.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <vector>
+
+class ComponentTable {
+public:
+    // Index the components of 'store'. Keeps its memory: rebuilding a document without components allocates nothing.
+    void Build(const ElementStore& store);
+    // Whether 'store' changed since Build() (any edit may rename or move a component)
+    bool IsStale(const ElementStore& store) const { return revision != store.GetRevision(); }
+
+    // Definition drawn by instances naming 'name'. ElementIndex_None if there is none or it is not usable.
+    // Names are unique in practice; when they are not the oldest component (lowest uid) wins.
+    ElementIndex Find(const char* name) const;
+    // Whether a component is named 'name', usable or not
+    bool Contains(const char* name) const { return FindEntry(name) >= 0; }
+
+    // Components in name order
+    int GetCount() const { return (int)entries.size(); }
+    ElementIndex Get(int n) const { return entries[n].element; }
+    bool IsUsable(int n) const { return entries[n].usable; }
+    // Changes when a component is added, removed, renamed or stops being usable: anything generated from
+    // instances (which only refer to components by name) is stale.
+    ImU64 GetSignature() const { return signature; }
+
+private:
+    struct Entry {
+        const char* name;
+        ElementIndex element;
+        bool usable;
+    };
+
+    int FindEntry(const char* name) const;
+    void Visit(const ElementStore& store, int entry, std::vector<unsigned char>& states, std::vector<int>& path);
+    void VisitSubtree(const ElementStore& store, ElementIndex parent, std::vector<unsigned char>& states, std::vector<int>& path);
+
+    std::vector<Entry> entries;     // Sorted by name, then uid
+    ImU64 signature = 0;
+    ElementRevision revision = 0;
+};
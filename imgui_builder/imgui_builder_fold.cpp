@@ -0,0 +1,279 @@
+// ULTIMATE ImGui Builder: dead element and no-op folding
+// See imgui_builder_fold.h
+
+#include "imgui_builder_fold.h"
+#include "imgui_builder_types.h"
+#include <string.h>
+
+// Elements with these colors push none
+static const ImVec4 DEFAULT_TEXT_COLOR = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+static const ImVec4 DEFAULT_BG_COLOR = ImVec4(0.2f, 0.2f, 0.2f, 1.0f);
+
+// No call whatever its siblings
+static bool IsSkipped(const ElementStore& store, ElementIndex element) {
+    return !(store.flags[element] & ElementFlags_Visible) || store.types[element] == ElementType::COMPONENT;
+}
+
+static bool IsLeaf(const ElementStore& store, ElementIndex element) {
+    return store.FirstChild(element) == ElementIndex_None;
+}
+
+static bool IsLayout(const ElementStore& store, ElementIndex element) {
+    return HasTypeFlags(store.types[element], ElementTypeFlags_Layout) && IsLeaf(store, element);
+}
+
+static bool IsEmptyList(const ElementStore& store, ElementIndex element) {
+    const ElementType type = store.types[element];
+    return (type == ElementType::COMBO || type == ElementType::LISTBOX) && store.GetItemCount(element) == 0 && IsLeaf(store, element);
+}
+
+// Siblings drawn one after the other: not the cells of a table or columns, nor the entries of a menu bar
+static bool IsSequential(const ElementStore& store, ElementIndex element) {
+    const ElementIndex parent = store.links[element].parent;
+    if (parent == ElementIndex_None) {
+        return true;
+    }
+    const ElementType type = store.types[parent];
+    return type != ElementType::TABLE && type != ElementType::COLUMNS && type != ElementType::MENU_BAR;
+}
+
+static ElementIndex PrevDrawn(const ElementStore& store, ElementIndex element) {
+    ElementIndex sibling = store.PrevSibling(element);
+    while (sibling != ElementIndex_None && IsSkipped(store, sibling)) {
+        sibling = store.PrevSibling(sibling);
+    }
+    return sibling;
+}
+
+static ElementIndex NextDrawn(const ElementStore& store, ElementIndex element) {
+    ElementIndex sibling = store.NextSibling(element);
+    while (sibling != ElementIndex_None && IsSkipped(store, sibling)) {
+        sibling = store.NextSibling(sibling);
+    }
+    return sibling;
+}
+
+// The cursor is at the start of a line after it
+static bool EndsLine(const ElementStore& store, ElementIndex element) {
+    const ElementType type = store.types[element];
+    return IsLeaf(store, element) && type != ElementType::SAME_LINE && HasTypeFlags(type, ElementTypeFlags_Item | ElementTypeFlags_Layout) &&
+        !IsEmptyList(store, element);
+}
+
+// An INDENT folded with the UNINDENT following it
+static bool IsIndentPair(const ElementStore& store, ElementIndex element) {
+    if (store.types[element] != ElementType::INDENT || !IsLeaf(store, element) || !IsSequential(store, element)) {
+        return false;
+    }
+    const ElementIndex next = NextDrawn(store, element);
+    if (next == ElementIndex_None || store.types[next] != ElementType::UNINDENT || !IsLeaf(store, next)) {
+        return false;
+    }
+    const ElementIndex prev = PrevDrawn(store, element);
+    return prev != ElementIndex_None && EndsLine(store, prev);
+}
+
+// Drawn but making no call. Only ever leaves, which depend on the element before or after them (not on whether it
+// is folded itself, so this does not recurse).
+static bool IsFolded(const ElementStore& store, ElementIndex element) {
+    switch (store.types[element]) {
+    case ElementType::COMBO:
+    case ElementType::LISTBOX: {
+        if (!IsEmptyList(store, element)) {
+            return false;
+        }
+        const ElementIndex next = NextDrawn(store, element);
+        return next == ElementIndex_None || store.types[next] != ElementType::TOOLTIP;
+    }
+    case ElementType::SAME_LINE: {
+        if (!IsLeaf(store, element) || !IsSequential(store, element)) {
+            return false;
+        }
+        const ElementIndex prev = PrevDrawn(store, element);
+        return prev != ElementIndex_None && store.types[prev] == ElementType::SAME_LINE && IsLeaf(store, prev);
+    }
+    case ElementType::INDENT:
+        return IsIndentPair(store, element);
+    case ElementType::UNINDENT: {
+        if (!IsLeaf(store, element)) {
+            return false;
+        }
+        const ElementIndex prev = PrevDrawn(store, element);
+        return prev != ElementIndex_None && IsIndentPair(store, prev);
+    }
+    default:
+        return false;
+    }
+}
+
+static bool IsColor(const ImVec4& color, const ImVec4& value) {
+    return memcmp(&color, &value, sizeof(ImVec4)) == 0;
+}
+
+// Needs BeginDisabled()/EndDisabled() around it, alone or shared
+static bool HasDisabledScope(const ElementStore& store, ElementIndex element) {
+    return !(store.flags[element] & ElementFlags_Enabled) && !IsLayout(store, element);
+}
+
+static bool HasTextColor(const ElementStore& store, ElementIndex element) {
+    return !IsColor(store.styles[element].text_color, DEFAULT_TEXT_COLOR) &&
+        !(HasTypeFlags(store.types[element], ElementTypeFlags_NoText) && IsLeaf(store, element));
+}
+
+static bool HasBgColor(const ElementStore& store, ElementIndex element) {
+    return GetElementTypeInfo(store.types[element]).background >= 0 && !IsColor(store.styles[element].bg_color, DEFAULT_BG_COLOR);
+}
+
+static bool HasItemWidth(const ElementStore& store, ElementIndex element) {
+    return store.styles[element].size.x > 0 && HasTypeFlags(store.types[element], ElementTypeFlags_ItemWidth);
+}
+
+bool IsScopeTransparent(const ElementStore& store, ElementIndex element, StyleScope scope) {
+    if (IsSkipped(store, element) || IsFolded(store, element)) {
+        return true;
+    }
+    if (!IsLeaf(store, element)) {
+        return false;
+    }
+    const ElementType type = store.types[element];
+    switch (scope) {
+    case StyleScope_Disabled:
+        return HasTypeFlags(type, ElementTypeFlags_Layout);
+    case StyleScope_Colors:
+        return HasTypeFlags(type, ElementTypeFlags_NoText) && GetElementTypeInfo(type).background < 0;
+    case StyleScope_ItemWidth:
+        // Progress bars and plots without a width take the item width
+        return HasTypeFlags(type, ElementTypeFlags_Layout) ||
+            (HasTypeFlags(type, ElementTypeFlags_Item) && !HasTypeFlags(type, ElementTypeFlags_ItemWidth) &&
+             type != ElementType::PROGRESS_BAR && type != ElementType::PLOT_LINES && type != ElementType::PLOT_HISTOGRAM);
+    }
+    return false;
+}
+
+bool HaveSameScope(const ElementStore& store, ElementIndex a, ElementIndex b, StyleScope scope) {
+    switch (scope) {
+    case StyleScope_Disabled:
+        return HasDisabledScope(store, a) && HasDisabledScope(store, b);
+    case StyleScope_Colors: {
+        const bool text = HasTextColor(store, a);
+        const bool bg = HasBgColor(store, a);
+        if ((!text && !bg) || text != HasTextColor(store, b) || bg != HasBgColor(store, b)) {
+            return false;
+        }
+        const ElementStyle& style_a = store.styles[a];
+        const ElementStyle& style_b = store.styles[b];
+        return (!text || IsColor(style_a.text_color, style_b.text_color)) &&
+            (!bg || (IsColor(style_a.bg_color, style_b.bg_color) &&
+                     GetElementTypeInfo(store.types[a]).background == GetElementTypeInfo(store.types[b]).background));
+    }
+    case StyleScope_ItemWidth:
+        return HasItemWidth(store, a) && HasItemWidth(store, b) && store.styles[a].size.x == store.styles[b].size.x;
+    }
+    return false;
+}
+
+// Nearest siblings a scope of that kind matters to
+static ElementIndex PrevInScope(const ElementStore& store, ElementIndex element, StyleScope scope) {
+    ElementIndex sibling = store.PrevSibling(element);
+    while (sibling != ElementIndex_None && IsScopeTransparent(store, sibling, scope)) {
+        sibling = store.PrevSibling(sibling);
+    }
+    return sibling;
+}
+
+static ElementIndex NextInScope(const ElementStore& store, ElementIndex element, StyleScope scope) {
+    ElementIndex sibling = store.NextSibling(element);
+    while (sibling != ElementIndex_None && IsScopeTransparent(store, sibling, scope)) {
+        sibling = store.NextSibling(sibling);
+    }
+    return sibling;
+}
+
+// 'begin' and 'end' set unless the scope is continued from the previous sibling or by the next one
+static ElementCalls GetScopeCalls(const ElementStore& store, ElementIndex element, StyleScope scope, ElementCalls begin,
+                                  ElementCalls end) {
+    ElementCalls calls = begin | end;
+    if (IsSequential(store, element)) {
+        const ElementIndex prev = PrevInScope(store, element, scope);
+        const ElementIndex next = NextInScope(store, element, scope);
+        if (prev != ElementIndex_None && HaveSameScope(store, prev, element, scope)) {
+            calls &= ~begin;
+        }
+        if (next != ElementIndex_None && HaveSameScope(store, element, next, scope)) {
+            calls &= ~end;
+        }
+    }
+    return calls;
+}
+
+ElementCalls GetElementCalls(const ElementStore& store, ElementIndex element) {
+    if (IsSkipped(store, element) || IsFolded(store, element)) {
+        return ElementCalls_None;
+    }
+    ElementCalls calls = ElementCalls_Draw;
+    if (HasDisabledScope(store, element)) {
+        calls |= ElementCalls_Disabled | GetScopeCalls(store, element, StyleScope_Disabled, ElementCalls_BeginDisabled, ElementCalls_EndDisabled);
+    }
+    calls |= HasTextColor(store, element) ? ElementCalls_TextColor : 0;
+    calls |= HasBgColor(store, element) ? ElementCalls_BgColor : 0;
+    if (calls & (ElementCalls_TextColor | ElementCalls_BgColor)) {
+        calls |= GetScopeCalls(store, element, StyleScope_Colors, ElementCalls_PushColors, ElementCalls_PopColors);
+    }
+    if (HasItemWidth(store, element)) {
+        calls |= ElementCalls_ItemWidth | GetScopeCalls(store, element, StyleScope_ItemWidth, ElementCalls_PushItemWidth, ElementCalls_PopItemWidth);
+    }
+    return calls;
+}
+
+static void AnalyzeChildren(const ElementStore& store, ElementIndex parent, LayoutFoldStats& stats) {
+    for (ElementIndex child = store.FirstChild(parent); child != ElementIndex_None; child = store.NextSibling(child)) {
+        if (IsSkipped(store, child)) {
+            continue;
+        }
+        stats.elements++;
+        const ElementCalls calls = GetElementCalls(store, child);
+        // What one scope per element, without folding, makes
+        const bool disabled = !(store.flags[child] & ElementFlags_Enabled);
+        const int colors = (IsColor(store.styles[child].text_color, DEFAULT_TEXT_COLOR) ? 0 : 1) + (HasBgColor(store, child) ? 1 : 0);
+        const int color_calls = colors > 0 ? colors + 1 : 0;
+        if (!(calls & ElementCalls_Draw)) {
+            stats.folded_elements++;
+            stats.calls_saved += 1 + (disabled ? 2 : 0) + color_calls + (HasItemWidth(store, child) ? 2 : 0);
+            continue;
+        }
+        const int kept_colors = GetColorCount(calls);
+        const int kept_color_calls = kept_colors > 0 ? kept_colors + 1 : 0;
+        if (disabled && !HasDisabledScope(store, child)) {
+            stats.dropped_scopes++;
+            stats.calls_saved += 2;
+        }
+        if (kept_colors < colors) {
+            stats.dropped_scopes++;
+            stats.calls_saved += color_calls - kept_color_calls;
+        }
+        // Scopes the next sibling's continues: their end here and its begin there
+        const bool disabled_merged = HasDisabledScope(store, child) && !(calls & ElementCalls_EndDisabled);
+        const bool colors_merged = kept_colors > 0 && !(calls & ElementCalls_PopColors);
+        const bool width_merged = (calls & ElementCalls_ItemWidth) && !(calls & ElementCalls_PopItemWidth);
+        const int merged = (disabled_merged ? 2 : 0) + (colors_merged ? kept_color_calls : 0) + (width_merged ? 2 : 0);
+        stats.merged_scopes += (disabled_merged ? 1 : 0) + (colors_merged ? 1 : 0) + (width_merged ? 1 : 0);
+        stats.merged_calls += merged;
+        stats.calls_saved += merged;
+        stats.style_calls += ((calls & ElementCalls_BeginDisabled) ? 1 : 0) + ((calls & ElementCalls_EndDisabled) ? 1 : 0) +
+            ((calls & ElementCalls_PushColors) ? kept_colors : 0) + ((calls & ElementCalls_PopColors) ? 1 : 0) +
+            ((calls & ElementCalls_PushItemWidth) ? 1 : 0) + ((calls & ElementCalls_PopItemWidth) ? 1 : 0);
+        AnalyzeChildren(store, child, stats);
+    }
+}
+
+LayoutFoldStats AnalyzeLayout(const ElementStore& store) {
+    LayoutFoldStats stats;
+    // Component contents once, not once per instance
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        if (store.types[root] == ElementType::COMPONENT && (store.flags[root] & ElementFlags_Visible)) {
+            AnalyzeChildren(store, root, stats);
+        }
+    }
+    AnalyzeChildren(store, ElementIndex_None, stats);
+    return stats;
+}
@@ -0,0 +1,75 @@
+// ULTIMATE ImGui Builder: dead element and no-op folding
+// The calls an element makes are decided here, once for generated code, LayoutProgram and the preview: each makes
+// the calls GetElementCalls() keeps and no other. The document stays as edited (folded elements are still listed,
+// saved and editable), only calls that change nothing on screen are left out:
+// - hidden elements and component definitions (drawn by their instances);
+// - a combo or list box without items, which the preview never drew. Kept before a tooltip: it is the item the
+//   tooltip is shown for;
+// - a SAME_LINE right after another one: SameLine() only reads the previous line, repeating it changes nothing;
+// - an INDENT right before an UNINDENT, when the cursor is at the start of a line (after an item, a spacing...):
+//   they move it away and back;
+// - scopes with no effect: the default text color or background, a text color around an element drawing no text, a
+//   disabled scope around a layout element (spacing, same line...).
+// Style scopes are shared by runs of consecutive siblings: siblings with the same disabled state, the same colors
+// or the same item width make one BeginDisabled()/EndDisabled(), one set of PushStyleColor() then one
+// PopStyleColor(count), one PushItemWidth()/PopItemWidth() around all of them. Elements drawn the same inside a scope
+// of that kind or not are part of the run: layout elements, a separator for colors, items not sized by the item width
+// for the item width. The kinds use separate ImGui stacks, so their runs need not nest. Text and background colors
+// share one: a run holds one set of colors, which siblings join when they push the same ones.
+// Siblings are only compared where they are drawn one after the other: not in the cells of a table or columns, nor
+// in a menu bar. Elements with children are never folded nor lose a scope: the children are inside.
+//
+// Every rule reads the element and its nearest siblings (for runs, the nearest ones a run does not continue across):
+// a sibling edit changes the calls of an element without changing its revision, but touches the parent, so anything
+// regenerating touched elements revisits its children (CodeCache compares the calls each child was generated with).
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+
+enum ElementCalls_ {
+    ElementCalls_None           = 0,        // Folded away (or hidden): no call at all
+    ElementCalls_Draw           = 1 << 0,   // Its own calls, then its children
+    ElementCalls_BeginDisabled  = 1 << 1,   // Opens a disabled scope: not set on the next ones of a run
+    ElementCalls_EndDisabled    = 1 << 2,   // Closes it: not set on the previous ones of a run
+    ElementCalls_TextColor      = 1 << 3,   // Inside a color scope holding its text color (ImGuiCol_Text)
+    ElementCalls_BgColor        = 1 << 4,   // Inside a color scope holding its bg_color (ElementTypeInfo::background)
+    ElementCalls_PushColors     = 1 << 5,   // Opens the color scope: PushStyleColor() for each color, text first
+    ElementCalls_PopColors      = 1 << 6,   // Closes it: PopStyleColor(GetColorCount())
+    ElementCalls_ItemWidth      = 1 << 7,   // Inside an item width scope holding its size.x
+    ElementCalls_PushItemWidth  = 1 << 8,   // Opens the item width scope
+    ElementCalls_PopItemWidth   = 1 << 9,   // Closes it
+    ElementCalls_Disabled       = 1 << 10,  // Inside a disabled scope, opened by it or not
+};
+typedef int ElementCalls;
+
+// O(1) but for hidden or folded siblings skipped when looking for the nearest ones
+ElementCalls GetElementCalls(const ElementStore& store, ElementIndex element);
+inline int GetColorCount(ElementCalls calls) { return ((calls & ElementCalls_TextColor) ? 1 : 0) + ((calls & ElementCalls_BgColor) ? 1 : 0); }
+
+enum StyleScope_ {
+    StyleScope_Disabled,
+    StyleScope_Colors,
+    StyleScope_ItemWidth,
+};
+typedef int StyleScope;
+
+// Drawn the same inside a scope of that kind or not (hidden and folded elements included): a run continues across it
+bool IsScopeTransparent(const ElementStore& store, ElementIndex element, StyleScope scope);
+// Both need a scope of that kind with the same state: one can continue the scope of the other
+bool HaveSameScope(const ElementStore& store, ElementIndex a, ElementIndex b, StyleScope scope);
+
+struct LayoutFoldStats {
+    int elements = 0;           // Visible ones, component definitions excluded
+    int folded_elements = 0;    // Making no call
+    int dropped_scopes = 0;     // Disabled or text color scopes left out
+    int merged_scopes = 0;      // Scopes continued by the next sibling's
+    int calls_saved = 0;        // Per frame, each element counted once, every container open
+    int style_calls = 0;        // Calls opening or closing a scope that are left, counted like calls_saved
+    int merged_calls = 0;       // Of calls_saved, the ones shared scopes save: one scope per element makes
+                                // style_calls + merged_calls
+};
+
+// Everything GetElementCalls() leaves out of a document, O(elements)
+LayoutFoldStats AnalyzeLayout(const ElementStore& store);
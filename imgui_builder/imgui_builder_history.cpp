@@ -0,0 +1,548 @@
+// ULTIMATE ImGui Builder: undo/redo
+// See imgui_builder_history.h
+
+#include "imgui_builder_history.h"
+#include <string.h>
+
+enum HistoryCommand_ {
+    HistoryCommand_Set,         // + old bytes + new bytes of the field
+    HistoryCommand_Insert,      // + SubtreeHeader + ElementSnapshot per element, pre-order
+    HistoryCommand_Remove,      // Same
+    HistoryCommand_Move,        // + MovePayload
+};
+
+// Element properties, each undone on its own
+enum HistoryField_ {
+    HistoryField_Flags,
+    HistoryField_Values,
+    HistoryField_Label,
+    HistoryField_Text,
+    HistoryField_Items,
+    HistoryField_Size,
+    HistoryField_TextColor,
+    HistoryField_BgColor,
+    HistoryField_Color,
+    HistoryField_COUNT
+};
+
+struct ItemRange {
+    int offset;
+    int count;
+};
+
+static const size_t g_FieldSizes[HistoryField_COUNT] = {
+    sizeof(ElementFlags), sizeof(ElementValues), sizeof(const char*), sizeof(const char*), sizeof(ItemRange),
+    sizeof(ImVec2), sizeof(ImVec4), sizeof(ImVec4), sizeof(ImVec4),
+};
+
+static const size_t MAX_FIELD_SIZE = 32;
+static_assert(sizeof(ElementValues) <= MAX_FIELD_SIZE && sizeof(ImVec4) <= MAX_FIELD_SIZE, "Field too large");
+
+static size_t FieldOffset(int field) {
+    size_t offset = 0;
+    for (int n = 0; n < field; n++) {
+        offset += g_FieldSizes[n];
+    }
+    return offset;
+}
+
+static const size_t ALL_FIELDS_SIZE = FieldOffset(HistoryField_COUNT);
+
+// Open/closed state in the preview and the tree is not an edit: undo leaves it as it is
+static const ElementFlags HISTORY_FLAGS = ~(ElementFlags)(ElementFlags_Open | ElementFlags_Expanded);
+
+struct CommandHeader {
+    ImU32 command;
+    ImU32 field;
+    ElementUid uid;
+};
+
+struct MovePayload {
+    ElementUid old_parent;
+    ElementUid old_before;
+    ElementUid new_parent;
+    ElementUid new_before;
+};
+
+struct SubtreeHeader {
+    ElementUid parent;
+    ElementUid before;          // Next sibling, ElementUid_None when last
+    ImU32 count;
+    ImU32 reserved;
+};
+
+struct ElementSnapshot {
+    ElementUid uid;
+    ImU32 child_count;
+    ElementFlags flags;
+    ElementType type;
+    ElementValues values;
+    ItemRange items;
+    ElementStrings strings;
+    ElementStyle style;
+    ImVec4 color;
+};
+
+static void ReadField(const ElementStore& store, ElementIndex index, int field, unsigned char* out) {
+    switch (field) {
+    case HistoryField_Flags: {
+        const ElementFlags flags = store.flags[index] & HISTORY_FLAGS;
+        memcpy(out, &flags, sizeof(flags));
+        break;
+    }
+    case HistoryField_Values: {
+        const ElementValues values = store.GetValues(index);
+        memcpy(out, &values, sizeof(values));
+        break;
+    }
+    case HistoryField_Label: memcpy(out, &store.strings[index].label, sizeof(const char*)); break;
+    case HistoryField_Text: memcpy(out, &store.strings[index].text_value, sizeof(const char*)); break;
+    case HistoryField_Items: {
+        const ItemRange items = { store.GetItemList(index).offset, store.GetItemList(index).count };
+        memcpy(out, &items, sizeof(items));
+        break;
+    }
+    case HistoryField_Size: memcpy(out, &store.styles[index].size, sizeof(ImVec2)); break;
+    case HistoryField_TextColor: memcpy(out, &store.styles[index].text_color, sizeof(ImVec4)); break;
+    case HistoryField_BgColor: memcpy(out, &store.styles[index].bg_color, sizeof(ImVec4)); break;
+    case HistoryField_Color: memcpy(out, &store.GetColor(index), sizeof(ImVec4)); break;
+    }
+}
+
+static void WriteField(ElementStore& store, ElementIndex index, int field, const unsigned char* in) {
+    switch (field) {
+    case HistoryField_Flags: {
+        ElementFlags flags;
+        memcpy(&flags, in, sizeof(flags));
+        store.flags[index] = (flags & HISTORY_FLAGS) | (store.flags[index] & ~HISTORY_FLAGS);
+        break;
+    }
+    case HistoryField_Values: {
+        ElementValues values;
+        memcpy(&values, in, sizeof(values));
+        store.SetValues(index, values);
+        break;
+    }
+    case HistoryField_Label: memcpy(&store.strings[index].label, in, sizeof(const char*)); break;
+    case HistoryField_Text: memcpy(&store.strings[index].text_value, in, sizeof(const char*)); break;
+    case HistoryField_Items: {
+        ItemRange items;
+        memcpy(&items, in, sizeof(items));
+        if (ElementItemList* list = store.EditItemList(index)) {
+            list->offset = items.offset;
+            list->count = items.count;
+        }
+        break;
+    }
+    case HistoryField_Size: memcpy(&store.styles[index].size, in, sizeof(ImVec2)); break;
+    case HistoryField_TextColor: memcpy(&store.styles[index].text_color, in, sizeof(ImVec4)); break;
+    case HistoryField_BgColor: memcpy(&store.styles[index].bg_color, in, sizeof(ImVec4)); break;
+    case HistoryField_Color:
+        if (ImVec4* color = store.EditColor(index)) {
+            memcpy(color, in, sizeof(ImVec4));
+        }
+        break;
+    }
+    store.Touch(index);
+}
+
+static ElementUid UidOf(const ElementStore& store, ElementIndex index) {
+    return index == ElementIndex_None ? ElementUid_None : store.uids[index];
+}
+
+static size_t CommandSize(const unsigned char* command) {
+    CommandHeader header;
+    memcpy(&header, command, sizeof(header));
+    switch (header.command) {
+    case HistoryCommand_Set:
+        return sizeof(header) + 2 * g_FieldSizes[header.field];
+    case HistoryCommand_Move:
+        return sizeof(header) + sizeof(MovePayload);
+    default: {
+        SubtreeHeader subtree;
+        memcpy(&subtree, command + sizeof(header), sizeof(subtree));
+        return sizeof(header) + sizeof(subtree) + subtree.count * sizeof(ElementSnapshot);
+    }
+    }
+}
+
+static ElementIndex RestoreSubtree(ElementStore& store, const unsigned char*& data) {
+    ElementSnapshot snapshot;
+    memcpy(&snapshot, data, sizeof(snapshot));
+    data += sizeof(snapshot);
+    const ElementIndex index = store.Create(snapshot.type);
+    store.SetUid(index, snapshot.uid);
+    store.flags[index] = snapshot.flags;
+    store.SetValues(index, snapshot.values);
+    if (ElementItemList* list = store.EditItemList(index)) {
+        list->offset = snapshot.items.offset;
+        list->count = snapshot.items.count;
+    }
+    store.strings[index] = snapshot.strings;
+    store.styles[index] = snapshot.style;
+    if (ImVec4* color = store.EditColor(index)) {
+        *color = snapshot.color;
+    }
+    for (ImU32 child = 0; child < snapshot.child_count; child++) {
+        store.Append(index, RestoreSubtree(store, data));
+    }
+    return index;
+}
+
+EditHistory::EditHistory(size_t capacity) : capacity(capacity) {
+}
+
+bool EditHistory::CheckGeneration(const ElementStore& store) {
+    // Steps hold interned strings and uids: both mean nothing once the document was cleared or replaced
+    const ImU32 generation = store.string_pool.GetGeneration();
+    if (generation == string_generation) {
+        return true;
+    }
+    Clear();
+    string_generation = generation;
+    return false;
+}
+
+void EditHistory::BeginCommand(ImU32 command, ImU32 field, ElementUid uid) {
+    const CommandHeader header = { command, field, uid };
+    Write(&header, sizeof(header));
+    step_command_count++;
+}
+
+void EditHistory::Write(const void* data, size_t size) {
+    const size_t offset = step.size();
+    step.resize(offset + size);
+    memcpy(step.data() + offset, data, size);
+}
+
+void EditHistory::BeginEdit(const ElementStore& store, ElementIndex index) {
+    CheckGeneration(store);
+    edit_uid = store.uids[index];
+    edit_before.resize(ALL_FIELDS_SIZE);
+    for (int field = 0, offset = 0; field < HistoryField_COUNT; offset += (int)g_FieldSizes[field++]) {
+        ReadField(store, index, field, edit_before.data() + offset);
+    }
+}
+
+void EditHistory::EndEdit(const ElementStore& store) {
+    const ElementIndex index = store.FindByUid(edit_uid);
+    edit_uid = ElementUid_None;
+    if (index == ElementIndex_None || !CheckGeneration(store)) {
+        return;
+    }
+
+    if (!grouping) {
+        step.clear();
+        step_command_count = 0;
+    }
+    unsigned char after[MAX_FIELD_SIZE];
+    for (int field = 0, offset = 0; field < HistoryField_COUNT; offset += (int)g_FieldSizes[field++]) {
+        ReadField(store, index, field, after);
+        if (memcmp(after, edit_before.data() + offset, g_FieldSizes[field]) != 0) {
+            BeginCommand(HistoryCommand_Set, field, store.uids[index]);
+            Write(edit_before.data() + offset, g_FieldSizes[field]);
+            Write(after, g_FieldSizes[field]);
+        }
+    }
+    if (grouping || step_command_count == 0) {
+        return;
+    }
+    if (!MergeIntoTop()) {
+        Commit();
+    }
+}
+
+void EditHistory::BeginGroup() {
+    grouping = true;
+    group_structural = false;
+    step.clear();
+    step_command_count = 0;
+}
+
+void EditHistory::EndGroup() {
+    grouping = false;
+    if (step_command_count == 0) {
+        return;
+    }
+    if (group_structural) {
+        Commit();
+        open = false;
+    } else if (!MergeIntoTop()) {
+        Commit();
+    }
+}
+
+// Still editing the same fields as the newest step: only their new values move
+bool EditHistory::MergeIntoTop() {
+    if (!open || top != last || top == NONE || Header(top).command_count != step_command_count) {
+        return false;
+    }
+    // Property steps only hold Set commands, of a size given by their field
+    unsigned char* const commands_begin = &ring[top + sizeof(StepHeader)];
+    for (size_t offset = 0; offset < step.size(); ) {
+        if (memcmp(commands_begin + offset, step.data() + offset, sizeof(CommandHeader)) != 0) {
+            return false;
+        }
+        CommandHeader command;
+        memcpy(&command, step.data() + offset, sizeof(command));
+        offset += sizeof(CommandHeader) + 2 * g_FieldSizes[command.field];
+    }
+    for (size_t offset = 0; offset < step.size(); ) {
+        CommandHeader command;
+        memcpy(&command, step.data() + offset, sizeof(command));
+        const size_t field_size = g_FieldSizes[command.field];
+        const size_t value = offset + sizeof(CommandHeader) + field_size;
+        memcpy(commands_begin + value, step.data() + value, field_size);
+        offset = value + field_size;
+    }
+    merged_edits++;
+    return true;
+}
+
+int EditHistory::WriteSubtree(const ElementStore& store, ElementIndex index) {
+    ElementSnapshot snapshot = ElementSnapshot();   // Zeroes the padding too, the bytes go to the ring
+    snapshot.uid = store.uids[index];
+    snapshot.flags = store.flags[index];
+    snapshot.type = store.types[index];
+    snapshot.values = store.GetValues(index);
+    snapshot.items.offset = store.GetItemList(index).offset;
+    snapshot.items.count = store.GetItemList(index).count;
+    snapshot.strings = store.strings[index];
+    snapshot.style = store.styles[index];
+    snapshot.color = store.GetColor(index);
+    for (ElementIndex child = store.FirstChild(index); child != ElementIndex_None; child = store.NextSibling(child)) {
+        snapshot.child_count++;
+    }
+    Write(&snapshot, sizeof(snapshot));
+
+    int count = 1;
+    for (ElementIndex child = store.FirstChild(index); child != ElementIndex_None; child = store.NextSibling(child)) {
+        count += WriteSubtree(store, child);
+    }
+    return count;
+}
+
+bool EditHistory::RecordSubtree(const ElementStore& store, ElementIndex index, ImU32 command) {
+    CheckGeneration(store);
+    if (!grouping) {
+        step.clear();
+        step_command_count = 0;
+    }
+    BeginCommand(command, 0, store.uids[index]);
+    SubtreeHeader subtree = { UidOf(store, store.Parent(index)), UidOf(store, store.NextSibling(index)), 0, 0 };
+    const size_t subtree_offset = step.size();
+    Write(&subtree, sizeof(subtree));
+    subtree.count = (ImU32)WriteSubtree(store, index);
+    memcpy(step.data() + subtree_offset, &subtree, sizeof(subtree));
+    if (grouping) {
+        group_structural = true;
+        return true;
+    }
+    const bool ok = Commit();
+    open = false;
+    return ok;
+}
+
+bool EditHistory::RecordInsert(const ElementStore& store, ElementIndex index) {
+    return RecordSubtree(store, index, HistoryCommand_Insert);
+}
+
+bool EditHistory::RecordRemove(const ElementStore& store, ElementIndex index) {
+    return RecordSubtree(store, index, HistoryCommand_Remove);
+}
+
+bool EditHistory::RecordMove(const ElementStore& store, ElementIndex index, ElementIndex old_parent, ElementIndex old_before) {
+    CheckGeneration(store);
+    if (!grouping) {
+        step.clear();
+        step_command_count = 0;
+    }
+    BeginCommand(HistoryCommand_Move, 0, store.uids[index]);
+    const MovePayload move = {
+        UidOf(store, old_parent), UidOf(store, old_before),
+        UidOf(store, store.Parent(index)), UidOf(store, store.NextSibling(index)),
+    };
+    Write(&move, sizeof(move));
+    if (grouping) {
+        group_structural = true;
+        return true;
+    }
+    const bool ok = Commit();
+    open = false;
+    return ok;
+}
+
+bool EditHistory::Commit() {
+    // Steps start 8-byte aligned, their header is read in place
+    const size_t size = (sizeof(StepHeader) + step.size() + 7) & ~(size_t)7;
+    if (size > capacity) {
+        Clear();
+        return false;
+    }
+    if (ring.empty()) {
+        ring.resize(capacity);
+    }
+
+    // A new edit drops the steps that could have been redone
+    if (top != last) {
+        for (ImU32 offset = (top == NONE) ? head : Header(top).next; offset != NONE; offset = Header(offset).next) {
+            bytes_used -= Header(offset).size;
+            step_count--;
+        }
+        last = top;
+        if (top == NONE) {
+            head = NONE;
+        } else {
+            Header(top).next = NONE;
+        }
+    }
+
+    // Steps are contiguous from 'head' to 'last', wrapping around to the start of the ring at most once
+    ImU32 offset;
+    for (;;) {
+        if (head == NONE) {
+            offset = 0;
+            break;
+        }
+        const size_t tail = last + Header(last).size;
+        if (head <= last) {
+            if (tail + size <= capacity) {
+                offset = (ImU32)tail;
+                break;
+            }
+            if (size <= head) {
+                offset = 0;
+                break;
+            }
+        } else if (tail + size <= head) {
+            offset = (ImU32)tail;
+            break;
+        }
+        Evict();
+    }
+
+    StepHeader& header = Header(offset);
+    header.size = (ImU32)size;
+    header.prev = last;
+    header.next = NONE;
+    header.command_count = step_command_count;
+    memcpy(&ring[offset + sizeof(StepHeader)], step.data(), step.size());
+    if (last != NONE) {
+        Header(last).next = offset;
+    }
+    if (head == NONE) {
+        head = offset;
+    }
+    last = top = offset;
+    bytes_used += size;
+    step_count++;
+    open = true;
+    return true;
+}
+
+void EditHistory::Evict() {
+    const StepHeader& header = Header(head);
+    bytes_used -= header.size;
+    step_count--;
+    evicted_steps++;
+    if (top == head) {
+        top = NONE;
+    }
+    if (head == last) {
+        head = last = NONE;
+        return;
+    }
+    head = header.next;
+    Header(head).prev = NONE;
+}
+
+void EditHistory::Apply(ElementStore& store, ImU32 offset, bool undo) {
+    const StepHeader& header = Header(offset);
+    commands.clear();
+    for (ImU32 n = 0, command = offset + sizeof(StepHeader); n < header.command_count; n++) {
+        commands.push_back(command);
+        command += (ImU32)CommandSize(&ring[command]);
+    }
+
+    for (ImU32 n = 0; n < header.command_count; n++) {
+        const unsigned char* data = &ring[commands[undo ? header.command_count - 1 - n : n]];
+        CommandHeader command;
+        memcpy(&command, data, sizeof(command));
+        data += sizeof(command);
+        const ElementIndex index = store.FindByUid(command.uid);
+
+        switch (command.command) {
+        case HistoryCommand_Set:
+            WriteField(store, index, command.field, undo ? data : data + g_FieldSizes[command.field]);
+            break;
+        case HistoryCommand_Move: {
+            MovePayload move;
+            memcpy(&move, data, sizeof(move));
+            store.Move(index, store.FindByUid(undo ? move.old_parent : move.new_parent), store.FindByUid(undo ? move.old_before : move.new_before));
+            break;
+        }
+        case HistoryCommand_Insert:
+        case HistoryCommand_Remove:
+            if ((command.command == HistoryCommand_Insert) == undo) {
+                store.Remove(index);
+            } else {
+                SubtreeHeader subtree;
+                memcpy(&subtree, data, sizeof(subtree));
+                data += sizeof(subtree);
+                store.Reserve((int)subtree.count);
+                const ElementIndex root = RestoreSubtree(store, data);
+                store.Insert(store.FindByUid(subtree.parent), store.FindByUid(subtree.before), root);
+            }
+            break;
+        }
+    }
+}
+
+bool EditHistory::Undo(ElementStore& store) {
+    if (!CheckGeneration(store) || top == NONE) {
+        return false;
+    }
+    Apply(store, top, true);
+    top = Header(top).prev;
+    open = false;
+    return true;
+}
+
+bool EditHistory::Redo(ElementStore& store) {
+    if (!CheckGeneration(store) || !CanRedo()) {
+        return false;
+    }
+    top = (top == NONE) ? head : Header(top).next;
+    Apply(store, top, false);
+    open = false;
+    return true;
+}
+
+void EditHistory::Clear() {
+    head = last = top = NONE;
+    bytes_used = 0;
+    step_count = 0;
+    evicted_steps = 0;
+    merged_edits = 0;
+    open = false;
+}
+
+void EditHistory::SetCapacity(size_t new_capacity) {
+    Clear();
+    capacity = new_capacity;
+    std::vector<unsigned char>().swap(ring);
+}
+
+EditHistoryStats EditHistory::GetStats() const {
+    EditHistoryStats stats;
+    stats.steps = step_count;
+    for (ImU32 offset = top; offset != NONE; offset = Header(offset).prev) {
+        stats.undo_steps++;
+    }
+    stats.redo_steps = step_count - stats.undo_steps;
+    stats.evicted_steps = evicted_steps;
+    stats.merged_edits = merged_edits;
+    stats.bytes_used = bytes_used;
+    stats.capacity = capacity;
+    return stats;
+}
@@ -0,0 +1,108 @@
+// ULTIMATE ImGui Builder: undo/redo
+// The history is a log of steps, each step a few commands holding the minimal diff of one edit:
+// - property edits store the field that changed with its old and new bytes. Strings and combo item lists are
+//   interned and never modified in place, so even they are a fixed-size diff (a pointer, a range of the item pool);
+// - structural edits store where the element was (parent and next sibling) and, for insert/remove, a flat
+//   pre-order snapshot of its subtree.
+// Elements are named by uid, so a step still applies after the slots were reused. Undoing a property edit is O(1),
+// a structural edit O(size of the subtree), whatever the size of the document.
+// Steps are packed into one ring buffer of fixed capacity: recording a step evicts the oldest ones until it fits,
+// so a long session keeps as many steps as the budget holds and never allocates after the first one.
+// Consecutive edits of the same field (a drag, typing into a text box) are compacted into a single step until
+// Seal() is called, typically once no widget is active anymore.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <vector>
+
+struct EditHistoryStats {
+    int steps = 0;                  // Steps in the ring (undo + redo)
+    int undo_steps = 0;
+    int redo_steps = 0;
+    int evicted_steps = 0;          // Oldest steps dropped to make room, since the last Clear()
+    int merged_edits = 0;           // Edits compacted into the step before them
+    size_t bytes_used = 0;
+    size_t capacity = 0;
+};
+
+class EditHistory {
+public:
+    explicit EditHistory(size_t capacity = 1024 * 1024);
+
+    // Property edits: call BeginEdit() before widgets may write the element, EndEdit() after them.
+    // The fields that differ become one step.
+    void BeginEdit(const ElementStore& store, ElementIndex index);
+    void EndEdit(const ElementStore& store);
+    // Edits of several elements as one step (renaming a component renames its instances, making one inserts it
+    // and its instance then moves the element in): the BeginEdit() / EndEdit() pairs and structural edits between
+    // BeginGroup() and EndGroup() add to the same step, undone in reverse order. Groups do not nest.
+    void BeginGroup();
+    void EndGroup();
+
+    // Structural edits. RecordInsert(): after 'index' was linked. RecordRemove(): before it is removed.
+    // RecordMove(): after a successful ElementStore::Move(), with where the element was before it.
+    // False if the step does not fit in the whole buffer: the history is cleared, the edit cannot be undone.
+    // Within a group the step is only committed by EndGroup(): they return true.
+    bool RecordInsert(const ElementStore& store, ElementIndex index);
+    bool RecordRemove(const ElementStore& store, ElementIndex index);
+    bool RecordMove(const ElementStore& store, ElementIndex index, ElementIndex old_parent, ElementIndex old_before);
+
+    // End the current step: the next edit starts a new one even if it changes the same field.
+    void Seal() { open = false; }
+
+    bool CanUndo() const { return top != NONE; }
+    bool CanRedo() const { return (top == NONE ? head : Header(top).next) != NONE; }
+    bool Undo(ElementStore& store);
+    bool Redo(ElementStore& store);
+
+    void Clear();
+    // Change the byte budget (clears the history)
+    void SetCapacity(size_t capacity);
+    EditHistoryStats GetStats() const;
+
+private:
+    static const ImU32 NONE = 0xFFFFFFFF;
+
+    // Start of every step in the ring
+    struct StepHeader {
+        ImU32 size;                 // Whole step, header included
+        ImU32 prev;                 // Offset of the step before, NONE for the oldest
+        ImU32 next;                 // Offset of the step after, NONE for the newest
+        ImU32 command_count;
+    };
+
+    StepHeader& Header(ImU32 offset) { return *(StepHeader*)&ring[offset]; }
+    const StepHeader& Header(ImU32 offset) const { return *(const StepHeader*)&ring[offset]; }
+    bool CheckGeneration(const ElementStore& store);
+    void BeginCommand(ImU32 command, ImU32 field, ElementUid uid);
+    void Write(const void* data, size_t size);
+    int WriteSubtree(const ElementStore& store, ElementIndex index);
+    bool RecordSubtree(const ElementStore& store, ElementIndex index, ImU32 command);
+    bool Commit();
+    bool MergeIntoTop();
+    void Evict();
+    void Apply(ElementStore& store, ImU32 offset, bool undo);
+
+    std::vector<unsigned char> ring;    // Allocated on the first step
+    size_t capacity;
+    ImU32 head = NONE;                  // Oldest step
+    ImU32 last = NONE;                  // Newest step
+    ImU32 top = NONE;                   // Newest step applied: Undo() reverts it, Redo() applies the one after
+    size_t bytes_used = 0;
+    int step_count = 0;
+    int evicted_steps = 0;
+    int merged_edits = 0;
+    bool open = false;                  // The newest step may still absorb edits of the same field
+    ImU32 string_generation = 0;        // Steps hold interned strings of this pool generation
+
+    std::vector<unsigned char> step;    // Step being recorded
+    bool grouping = false;              // Between BeginGroup() and EndGroup()
+    bool group_structural = false;      // The group recorded a structural edit: never merged into the step before
+    ImU32 step_command_count = 0;
+    std::vector<ImU32> commands;        // Offsets of the commands of the step being applied
+    // BeginEdit() state
+    ElementUid edit_uid = ElementUid_None;
+    std::vector<unsigned char> edit_before;
+};
@@ -0,0 +1,146 @@
+// ULTIMATE ImGui Builder: work-stealing thread pool
+// See imgui_builder_jobs.h
+
+#include "imgui_builder_jobs.h"
+
+ThreadPool::ThreadPool(int count) : steal_count(0) {
+    if (count <= 0) {
+        count = (int)std::thread::hardware_concurrency();
+    }
+    thread_count = count < 1 ? 1 : count;
+    ranges.reset(new Range[thread_count]);
+    workers.reserve(thread_count - 1);
+    for (int thread = 1; thread < thread_count; thread++) {
+        workers.emplace_back(&ThreadPool::WorkerMain, this, thread);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int, int)>& loop_job) {
+    steal_count = 0;
+    if (count <= 0) {
+        return;
+    }
+    if (thread_count == 1 || count == 1) {
+        for (int index = 0; index < count; index++) {
+            loop_job(index, 0);
+        }
+        return;
+    }
+
+    for (int thread = 0; thread < thread_count; thread++) {
+        Range& range = ranges[thread];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        range.begin = (int)((long long)count * thread / thread_count);
+        range.end = (int)((long long)count * (thread + 1) / thread_count);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &loop_job;
+        generation++;
+    }
+    wake.notify_all();
+
+    RunJobs(loop_job, 0);
+
+    // Every index was started by someone: wait for the workers still running theirs.
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return active == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::WorkerMain(int thread) {
+    unsigned int seen_generation = 0;
+    for (;;) {
+        const std::function<void(int, int)>* loop_job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stop || generation != seen_generation; });
+            if (stop) {
+                return;
+            }
+            seen_generation = generation;
+            // Woken after the loop already ended
+            if (!job) {
+                continue;
+            }
+            loop_job = job;
+            active++;
+        }
+
+        RunJobs(*loop_job, thread);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            active--;
+        }
+        done.notify_one();
+    }
+}
+
+void ThreadPool::RunJobs(const std::function<void(int, int)>& loop_job, int thread) {
+    Range& own = ranges[thread];
+    for (;;) {
+        int index = -1;
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.begin < own.end) {
+                index = own.begin++;
+            }
+        }
+        if (index >= 0) {
+            loop_job(index, thread);
+        } else if (!Steal(thread)) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::Steal(int thread) {
+    // Sizes read without locking are only a hint for picking the victim: the steal itself is checked under its lock.
+    for (;;) {
+        int victim = -1;
+        int victim_size = 0;
+        for (int other = 0; other < thread_count; other++) {
+            const int size = ranges[other].end - ranges[other].begin;
+            if (other != thread && size > victim_size) {
+                victim = other;
+                victim_size = size;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+
+        int begin, end;
+        {
+            Range& range = ranges[victim];
+            std::lock_guard<std::mutex> lock(range.mutex);
+            if (range.begin >= range.end) {
+                continue;
+            }
+            // Take the back half: the victim keeps going through its front half undisturbed
+            begin = range.begin + (range.end - range.begin) / 2;
+            end = range.end;
+            range.end = begin;
+        }
+        {
+            Range& own = ranges[thread];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin;
+            own.end = end;
+        }
+        steal_count++;
+        return true;
+    }
+}
@@ -0,0 +1,61 @@
+// ULTIMATE ImGui Builder: work-stealing thread pool
+// ParallelFor() splits the indices of a loop into one contiguous range per thread (the calling thread included).
+// Each thread takes indices from the front of its own range; a thread that runs out steals the back half of the
+// largest range left, so uneven jobs keep every thread busy until the loop is done.
+// The pool only decides who runs which index: results written per index come out the same whatever the number
+// of threads or the stealing order.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // 'thread_count' includes the calling thread. 0: one per hardware thread.
+    explicit ThreadPool(int thread_count = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int GetThreadCount() const { return thread_count; }
+
+    // Call job(index, thread) for every index in [0, count) and return once every call returned.
+    // 'thread' is in [0, GetThreadCount()), 0 being the calling thread: use it to pick per-thread scratch data.
+    // One loop at a time: do not call ParallelFor() from a job or from two threads at once.
+    void ParallelFor(int count, const std::function<void(int index, int thread)>& job);
+
+    // Ranges taken from another thread by the last ParallelFor()
+    int GetStealCount() const { return steal_count.load(); }
+
+private:
+    // Indices [begin, end) not started yet. Changed under 'mutex' only, atomic so that thieves can look at the
+    // size of every range without locking them all.
+    struct Range {
+        std::mutex mutex;
+        std::atomic<int> begin{ 0 };
+        std::atomic<int> end{ 0 };
+    };
+
+    void WorkerMain(int thread);
+    void RunJobs(const std::function<void(int, int)>& job, int thread);
+    bool Steal(int thread);
+
+    int thread_count = 1;
+    std::unique_ptr<Range[]> ranges;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;           // A loop started, or the pool is shutting down
+    std::condition_variable done;           // A worker left the current loop
+    const std::function<void(int, int)>* job = nullptr;
+    unsigned int generation = 0;            // Loops started so far
+    int active = 0;                         // Workers inside the current loop
+    bool stop = false;
+    std::atomic<int> steal_count;
+};
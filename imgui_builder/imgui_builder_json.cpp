@@ -0,0 +1,981 @@
+// ULTIMATE ImGui Builder: JSON project files
+// See imgui_builder_json.h
+
+#include "imgui_builder_json.h"
+#include "imgui_builder_project.h"
+#include "imgui_builder_types.h"
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+
+// Deeper documents are rejected rather than risking the loader's recursion
+static const int JSON_MAX_ELEMENT_DEPTH = 1024;
+
+//-----------------------------------------------------------------------------
+// JsonWriter
+//-----------------------------------------------------------------------------
+
+JsonWriter::JsonWriter(FILE* f) : file(f) {
+}
+
+bool JsonWriter::Flush() {
+    if (used > 0 && !failed) {
+        failed = fwrite(buffer, 1, used, file) != used;
+    }
+    bytes_written += used;
+    used = 0;
+    return !failed;
+}
+
+void JsonWriter::Write(const char* str, size_t length) {
+    while (length > 0) {
+        if (used == JSON_BUFFER_SIZE) {
+            Flush();
+        }
+        size_t count = JSON_BUFFER_SIZE - used;
+        if (count > length) {
+            count = length;
+        }
+        memcpy(buffer + used, str, count);
+        used += count;
+        str += count;
+        length -= count;
+    }
+}
+
+void JsonWriter::NewLine() {
+    WriteChar('\n');
+    for (size_t n = 0; n < scopes.size(); n++) {
+        Write("  ", 2);
+    }
+}
+
+void JsonWriter::BeforeValue() {
+    if (after_key) {
+        after_key = false;
+        return;
+    }
+    if (scopes.empty()) {
+        return;
+    }
+    Scope& scope = scopes.back();
+    if (scope.has_items) {
+        WriteChar(',');
+    }
+    if (!scope.single_line) {
+        NewLine();
+    } else if (scope.has_items) {
+        WriteChar(' ');
+    }
+    scope.has_items = true;
+}
+
+void JsonWriter::BeginObject() {
+    BeforeValue();
+    WriteChar('{');
+    scopes.push_back({ false, false });
+}
+
+void JsonWriter::EndObject() {
+    const Scope scope = scopes.back();
+    scopes.pop_back();
+    if (scope.has_items) {
+        NewLine();
+    }
+    WriteChar('}');
+    if (scopes.empty()) {
+        WriteChar('\n');
+    }
+}
+
+void JsonWriter::BeginArray(bool single_line) {
+    BeforeValue();
+    WriteChar('[');
+    scopes.push_back({ single_line, false });
+}
+
+void JsonWriter::EndArray() {
+    const Scope scope = scopes.back();
+    scopes.pop_back();
+    if (scope.has_items && !scope.single_line) {
+        NewLine();
+    }
+    WriteChar(']');
+}
+
+void JsonWriter::Key(const char* key) {
+    String(key);
+    Write(": ", 2);
+    after_key = true;
+}
+
+void JsonWriter::String(const char* str) {
+    static const char hex[] = "0123456789abcdef";
+    BeforeValue();
+    WriteChar('"');
+    const char* run = str;
+    for (const char* p = str; *p; p++) {
+        const unsigned char c = (unsigned char)*p;
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        Write(run, (size_t)(p - run));
+        run = p + 1;
+        switch (c) {
+        case '"': Write("\\\"", 2); break;
+        case '\\': Write("\\\\", 2); break;
+        case '\n': Write("\\n", 2); break;
+        case '\r': Write("\\r", 2); break;
+        case '\t': Write("\\t", 2); break;
+        default: {
+            const char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+            Write(escape, 6);
+            break;
+        }
+        }
+    }
+    Write(run, strlen(run));
+    WriteChar('"');
+}
+
+// Digits are produced backward from the end of 'buf_end'
+static char* FormatUnsigned(char* buf_end, ImU64 value) {
+    char* p = buf_end;
+    do {
+        *--p = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return p;
+}
+
+static char* FormatInt(char* buf_end, int value) {
+    char* p = FormatUnsigned(buf_end, value < 0 ? 0u - (unsigned int)value : (unsigned int)value);
+    if (value < 0) {
+        *--p = '-';
+    }
+    return p;
+}
+
+void JsonWriter::Int(int value) {
+    BeforeValue();
+    char buf[16];
+    const char* str = FormatInt(buf + sizeof(buf), value);
+    Write(str, (size_t)(buf + sizeof(buf) - str));
+}
+
+void JsonWriter::Uint(ImU64 value) {
+    BeforeValue();
+    char buf[24];
+    const char* str = FormatUnsigned(buf + sizeof(buf), value);
+    Write(str, (size_t)(buf + sizeof(buf) - str));
+}
+
+void JsonWriter::Float(float value) {
+    BeforeValue();
+    // JSON has no NaN/Inf
+    if (value != value) {
+        value = 0.0f;
+    } else if (value > FLT_MAX) {
+        value = FLT_MAX;
+    } else if (value < -FLT_MAX) {
+        value = -FLT_MAX;
+    }
+    // Whole numbers are by far the most common (sizes, ranges, colors): skip printf
+    char buf[32];
+    if (value >= -1e7f && value <= 1e7f && value == (float)(int)value && !(value == 0.0f && signbit(value))) {
+        const char* str = FormatInt(buf + sizeof(buf), (int)value);
+        Write(str, (size_t)(buf + sizeof(buf) - str));
+        return;
+    }
+    // Shortest form that reads back to the same float: "0.2" rather than "0.200000003"
+    int length = snprintf(buf, sizeof(buf), "%.6g", value);
+    if (strtof(buf, nullptr) != value) {
+        length = snprintf(buf, sizeof(buf), "%.9g", value);
+    }
+    Write(buf, (size_t)length);
+}
+
+void JsonWriter::Double(double value) {
+    BeforeValue();
+    if (value != value) {
+        value = 0.0;
+    } else if (value > DBL_MAX) {
+        value = DBL_MAX;
+    } else if (value < -DBL_MAX) {
+        value = -DBL_MAX;
+    }
+    char buf[32];
+    int length = snprintf(buf, sizeof(buf), "%.15g", value);
+    if (strtod(buf, nullptr) != value) {
+        length = snprintf(buf, sizeof(buf), "%.17g", value);
+    }
+    Write(buf, (size_t)length);
+}
+
+void JsonWriter::Bool(bool value) {
+    BeforeValue();
+    if (value) {
+        Write("true", 4);
+    } else {
+        Write("false", 5);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// JsonReader
+//-----------------------------------------------------------------------------
+
+JsonReader::JsonReader(FILE* f) : file(f) {
+}
+
+bool JsonReader::Refill() {
+    pos = 0;
+    end = fread(buffer, 1, JSON_BUFFER_SIZE, file);
+    bytes_read += end;
+    return end > 0;
+}
+
+void JsonReader::SkipWhitespace() {
+    for (;;) {
+        const int c = Peek();
+        if (c == '\n') {
+            line++;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            return;
+        }
+        pos++;
+    }
+}
+
+JsonToken JsonReader::Fail(const char* message) {
+    if (!error) {
+        error = message;
+    }
+    return JsonToken::Error;
+}
+
+JsonToken JsonReader::ValueDone(JsonToken token) {
+    after_value = true;
+    if (containers.empty()) {
+        root_done = true;
+    }
+    return token;
+}
+
+JsonToken JsonReader::CloseContainer() {
+    const char container = containers.back();
+    containers.pop_back();
+    return ValueDone(container == '{' ? JsonToken::ObjectEnd : JsonToken::ArrayEnd);
+}
+
+JsonToken JsonReader::Next() {
+    if (error) {
+        return JsonToken::Error;
+    }
+    SkipWhitespace();
+    if (value_expected) {
+        value_expected = false;
+        return ParseValue(Get());
+    }
+    if (containers.empty()) {
+        if (!root_done) {
+            return ParseValue(Get());
+        }
+        return Peek() < 0 ? JsonToken::End : Fail("Unexpected data after the document");
+    }
+
+    const bool in_object = containers.back() == '{';
+    const int closer = in_object ? '}' : ']';
+    int c = Get();
+    if (after_value) {
+        if (c == closer) {
+            return CloseContainer();
+        }
+        if (c != ',') {
+            return Fail(c < 0 ? "Unexpected end of file" : "Expected ',' or closing bracket");
+        }
+        after_value = false;
+        need_item = true;
+        SkipWhitespace();
+        c = Get();
+    } else if (c == closer && !need_item) {
+        return CloseContainer();
+    }
+    need_item = false;
+
+    if (!in_object) {
+        return ParseValue(c);
+    }
+    if (c != '"') {
+        return Fail(c < 0 ? "Unexpected end of file" : "Expected a key");
+    }
+    if (!ParseString()) {
+        return JsonToken::Error;
+    }
+    SkipWhitespace();
+    if (Get() != ':') {
+        return Fail("Expected ':'");
+    }
+    value_expected = true;
+    return JsonToken::Key;
+}
+
+JsonToken JsonReader::ParseValue(int c) {
+    switch (c) {
+    case '{':
+    case '[':
+        containers.push_back((char)c);
+        after_value = false;
+        need_item = false;
+        return c == '{' ? JsonToken::ObjectBegin : JsonToken::ArrayBegin;
+    case '"':
+        return ParseString() ? ValueDone(JsonToken::String) : JsonToken::Error;
+    case 't':
+        return ParseLiteral("rue") ? ValueDone(JsonToken::True) : JsonToken::Error;
+    case 'f':
+        return ParseLiteral("alse") ? ValueDone(JsonToken::False) : JsonToken::Error;
+    case 'n':
+        return ParseLiteral("ull") ? ValueDone(JsonToken::Null) : JsonToken::Error;
+    case -1:
+        return Fail("Unexpected end of file");
+    default:
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            return ParseNumber(c) ? ValueDone(JsonToken::Number) : JsonToken::Error;
+        }
+        return Fail("Unexpected character");
+    }
+}
+
+static int ParseHexDigit(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool JsonReader::ParseString() {
+    text.clear();
+    for (;;) {
+        if (pos == end && !Refill()) {
+            Fail("Unterminated string");
+            return false;
+        }
+        // Copy runs of plain characters straight from the read buffer
+        size_t run = pos;
+        while (run < end) {
+            const unsigned char c = (unsigned char)buffer[run];
+            if (c == '"' || c == '\\' || c < 0x20) {
+                break;
+            }
+            run++;
+        }
+        text.append(buffer + pos, run - pos);
+        pos = run;
+        if (pos == end) {
+            continue;
+        }
+
+        const unsigned char c = (unsigned char)buffer[pos++];
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\') {
+            Fail("Control character in string");
+            return false;
+        }
+        const int escape = Get();
+        switch (escape) {
+        case '"': text += '"'; break;
+        case '\\': text += '\\'; break;
+        case '/': text += '/'; break;
+        case 'b': text += '\b'; break;
+        case 'f': text += '\f'; break;
+        case 'n': text += '\n'; break;
+        case 'r': text += '\r'; break;
+        case 't': text += '\t'; break;
+        case 'u': {
+            unsigned int codepoint = 0;
+            for (int surrogate = 0; surrogate < 2; surrogate++) {
+                unsigned int unit = 0;
+                for (int n = 0; n < 4; n++) {
+                    const int digit = ParseHexDigit(Get());
+                    if (digit < 0) {
+                        Fail("Invalid \\u escape");
+                        return false;
+                    }
+                    unit = (unit << 4) | (unsigned int)digit;
+                }
+                if (surrogate == 0) {
+                    codepoint = unit;
+                    if (unit < 0xD800 || unit > 0xDBFF) {
+                        break;
+                    }
+                    if (Get() != '\\' || Get() != 'u') {
+                        Fail("Invalid \\u escape");
+                        return false;
+                    }
+                } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (unit - 0xDC00);
+                } else {
+                    Fail("Invalid \\u escape");
+                    return false;
+                }
+            }
+            if (codepoint == 0 || (codepoint >= 0xDC00 && codepoint <= 0xDFFF)) {
+                // Strings are zero-terminated
+                Fail("Invalid \\u escape");
+                return false;
+            }
+            if (codepoint < 0x80) {
+                text += (char)codepoint;
+            } else if (codepoint < 0x800) {
+                text += (char)(0xC0 | (codepoint >> 6));
+                text += (char)(0x80 | (codepoint & 0x3F));
+            } else if (codepoint < 0x10000) {
+                text += (char)(0xE0 | (codepoint >> 12));
+                text += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+                text += (char)(0x80 | (codepoint & 0x3F));
+            } else {
+                text += (char)(0xF0 | (codepoint >> 18));
+                text += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+                text += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+                text += (char)(0x80 | (codepoint & 0x3F));
+            }
+            break;
+        }
+        default:
+            Fail(escape < 0 ? "Unterminated string" : "Invalid escape sequence");
+            return false;
+        }
+    }
+}
+
+bool JsonReader::ParseNumber(int c) {
+    char buf[64];
+    int length = 0;
+    buf[length++] = (char)c;
+    for (;;) {
+        c = Peek();
+        if (!((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')) {
+            break;
+        }
+        if (length == (int)sizeof(buf) - 1) {
+            Fail("Invalid number");
+            return false;
+        }
+        buf[length++] = (char)Get();
+    }
+    buf[length] = 0;
+    char* buf_end = nullptr;
+    number = strtod(buf, &buf_end);
+    if (buf_end != buf + length) {
+        Fail("Invalid number");
+        return false;
+    }
+    return true;
+}
+
+bool JsonReader::ParseLiteral(const char* rest) {
+    for (; *rest; rest++) {
+        if (Get() != *rest) {
+            Fail("Invalid literal");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JsonReader::SkipValue(JsonToken first) {
+    if (first == JsonToken::Error) {
+        return false;
+    }
+    int depth = (first == JsonToken::ObjectBegin || first == JsonToken::ArrayBegin) ? 1 : 0;
+    while (depth > 0) {
+        switch (Next()) {
+        case JsonToken::ObjectBegin:
+        case JsonToken::ArrayBegin:
+            depth++;
+            break;
+        case JsonToken::ObjectEnd:
+        case JsonToken::ArrayEnd:
+            depth--;
+            break;
+        case JsonToken::Error:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Save
+//-----------------------------------------------------------------------------
+
+static void WriteColor(JsonWriter& writer, const char* key, const ImVec4& color) {
+    writer.Key(key);
+    writer.BeginArray(true);
+    writer.Float(color.x);
+    writer.Float(color.y);
+    writer.Float(color.z);
+    writer.Float(color.w);
+    writer.EndArray();
+}
+
+static void WriteElement(JsonWriter& writer, const ElementStore& store, ElementIndex index) {
+    const ImU32 flags = store.flags[index];
+    const ElementValues value = store.GetValues(index);
+    const ElementStrings& strings = store.strings[index];
+    const ElementStyle& style = store.styles[index];
+    const int item_count = store.GetItemCount(index);
+
+    writer.BeginObject();
+    writer.Key("type");
+    writer.String(GetElementTypeName(store.types[index]));
+    writer.Key("label");
+    writer.String(strings.label);
+    writer.Key("uid");
+    writer.Uint(store.uids[index]);
+    writer.Key("enabled");
+    writer.Bool((flags & ElementFlags_Enabled) != 0);
+    writer.Key("visible");
+    writer.Bool((flags & ElementFlags_Visible) != 0);
+    writer.Key("bool_value");
+    writer.Bool((flags & ElementFlags_BoolValue) != 0);
+    writer.Key("is_open");
+    writer.Bool((flags & ElementFlags_Open) != 0);
+    writer.Key("int_value");
+    writer.Int(value.int_value);
+    writer.Key("float_value");
+    writer.Float(value.float_value);
+    writer.Key("min_value");
+    writer.Float(value.min_value);
+    writer.Key("max_value");
+    writer.Float(value.max_value);
+    writer.Key("selected_item");
+    writer.Int(value.selected_item);
+    writer.Key("text_value");
+    writer.String(strings.text_value);
+    if (HasPayload(store.types[index], ElementPayload_Color)) {
+        WriteColor(writer, "color_value", store.GetColor(index));
+    }
+    writer.Key("size");
+    writer.BeginArray(true);
+    writer.Float(style.size.x);
+    writer.Float(style.size.y);
+    writer.EndArray();
+    WriteColor(writer, "text_color", style.text_color);
+    WriteColor(writer, "bg_color", style.bg_color);
+
+    if (item_count > 0) {
+        const char* const* items = store.GetItems(index);
+        writer.Key("combo_items");
+        writer.BeginArray(true);
+        for (int n = 0; n < item_count; n++) {
+            writer.String(items[n]);
+        }
+        writer.EndArray();
+    }
+    if (store.FirstChild(index) != ElementIndex_None) {
+        writer.Key("children");
+        writer.BeginArray();
+        for (ElementIndex child = store.FirstChild(index); child != ElementIndex_None; child = store.NextSibling(child)) {
+            WriteElement(writer, store, child);
+        }
+        writer.EndArray();
+    }
+    writer.EndObject();
+}
+
+bool SaveProjectJson(const ElementStore& store, const char* name, const char* path, std::string* error) {
+    std::string temp_path = path;
+    temp_path += ".tmp";
+    FILE* f = fopen(temp_path.c_str(), "wb");
+    if (!f) {
+        if (error) *error = "Cannot write file: " + temp_path;
+        return false;
+    }
+
+    bool ok;
+    {
+        std::unique_ptr<JsonWriter> writer(new JsonWriter(f));
+        writer->BeginObject();
+        writer->Key("format");
+        writer->String(PROJECT_JSON_FORMAT);
+        writer->Key("version");
+        writer->Int(PROJECT_JSON_VERSION);
+        writer->Key("name");
+        writer->String(name);
+        writer->Key("elements");
+        writer->BeginArray();
+        for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+            WriteElement(*writer, store, root);
+        }
+        writer->EndArray();
+        writer->EndObject();
+        ok = writer->Flush();
+    }
+    ok = (fclose(f) == 0) && ok;
+    ok = ok && ReplaceProjectFile(temp_path.c_str(), path);
+    if (!ok) {
+        remove(temp_path.c_str());
+        if (error) {
+            *error = "Cannot write file: ";
+            *error += path;
+        }
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Load
+//-----------------------------------------------------------------------------
+
+namespace {
+enum JsonField {
+    JsonField_Unknown,
+    JsonField_Type,
+    JsonField_Label,
+    JsonField_Uid,
+    JsonField_Enabled,
+    JsonField_Visible,
+    JsonField_BoolValue,
+    JsonField_IsOpen,
+    JsonField_IntValue,
+    JsonField_FloatValue,
+    JsonField_MinValue,
+    JsonField_MaxValue,
+    JsonField_SelectedItem,
+    JsonField_TextValue,
+    JsonField_ColorValue,
+    JsonField_Size,
+    JsonField_TextColor,
+    JsonField_BgColor,
+    JsonField_ComboItems,
+    JsonField_Children,
+};
+
+struct JsonFieldName {
+    const char* name;
+    JsonField field;
+};
+
+static const JsonFieldName g_JsonFields[] = {
+    { "type", JsonField_Type },
+    { "label", JsonField_Label },
+    { "uid", JsonField_Uid },
+    { "enabled", JsonField_Enabled },
+    { "visible", JsonField_Visible },
+    { "bool_value", JsonField_BoolValue },
+    { "is_open", JsonField_IsOpen },
+    { "int_value", JsonField_IntValue },
+    { "float_value", JsonField_FloatValue },
+    { "min_value", JsonField_MinValue },
+    { "max_value", JsonField_MaxValue },
+    { "selected_item", JsonField_SelectedItem },
+    { "text_value", JsonField_TextValue },
+    { "color_value", JsonField_ColorValue },
+    { "size", JsonField_Size },
+    { "text_color", JsonField_TextColor },
+    { "bg_color", JsonField_BgColor },
+    { "combo_items", JsonField_ComboItems },
+    { "children", JsonField_Children },
+};
+
+static JsonField FindJsonField(const char* key) {
+    for (const JsonFieldName& entry : g_JsonFields) {
+        if (strcmp(entry.name, key) == 0) {
+            return entry.field;
+        }
+    }
+    return JsonField_Unknown;
+}
+
+// Reads a document into 'store' token by token: elements are created as their object begins.
+struct JsonProjectLoader {
+    JsonReader& reader;
+    ElementStore& store;
+    const char* name = "";
+    const char* failure = nullptr;
+
+    JsonProjectLoader(JsonReader& r, ElementStore& s) : reader(r), store(s) {}
+
+    bool Fail(const char* message) {
+        if (!failure) {
+            failure = reader.GetError() ? reader.GetError() : message;
+        }
+        return false;
+    }
+
+    bool Expect(JsonToken token, const char* message) {
+        return reader.Next() == token || Fail(message);
+    }
+
+    bool ReadString(const char** out) {
+        if (reader.Next() != JsonToken::String) {
+            return Fail("Expected a string");
+        }
+        *out = store.string_pool.Intern(reader.GetString(), reader.GetString() + reader.GetStringLength());
+        return true;
+    }
+
+    bool ReadNumber(double* out) {
+        if (reader.Next() != JsonToken::Number) {
+            return Fail("Expected a number");
+        }
+        *out = reader.GetNumber();
+        return true;
+    }
+
+    bool ReadInt(int* out) {
+        double value;
+        if (!ReadNumber(&value)) {
+            return false;
+        }
+        *out = value <= (double)INT_MIN ? INT_MIN : value >= (double)INT_MAX ? INT_MAX : (int)value;
+        return true;
+    }
+
+    bool ReadFloat(float* out) {
+        double value;
+        if (!ReadNumber(&value)) {
+            return false;
+        }
+        *out = (float)value;
+        return true;
+    }
+
+    // Numbers are read as doubles: uids up to 2^53, far more than a document can ever hand out
+    bool ReadUid(ElementIndex index) {
+        double value;
+        if (!ReadNumber(&value)) {
+            return false;
+        }
+        if (!(value >= 1.0 && value <= 9007199254740992.0) || value != (double)(ElementUid)value) {
+            return Fail("Invalid uid");
+        }
+        store.SetUid(index, (ElementUid)value);
+        return true;
+    }
+
+    bool ReadFloats(float* out, int count) {
+        if (!Expect(JsonToken::ArrayBegin, "Expected an array of numbers")) {
+            return false;
+        }
+        for (int n = 0; n < count; n++) {
+            if (!ReadFloat(&out[n])) {
+                return false;
+            }
+        }
+        return Expect(JsonToken::ArrayEnd, "Too many numbers in array");
+    }
+
+    bool ReadFlag(ElementIndex index, ImU32 flag) {
+        const JsonToken token = reader.Next();
+        if (token != JsonToken::True && token != JsonToken::False) {
+            return Fail("Expected true or false");
+        }
+        store.flags[index] = (token == JsonToken::True) ? (store.flags[index] | flag) : (store.flags[index] & ~flag);
+        return true;
+    }
+
+    // Appended to the item pool as one range, which the element takes once its type is known
+    bool ReadItems(ElementItemList* items) {
+        if (!Expect(JsonToken::ArrayBegin, "Expected an array of strings")) {
+            return false;
+        }
+        items->offset = (int)store.item_pool.size();
+        items->count = 0;
+        for (;;) {
+            const JsonToken token = reader.Next();
+            if (token == JsonToken::ArrayEnd) {
+                return true;
+            }
+            if (token != JsonToken::String) {
+                return Fail("Expected a string");
+            }
+            const int item = store.AllocItems(1);
+            store.item_pool[item] = store.string_pool.Intern(reader.GetString());
+            items->count++;
+        }
+    }
+
+    bool ReadElements(ElementIndex parent, int depth) {
+        if (!Expect(JsonToken::ArrayBegin, "Expected an array of elements")) {
+            return false;
+        }
+        for (;;) {
+            const JsonToken token = reader.Next();
+            if (token == JsonToken::ArrayEnd) {
+                return true;
+            }
+            if (token != JsonToken::ObjectBegin) {
+                return Fail("Expected an element");
+            }
+            if (!ReadElement(parent, depth)) {
+                return false;
+            }
+        }
+    }
+
+    // The element's '{' has been read
+    bool ReadElement(ElementIndex parent, int depth) {
+        if (depth >= JSON_MAX_ELEMENT_DEPTH) {
+            return Fail("Elements nested too deeply");
+        }
+        const ElementIndex index = store.Create(ElementType::TEXT);
+        store.Append(parent, index);
+        bool has_type = false;
+        ElementType type = ElementType::TEXT;
+        // Payloads of the type, which may come after them
+        ElementValues values;
+        ElementItemList items;
+        ImVec4 color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+
+        // Slot arrays may grow while children are read: no references across fields
+        for (;;) {
+            const JsonToken token = reader.Next();
+            if (token == JsonToken::ObjectEnd) {
+                break;
+            }
+            if (token != JsonToken::Key) {
+                return Fail("Expected a key");
+            }
+            bool ok = true;
+            switch (FindJsonField(reader.GetString())) {
+            case JsonField_Type:
+                if (reader.Next() != JsonToken::String || !FindElementTypeByName(reader.GetString(), &type)) {
+                    return Fail("Unknown element type");
+                }
+                has_type = true;
+                break;
+            case JsonField_Label: ok = ReadString(&store.strings[index].label); break;
+            case JsonField_Uid: ok = ReadUid(index); break;
+            case JsonField_TextValue: ok = ReadString(&store.strings[index].text_value); break;
+            case JsonField_Enabled: ok = ReadFlag(index, ElementFlags_Enabled); break;
+            case JsonField_Visible: ok = ReadFlag(index, ElementFlags_Visible); break;
+            case JsonField_BoolValue: ok = ReadFlag(index, ElementFlags_BoolValue); break;
+            case JsonField_IsOpen: ok = ReadFlag(index, ElementFlags_Open); break;
+            case JsonField_IntValue: ok = ReadInt(&values.int_value); break;
+            case JsonField_SelectedItem: ok = ReadInt(&values.selected_item); break;
+            case JsonField_FloatValue: ok = ReadFloat(&values.float_value); break;
+            case JsonField_MinValue: ok = ReadFloat(&values.min_value); break;
+            case JsonField_MaxValue: ok = ReadFloat(&values.max_value); break;
+            case JsonField_ColorValue: ok = ReadFloats(&color.x, 4); break;
+            case JsonField_Size: ok = ReadFloats(&store.styles[index].size.x, 2); break;
+            case JsonField_TextColor: ok = ReadFloats(&store.styles[index].text_color.x, 4); break;
+            case JsonField_BgColor: ok = ReadFloats(&store.styles[index].bg_color.x, 4); break;
+            case JsonField_ComboItems: ok = ReadItems(&items); break;
+            case JsonField_Children: ok = ReadElements(index, depth + 1); break;
+            case JsonField_Unknown:
+                ok = reader.SkipValue(reader.Next()) || Fail("Invalid value");
+                break;
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        if (!has_type) {
+            return Fail("Element without a type");
+        }
+        // Fields come in any order: the selected item is checked against the items once both are read
+        const int selected_item = values.selected_item;
+        if (selected_item < 0 || (items.count > 0 ? selected_item >= items.count : selected_item != 0)) {
+            return Fail("Selected item out of range");
+        }
+        store.SetType(index, type);
+        store.SetValues(index, values);
+        if (ElementItemList* list = store.EditItemList(index)) {
+            list->offset = items.offset;
+            list->count = items.count;
+        }
+        if (ImVec4* payload = store.EditColor(index)) {
+            *payload = color;
+        }
+        return true;
+    }
+
+    bool ReadDocument() {
+        if (reader.Next() != JsonToken::ObjectBegin) {
+            return Fail("Not a project file");
+        }
+        bool has_format = false;
+        for (;;) {
+            const JsonToken token = reader.Next();
+            if (token == JsonToken::ObjectEnd) {
+                break;
+            }
+            if (token != JsonToken::Key) {
+                return Fail("Expected a key");
+            }
+            bool ok = true;
+            if (strcmp(reader.GetString(), "format") == 0) {
+                if (reader.Next() != JsonToken::String || strcmp(reader.GetString(), PROJECT_JSON_FORMAT) != 0) {
+                    return Fail("Not a project file");
+                }
+                has_format = true;
+            } else if (strcmp(reader.GetString(), "version") == 0) {
+                double version;
+                ok = ReadNumber(&version);
+                if (ok && (version < 1 || version > PROJECT_JSON_VERSION)) {
+                    return Fail("Unsupported project file version");
+                }
+            } else if (strcmp(reader.GetString(), "name") == 0) {
+                ok = ReadString(&name);
+            } else if (strcmp(reader.GetString(), "elements") == 0) {
+                ok = ReadElements(ElementIndex_None, 0);
+            } else {
+                ok = reader.SkipValue(reader.Next()) || Fail("Invalid value");
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        if (!has_format) {
+            return Fail("Not a project file");
+        }
+        if (!Expect(JsonToken::End, "Unexpected data after the document")) {
+            return false;
+        }
+        return store.HasUniqueUids() || Fail("Duplicate element uid");
+    }
+};
+}
+
+bool LoadProjectJson(ElementStore& store, const char* path, const char** out_name, std::string* error) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        if (error) {
+            *error = "Cannot open file: ";
+            *error += path;
+        }
+        return false;
+    }
+
+    ElementStore loaded;
+    std::unique_ptr<JsonReader> reader(new JsonReader(f));
+    JsonProjectLoader loader(*reader, loaded);
+    const bool ok = loader.ReadDocument();
+    const bool read_error = ferror(f) != 0;
+    fclose(f);
+    if (!ok || read_error) {
+        if (error) {
+            char line[32];
+            snprintf(line, sizeof(line), " (line %d): ", reader->GetLine());
+            *error = read_error ? "Cannot read file" : loader.failure;
+            *error += line;
+            *error += path;
+        }
+        return false;
+    }
+
+    store.Swap(loaded);
+    if (out_name) {
+        *out_name = loader.name;
+    }
+    return true;
+}
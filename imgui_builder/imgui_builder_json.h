@@ -0,0 +1,147 @@
+// ULTIMATE ImGui Builder: JSON project files
+// Human-diffable text form of a document. Both directions stream through a fixed-size buffer: the writer emits
+// the tree as it walks the store and the reader is a pull parser handing out one token at a time, so no DOM is
+// ever built and memory does not grow with the file size (only with the nesting depth and the longest string).
+//
+//   {
+//     "format": "imgui-builder",
+//     "version": 1,
+//     "name": "My Menu",
+//     "elements": [
+//       {
+//         "type": "COMBO",
+//         "label": "Combo",
+//         "uid": 41,
+//         ...
+//         "combo_items": ["Item 1", "Item 2"],
+//         "text_color": [1, 1, 1, 1],
+//         "children": []
+//       }
+//     ]
+//   }
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#define PROJECT_JSON_FORMAT     "imgui-builder"
+#define PROJECT_JSON_VERSION    2     // 2: element "uid" numbers instead of "id" strings
+
+static const size_t JSON_BUFFER_SIZE = 64 * 1024;
+
+class JsonWriter {
+public:
+    explicit JsonWriter(FILE* f);
+    ~JsonWriter() { Flush(); }
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    // Inline containers are written on a single line: "size": [0, 0]
+    void BeginObject();
+    void EndObject();
+    void BeginArray(bool single_line = false);
+    void EndArray();
+
+    void Key(const char* key);
+    void String(const char* str);
+    void Int(int value);
+    void Uint(ImU64 value);
+    void Float(float value);
+    void Double(double value);
+    void Bool(bool value);
+
+    // Returns false if any write failed so far.
+    bool Flush();
+    size_t GetBytesWritten() const { return bytes_written + used; }
+
+private:
+    struct Scope {
+        bool single_line;
+        bool has_items;
+    };
+
+    void BeforeValue();
+    void NewLine();
+    void Write(const char* str, size_t length);
+    void WriteChar(char c) { if (used == JSON_BUFFER_SIZE) Flush(); buffer[used++] = c; }
+
+    FILE* file;
+    std::vector<Scope> scopes;
+    bool after_key = false;
+    bool failed = false;
+    size_t used = 0;
+    size_t bytes_written = 0;
+    char buffer[JSON_BUFFER_SIZE];
+};
+
+enum class JsonToken {
+    ObjectBegin,
+    ObjectEnd,
+    ArrayBegin,
+    ArrayEnd,
+    Key,            // GetString()
+    String,         // GetString()
+    Number,         // GetNumber()
+    True,
+    False,
+    Null,
+    End,            // End of the document
+    Error           // GetError(); every following Next() returns Error
+};
+
+class JsonReader {
+public:
+    explicit JsonReader(FILE* f);
+    JsonReader(const JsonReader&) = delete;
+    JsonReader& operator=(const JsonReader&) = delete;
+
+    JsonToken Next();
+    // Skip the rest of a value whose first token was just returned by Next().
+    bool SkipValue(JsonToken first);
+
+    const char* GetString() const { return text.c_str(); }
+    size_t GetStringLength() const { return text.size(); }
+    double GetNumber() const { return number; }
+    int GetLine() const { return line; }
+    const char* GetError() const { return error; }
+    size_t GetBytesRead() const { return bytes_read; }
+
+private:
+    int Peek() { return (pos < end || Refill()) ? (unsigned char)buffer[pos] : -1; }
+    int Get() { return (pos < end || Refill()) ? (unsigned char)buffer[pos++] : -1; }
+    bool Refill();
+    void SkipWhitespace();
+    JsonToken ParseValue(int c);
+    JsonToken CloseContainer();
+    JsonToken ValueDone(JsonToken token);
+    JsonToken Fail(const char* message);
+    bool ParseString();
+    bool ParseNumber(int c);
+    bool ParseLiteral(const char* rest);
+
+    FILE* file;
+    std::vector<char> containers;   // '{' or '['
+    bool value_expected = false;    // A key was just read
+    bool after_value = false;       // The current container has a complete item, ',' or a closer comes next
+    bool need_item = false;         // A ',' was just read
+    bool root_done = false;
+    std::string text;
+    double number = 0.0;
+    const char* error = nullptr;
+    int line = 1;
+    size_t bytes_read = 0;
+    size_t pos = 0;
+    size_t end = 0;
+    char buffer[JSON_BUFFER_SIZE];
+};
+
+// Save a whole document as JSON. 'name' is the menu name stored along with the elements.
+bool SaveProjectJson(const ElementStore& store, const char* name, const char* path, std::string* error = nullptr);
+
+// Replace the content of 'store' with a JSON project file. The document is read on the side and the store is only
+// touched on success. Elements without a "uid" (version 1 files) get new ones, duplicate uids fail the load. '*out_name' (optional) receives the menu name, valid until the store is cleared.
+bool LoadProjectJson(ElementStore& store, const char* path, const char** out_name = nullptr, std::string* error = nullptr);
@@ -0,0 +1,742 @@
+// ULTIMATE ImGui Builder: live preview in a running application (hot reload)
+// See imgui_builder_live.h
+
+#include "imgui_builder_live.h"
+#include "imgui_builder_types.h"
+#include <string.h>
+#include <chrono>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+typedef SOCKET NativeSocket;
+#define LIVE_WOULD_BLOCK(err)   ((err) == WSAEWOULDBLOCK)
+#define LIVE_IN_PROGRESS(err)   ((err) == WSAEWOULDBLOCK || (err) == WSAEINPROGRESS)
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int NativeSocket;
+#define LIVE_WOULD_BLOCK(err)   ((err) == EWOULDBLOCK || (err) == EAGAIN)
+#define LIVE_IN_PROGRESS(err)   ((err) == EINPROGRESS)
+#endif
+
+static_assert(sizeof(LiveMessageHeader) == 40, "LiveMessageHeader layout is part of the protocol");
+static_assert(sizeof(LiveElementRecord) == 112, "LiveElementRecord layout is part of the protocol");
+static_assert(sizeof(LivePositionRecord) == 24, "LivePositionRecord layout is part of the protocol");
+
+// Flags sent to the application (the others describe the builder's slot and tree view)
+static const ImU32 LIVE_ELEMENT_FLAGS = ElementFlags_Enabled | ElementFlags_Visible | ElementFlags_BoolValue | ElementFlags_Open;
+
+// A client that has this much unsent data is not reading anymore: it is dropped and gets a snapshot when it reconnects
+static const size_t LIVE_MAX_PENDING = 64 * 1024 * 1024;
+static const size_t LIVE_MAX_MESSAGE = 256 * 1024 * 1024;
+
+double GetLiveTime() {
+    // steady_clock is CLOCK_MONOTONIC / QueryPerformanceCounter: the same clock in every process of a machine
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static double MillisecondsSince(double start) {
+    return (GetLiveTime() - start) * 1000.0;
+}
+
+// 64-bit FNV-1a
+static ImU64 HashRecord(const unsigned char* data, size_t size) {
+    ImU64 hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static size_t AlignSize(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+static void AppendBytes(std::vector<unsigned char>& out, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+static void AppendPadding(std::vector<unsigned char>& out) {
+    out.resize(AlignSize(out.size()), 0);
+}
+
+//-----------------------------------------------------------------------------
+// LiveDeltaWriter
+//-----------------------------------------------------------------------------
+
+void LiveDeltaWriter::Reset() {
+    for (Sent& entry : sent) {
+        entry = Sent();
+    }
+    snapshot = true;
+}
+
+bool LiveDeltaWriter::Write(const ElementStore& store, std::vector<unsigned char>& out) {
+    if (sent.size() < store.types.size()) {
+        sent.resize(store.types.size());
+    }
+    out.clear();
+    out.resize(sizeof(LiveMessageHeader));
+    positions.clear();
+    removed.clear();
+    element_count = 0;
+
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        WriteSubtree(store, root, out);
+    }
+    if (snapshot || store.GetStructureRevision() != structure_revision) {
+        WriteRemoved(store);
+        structure_revision = store.GetStructureRevision();
+    }
+    const bool was_snapshot = snapshot;
+    snapshot = false;
+    if (!was_snapshot && element_count == 0 && positions.empty() && removed.empty()) {
+        return false;
+    }
+    AppendBytes(out, positions.data(), positions.size() * sizeof(LivePositionRecord));
+    AppendBytes(out, removed.data(), removed.size() * sizeof(ElementUid));
+
+    LiveMessageHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LIVE_MESSAGE_MAGIC, 4);
+    header.version = LIVE_MESSAGE_VERSION;
+    header.size = (ImU32)out.size();
+    header.flags = was_snapshot ? LiveMessageFlags_Snapshot : LiveMessageFlags_None;
+    header.element_count = (ImU32)element_count;
+    header.position_count = (ImU32)positions.size();
+    header.removed_count = (ImU32)removed.size();
+    header.send_time = GetLiveTime();
+    memcpy(out.data(), &header, sizeof(header));
+    return true;
+}
+
+void LiveDeltaWriter::WriteSubtree(const ElementStore& store, ElementIndex index, std::vector<unsigned char>& out) {
+    Sent& entry = sent[index];
+    const ElementUid uid = store.uids[index];
+    if (!snapshot && entry.uid == uid && entry.revision == store.revisions[index]) {
+        return;     // Nothing changed in the whole subtree
+    }
+    if (entry.uid != uid) {
+        // Another element in a reused slot: the previous one was removed, unless it lives in another slot now
+        if (entry.uid != ElementUid_None && store.FindByUid(entry.uid) == ElementIndex_None) {
+            removed.push_back(entry.uid);
+        }
+        entry = Sent();
+        entry.uid = uid;
+    }
+    WriteElement(store, index, entry, out);
+    WritePosition(store, index, entry);
+    entry.revision = store.revisions[index];
+    for (ElementIndex child = store.FirstChild(index); child != ElementIndex_None; child = store.NextSibling(child)) {
+        WriteSubtree(store, child, out);
+    }
+}
+
+// The record is written, then taken back if it is the same as the last one sent: an element is revisited when
+// anything below it changed, which most of the time leaves its own fields alone.
+void LiveDeltaWriter::WriteElement(const ElementStore& store, ElementIndex index, Sent& entry, std::vector<unsigned char>& out) {
+    const ElementValues value = store.GetValues(index);
+    const ElementStyle& style = store.styles[index];
+    const ElementStrings& strings = store.strings[index];
+    const ImVec4& color = store.GetColor(index);
+    const char* const* items = store.GetItems(index);
+    const int item_count = store.GetItemCount(index);
+
+    LiveElementRecord record;
+    memset(&record, 0, sizeof(record));
+    record.uid = store.uids[index];
+    record.type = (ImU8)store.types[index];
+    record.flags = store.flags[index] & LIVE_ELEMENT_FLAGS;
+    record.int_value = value.int_value;
+    record.float_value = value.float_value;
+    record.min_value = value.min_value;
+    record.max_value = value.max_value;
+    record.selected_item = value.selected_item;
+    memcpy(record.size, &style.size, sizeof(record.size));
+    memcpy(record.text_color, &style.text_color, sizeof(record.text_color));
+    memcpy(record.bg_color, &style.bg_color, sizeof(record.bg_color));
+    memcpy(record.color_value, &color, sizeof(record.color_value));
+    record.label_size = (ImU32)strlen(strings.label) + 1;
+    record.text_size = (ImU32)strlen(strings.text_value) + 1;
+    record.items_count = (ImU32)item_count;
+    for (int i = 0; i < item_count; i++) {
+        record.items_size += (ImU32)strlen(items[i]) + 1;
+    }
+
+    const size_t begin = out.size();
+    AppendBytes(out, &record, sizeof(record));
+    AppendBytes(out, strings.label, record.label_size);
+    AppendBytes(out, strings.text_value, record.text_size);
+    for (int i = 0; i < item_count; i++) {
+        AppendBytes(out, items[i], strlen(items[i]) + 1);
+    }
+    AppendPadding(out);
+
+    const ImU64 hash = HashRecord(out.data() + begin, out.size() - begin);
+    if (!snapshot && hash == entry.hash) {
+        out.resize(begin);
+        return;
+    }
+    entry.hash = hash;
+    element_count++;
+}
+
+// Elements that did not move keep their place in the application even when siblings around them come and go:
+// only the elements that moved, in document order, are put in place again.
+void LiveDeltaWriter::WritePosition(const ElementStore& store, ElementIndex index, Sent& entry) {
+    const ElementIndex parent = store.Parent(index);
+    const ElementIndex prev_sibling = store.PrevSibling(index);
+    LivePositionRecord record;
+    record.uid = store.uids[index];
+    record.parent = (parent == ElementIndex_None) ? ElementUid_None : store.uids[parent];
+    record.prev_sibling = (prev_sibling == ElementIndex_None) ? ElementUid_None : store.uids[prev_sibling];
+    if (!snapshot && entry.revision != 0 && record.parent == entry.parent && record.prev_sibling == entry.prev_sibling) {
+        return;
+    }
+    entry.parent = record.parent;
+    entry.prev_sibling = record.prev_sibling;
+    positions.push_back(record);
+}
+
+// Slots whose element is gone since the last message (reused slots were handled while walking the tree)
+void LiveDeltaWriter::WriteRemoved(const ElementStore& store) {
+    for (size_t slot = 0; slot < sent.size(); slot++) {
+        Sent& entry = sent[slot];
+        if (entry.uid == ElementUid_None || (store.IsAlive((ElementIndex)slot) && store.uids[slot] == entry.uid)) {
+            continue;
+        }
+        if (!snapshot && store.FindByUid(entry.uid) == ElementIndex_None) {
+            removed.push_back(entry.uid);
+        }
+        entry = Sent();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// LiveDeltaReader
+//-----------------------------------------------------------------------------
+
+static bool SetError(std::string* error, const char* message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+// A zero-terminated string filling exactly [str, str + size)
+static bool IsString(const char* str, size_t size) {
+    return size > 0 && memchr(str, 0, size) == str + size - 1;
+}
+
+bool LiveDeltaReader::Apply(ElementStore& store, const unsigned char* data, size_t size, std::string* error) {
+    LiveMessageHeader header;
+    if (size < sizeof(header)) {
+        return SetError(error, "Truncated live message");
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, LIVE_MESSAGE_MAGIC, 4) != 0 || header.version != LIVE_MESSAGE_VERSION || header.size != size) {
+        return SetError(error, "Not a live message of this version");
+    }
+    if (header.flags & LiveMessageFlags_Snapshot) {
+        store.Clear();
+    }
+    created.clear();
+    size_t offset = sizeof(header);
+
+    // Elements: created detached, or updated in place
+    for (ImU32 n = 0; n < header.element_count; n++) {
+        LiveElementRecord record;
+        if (size - offset < sizeof(record)) {
+            return SetError(error, "Corrupted live message (elements)");
+        }
+        memcpy(&record, data + offset, sizeof(record));
+        offset += sizeof(record);
+        const char* label = (const char*)data + offset;
+        const char* text = label + record.label_size;
+        const char* item = text + record.text_size;
+        const ImU64 strings_size = (ImU64)record.label_size + record.text_size + record.items_size;
+        if (record.type >= ElementType_COUNT || record.uid == ElementUid_None || strings_size > size - offset ||
+            !IsString(label, record.label_size) || !IsString(text, record.text_size)) {
+            return SetError(error, "Corrupted live message (elements)");
+        }
+        items.clear();
+        for (const char* items_end = item + record.items_size; item < items_end; item += strlen(item) + 1) {
+            if (!memchr(item, 0, items_end - item)) {
+                return SetError(error, "Corrupted live message (items)");
+            }
+            items.push_back(item);
+        }
+        if (items.size() != record.items_count || record.selected_item < 0 ||
+            (record.items_count > 0 ? (ImU32)record.selected_item >= record.items_count : record.selected_item != 0)) {
+            return SetError(error, "Corrupted live message (items)");
+        }
+        offset = AlignSize(offset + (size_t)strings_size);
+        if (offset > size) {
+            return SetError(error, "Corrupted live message (elements)");
+        }
+
+        const ElementType type = (ElementType)record.type;
+        ElementIndex index = store.FindByUid(record.uid);
+        if (index == ElementIndex_None) {
+            index = store.Create(type);
+            store.SetUid(index, record.uid);
+            created.push_back(index);
+        } else if (store.types[index] != type) {
+            store.SetType(index, type);
+        }
+        store.flags[index] = (store.flags[index] & ~LIVE_ELEMENT_FLAGS) | (record.flags & LIVE_ELEMENT_FLAGS);
+        ElementValues value;
+        value.int_value = record.int_value;
+        value.float_value = record.float_value;
+        value.min_value = record.min_value;
+        value.max_value = record.max_value;
+        value.selected_item = record.selected_item;
+        store.SetValues(index, value);
+        ElementStyle& style = store.styles[index];
+        memcpy(&style.size, record.size, sizeof(record.size));
+        memcpy(&style.text_color, record.text_color, sizeof(record.text_color));
+        memcpy(&style.bg_color, record.bg_color, sizeof(record.bg_color));
+        if (ImVec4* color = store.EditColor(index)) {
+            memcpy(color, record.color_value, sizeof(record.color_value));
+        }
+        store.SetLabel(index, label);
+        store.SetText(index, text);
+        store.SetItems(index, items.data(), (int)items.size());
+    }
+
+    if ((size - offset) / sizeof(LivePositionRecord) < header.position_count ||
+        size - offset - header.position_count * sizeof(LivePositionRecord) != (size_t)header.removed_count * sizeof(ElementUid)) {
+        return SetError(error, "Corrupted live message (size)");
+    }
+
+    // Positions, in document order: the parent and the previous sibling are already in place
+    for (ImU32 n = 0; n < header.position_count; n++, offset += sizeof(LivePositionRecord)) {
+        LivePositionRecord record;
+        memcpy(&record, data + offset, sizeof(record));
+        const ElementIndex index = store.FindByUid(record.uid);
+        const ElementIndex parent = (record.parent == ElementUid_None) ? ElementIndex_None : store.FindByUid(record.parent);
+        const ElementIndex prev_sibling = (record.prev_sibling == ElementUid_None) ? ElementIndex_None : store.FindByUid(record.prev_sibling);
+        if (index == ElementIndex_None || (record.parent != ElementUid_None && parent == ElementIndex_None) ||
+            (record.prev_sibling != ElementUid_None && (prev_sibling == ElementIndex_None || prev_sibling == index ||
+            store.IsDetached(prev_sibling) || store.Parent(prev_sibling) != parent))) {
+            return SetError(error, "Corrupted live message (positions)");
+        }
+        const ElementIndex before = (prev_sibling == ElementIndex_None) ? store.FirstChild(parent) : store.NextSibling(prev_sibling);
+        if (!store.Move(index, parent, before)) {
+            return SetError(error, "Corrupted live message (not a tree)");
+        }
+    }
+
+    // Removed elements (after the moves: their descendants may have moved out of them)
+    for (ImU32 n = 0; n < header.removed_count; n++, offset += sizeof(ElementUid)) {
+        ElementUid uid;
+        memcpy(&uid, data + offset, sizeof(uid));
+        const ElementIndex index = store.FindByUid(uid);
+        if (index != ElementIndex_None) {
+            store.Remove(index);
+        }
+    }
+    // Elements never put in place would stay invisible forever
+    for (ElementIndex index : created) {
+        if (store.IsAlive(index) && store.IsDetached(index)) {
+            store.Remove(index);
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Sockets
+//-----------------------------------------------------------------------------
+
+static int LastSocketError() {
+#ifdef _WIN32
+    return ::WSAGetLastError();
+#else
+    return errno;
+#endif
+}
+
+static void CloseSocket(ImS64 socket) {
+#ifdef _WIN32
+    ::closesocket((NativeSocket)socket);
+#else
+    ::close((NativeSocket)socket);
+#endif
+}
+
+static bool InitSockets() {
+#ifdef _WIN32
+    static bool initialized = false;
+    if (!initialized) {
+        WSADATA wsa_data;
+        initialized = ::WSAStartup(MAKEWORD(2, 2), &wsa_data) == 0;
+    }
+    return initialized;
+#else
+    return true;
+#endif
+}
+
+// Non-blocking TCP socket, sent without delay (messages are small and latency matters)
+static ImS64 CreateSocket() {
+    if (!InitSockets()) {
+        return -1;
+    }
+    NativeSocket native = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#ifdef _WIN32
+    if (native == INVALID_SOCKET) {
+        return -1;
+    }
+    u_long non_blocking = 1;
+    ::ioctlsocket(native, FIONBIO, &non_blocking);
+#else
+    if (native < 0) {
+        return -1;
+    }
+    ::fcntl(native, F_SETFL, ::fcntl(native, F_GETFL, 0) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+    int no_sigpipe = 1;
+    ::setsockopt(native, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&no_sigpipe, sizeof(no_sigpipe));
+#endif
+#endif
+    int no_delay = 1;
+    ::setsockopt(native, IPPROTO_TCP, TCP_NODELAY, (const char*)&no_delay, sizeof(no_delay));
+    return (ImS64)native;
+}
+
+static sockaddr_in LoopbackAddress(int port) {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((unsigned short)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+// Bytes sent (0 if the socket is full), -1 if the connection is gone
+static int SendSome(ImS64 socket, const unsigned char* data, size_t size) {
+    const int chunk = size > 1024 * 1024 ? 1024 * 1024 : (int)size;
+#ifdef MSG_NOSIGNAL
+    const int result = (int)::send((NativeSocket)socket, (const char*)data, chunk, MSG_NOSIGNAL);
+#else
+    const int result = (int)::send((NativeSocket)socket, (const char*)data, chunk, 0);
+#endif
+    if (result < 0) {
+        return LIVE_WOULD_BLOCK(LastSocketError()) ? 0 : -1;
+    }
+    return result;
+}
+
+// Bytes received (0 if there is nothing yet), -1 if the connection is gone
+static int ReceiveSome(ImS64 socket, unsigned char* data, size_t size) {
+    const int result = (int)::recv((NativeSocket)socket, (char*)data, (int)size, 0);
+    if (result == 0) {
+        return -1;
+    }
+    if (result < 0) {
+        return LIVE_WOULD_BLOCK(LastSocketError()) ? 0 : -1;
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// LiveServer
+//-----------------------------------------------------------------------------
+
+bool LiveServer::Listen(int port, std::string* error) {
+    Close();
+    const ImS64 socket = CreateSocket();
+    if (socket == -1) {
+        return SetError(error, "Cannot create a socket");
+    }
+    int reuse = 1;
+    ::setsockopt((NativeSocket)socket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+    const sockaddr_in address = LoopbackAddress(port);
+    if (::bind((NativeSocket)socket, (const sockaddr*)&address, sizeof(address)) != 0 || ::listen((NativeSocket)socket, 8) != 0) {
+        CloseSocket(socket);
+        return SetError(error, "Cannot listen on the port (already in use?)");
+    }
+    // Port 0: any free port, the one picked is reported by GetPort()
+    sockaddr_in bound;
+    socklen_t length = sizeof(bound);
+    ::getsockname((NativeSocket)socket, (sockaddr*)&bound, &length);
+    listener = socket;
+    this->port = ntohs(bound.sin_port);
+    return true;
+}
+
+void LiveServer::Close() {
+    for (Client& client : clients) {
+        CloseSocket(client.socket);
+    }
+    clients.clear();
+    stats.clients = 0;
+    if (listener != -1) {
+        CloseSocket(listener);
+        listener = -1;
+    }
+}
+
+void LiveServer::Send(Client& client, const std::vector<unsigned char>& data) {
+    if (client.pending_offset == client.pending.size()) {
+        client.pending.clear();
+        client.pending_offset = 0;
+    }
+    client.pending.insert(client.pending.end(), data.begin(), data.end());
+    stats.bytes_sent += data.size();
+}
+
+// False if the client is gone or too far behind
+bool LiveServer::Flush(Client& client) {
+    while (client.pending_offset < client.pending.size()) {
+        const int sent = SendSome(client.socket, client.pending.data() + client.pending_offset, client.pending.size() - client.pending_offset);
+        if (sent < 0) {
+            return false;
+        }
+        if (sent == 0) {
+            break;
+        }
+        client.pending_offset += sent;
+    }
+    // Clients only send to close the connection: drain it to notice
+    unsigned char discard[256];
+    int received;
+    while ((received = ReceiveSome(client.socket, discard, sizeof(discard))) > 0) {
+    }
+    return received == 0 && client.pending.size() - client.pending_offset <= LIVE_MAX_PENDING;
+}
+
+void LiveServer::Poll(const ElementStore& store) {
+    if (listener == -1) {
+        return;
+    }
+    // What changed, to the clients that have the document already
+    if (!clients.empty() && store.GetRevision() != written_revision) {
+        const double start = GetLiveTime();
+        if (writer.Write(store, message)) {
+            stats.last_write_ms = MillisecondsSince(start);
+            stats.last_message_size = message.size();
+            stats.messages++;
+            for (Client& client : clients) {
+                Send(client, message);
+            }
+        }
+        written_revision = store.GetRevision();
+    }
+
+    // New clients start from a snapshot. The first one takes it from the delta writer, which then follows the
+    // document from there.
+    const size_t first_new = clients.size();
+    for (;;) {
+        const NativeSocket accepted = ::accept((NativeSocket)listener, nullptr, nullptr);
+#ifdef _WIN32
+        if (accepted == INVALID_SOCKET) {
+            break;
+        }
+        u_long non_blocking = 1;
+        ::ioctlsocket(accepted, FIONBIO, &non_blocking);
+#else
+        if (accepted < 0) {
+            break;
+        }
+        ::fcntl(accepted, F_SETFL, ::fcntl(accepted, F_GETFL, 0) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+        int no_sigpipe = 1;
+        ::setsockopt(accepted, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&no_sigpipe, sizeof(no_sigpipe));
+#endif
+#endif
+        int no_delay = 1;
+        ::setsockopt(accepted, IPPROTO_TCP, TCP_NODELAY, (const char*)&no_delay, sizeof(no_delay));
+        clients.emplace_back();
+        clients.back().socket = (ImS64)accepted;
+    }
+    if (clients.size() > first_new) {
+        LiveDeltaWriter& snapshot_source = (first_new == 0) ? writer : snapshot_writer;
+        snapshot_source.Reset();
+        snapshot_source.Write(store, message);
+        written_revision = store.GetRevision();
+        stats.snapshots += (int)(clients.size() - first_new);
+        for (size_t n = first_new; n < clients.size(); n++) {
+            Send(clients[n], message);
+        }
+    }
+
+    for (size_t n = 0; n < clients.size();) {
+        if (Flush(clients[n])) {
+            n++;
+            continue;
+        }
+        CloseSocket(clients[n].socket);
+        clients.erase(clients.begin() + n);
+        stats.dropped_clients++;
+    }
+    stats.clients = (int)clients.size();
+}
+
+//-----------------------------------------------------------------------------
+// LiveClient
+//-----------------------------------------------------------------------------
+
+void LiveClient::Connect(int port, double retry_interval) {
+    Disconnect();
+    this->port = port;
+    this->retry_interval = retry_interval;
+    StartConnect(GetLiveTime());
+}
+
+void LiveClient::Disconnect() {
+    if (socket != -1) {
+        CloseSocket(socket);
+        socket = -1;
+    }
+    state = State_Idle;
+    stats.connected = false;
+    buffer_size = 0;
+}
+
+void LiveClient::ResetStats() {
+    const bool connected = stats.connected;
+    stats = LiveClientStats();
+    stats.connected = connected;
+}
+
+void LiveClient::StartConnect(double now) {
+    retry_time = now + retry_interval;
+    socket = CreateSocket();
+    if (socket == -1) {
+        return;
+    }
+    const sockaddr_in address = LoopbackAddress(port);
+    if (::connect((NativeSocket)socket, (const sockaddr*)&address, sizeof(address)) == 0) {
+        state = State_Connected;
+    } else if (LIVE_IN_PROGRESS(LastSocketError())) {
+        state = State_Connecting;
+    } else {
+        CloseSocket(socket);
+        socket = -1;
+        return;
+    }
+    if (state == State_Connected) {
+        stats.connected = true;
+        stats.connections++;
+    }
+}
+
+void LiveClient::Drop(const char* reason) {
+    if (reason) {
+        error = reason;
+    }
+    CloseSocket(socket);
+    socket = -1;
+    state = State_Connecting;   // Retried at 'retry_time'
+    stats.connected = false;
+    buffer_size = 0;
+}
+
+int LiveClient::Poll(ElementStore& store) {
+    if (state == State_Idle) {
+        return 0;
+    }
+    const double now = GetLiveTime();
+    if (socket == -1) {
+        if (now < retry_time) {
+            return 0;
+        }
+        StartConnect(now);
+        if (socket == -1) {
+            return 0;
+        }
+    }
+    if (state == State_Connecting) {
+        // Connected once writable, failed once in error (select() reports a refused connection either way)
+        fd_set write_set, error_set;
+        FD_ZERO(&write_set);
+        FD_ZERO(&error_set);
+        FD_SET((NativeSocket)socket, &write_set);
+        FD_SET((NativeSocket)socket, &error_set);
+        timeval timeout = { 0, 0 };
+        if (::select((int)socket + 1, nullptr, &write_set, &error_set, &timeout) <= 0) {
+            if (now >= retry_time) {
+                Drop("Connection timed out");
+            }
+            return 0;
+        }
+        int socket_error = 0;
+        socklen_t length = sizeof(socket_error);
+        ::getsockopt((NativeSocket)socket, SOL_SOCKET, SO_ERROR, (char*)&socket_error, &length);
+        if (FD_ISSET((NativeSocket)socket, &error_set) || socket_error != 0) {
+            Drop("Connection refused (is the builder serving?)");
+            return 0;
+        }
+        state = State_Connected;
+        stats.connected = true;
+        stats.connections++;
+    }
+
+    // Receive whatever is there, then apply every complete message
+    for (;;) {
+        if (buffer.size() - buffer_size < 64 * 1024) {
+            buffer.resize(buffer_size + 256 * 1024);
+        }
+        const int received = ReceiveSome(socket, buffer.data() + buffer_size, buffer.size() - buffer_size);
+        if (received < 0) {
+            Drop("Connection closed by the builder");
+            return 0;
+        }
+        if (received == 0) {
+            break;
+        }
+        buffer_size += received;
+        stats.bytes_received += received;
+    }
+
+    int applied = 0;
+    size_t offset = 0;
+    while (buffer_size - offset >= sizeof(LiveMessageHeader)) {
+        LiveMessageHeader header;
+        memcpy(&header, buffer.data() + offset, sizeof(header));
+        if (header.size < sizeof(header) || header.size > LIVE_MAX_MESSAGE) {
+            stats.errors++;
+            Drop("Corrupted live message (size)");
+            return applied;
+        }
+        if (buffer_size - offset < header.size) {
+            break;
+        }
+        const double start = GetLiveTime();
+        if (!reader.Apply(store, buffer.data() + offset, header.size, &error)) {
+            stats.errors++;
+            Drop(nullptr);
+            return applied;
+        }
+        const double end = GetLiveTime();
+        stats.last_apply_ms = (end - start) * 1000.0;
+        stats.last_latency_ms = (end - header.send_time) * 1000.0;
+        stats.max_latency_ms = stats.last_latency_ms > stats.max_latency_ms ? stats.last_latency_ms : stats.max_latency_ms;
+        stats.total_latency_ms += stats.last_latency_ms;
+        stats.messages++;
+        stats.snapshots += (header.flags & LiveMessageFlags_Snapshot) ? 1 : 0;
+        offset += header.size;
+        applied++;
+    }
+    if (offset > 0) {
+        memmove(buffer.data(), buffer.data() + offset, buffer_size - offset);
+        buffer_size -= offset;
+    }
+    return applied;
+}
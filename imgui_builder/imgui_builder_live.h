@@ -0,0 +1,237 @@
+// ULTIMATE ImGui Builder: live preview in a running application (hot reload)
+// The builder serves its document on a local TCP port (LiveServer). An application that links this library connects
+// to it (LiveClient), keeps its own copy of the document in an ElementStore and draws it with an ElementPreview:
+// every edit made in the builder shows up in the application without restarting or regenerating code.
+//
+//     ElementStore live_ui;
+//     ElementPreview live_view;
+//     LiveClient live;
+//     live.Connect(LIVE_DEFAULT_PORT);
+//     ...every frame:
+//     if (live.Poll(live_ui) > 0)
+//         live_view.Invalidate();
+//     ImGui::Begin("Live UI");
+//     live_view.Render(live_ui);
+//     ImGui::End();
+//
+// A connection starts with a snapshot of the whole document, followed by one delta per builder frame that changed it.
+// The elements to look at are found from the store revisions (unchanged subtrees are skipped without being visited),
+// and a delta only holds what differs from what was last sent for each of them:
+// - the fields of an element, when a hash of its record changed: editing a property sends one record;
+// - the place of an element (parent, previous sibling), when it changed: inserting or moving sends one position,
+//   whatever the number of siblings;
+// - the uids of the elements removed.
+// Elements are named by uid, so a delta applies whatever slots the two stores use.
+//
+// Message layout (native byte order, both ends run on the same machine, every record 8-byte aligned):
+//   LiveMessageHeader
+//   element_count x { LiveElementRecord, label, text, items (zero-terminated strings), padding }
+//   position_count x LivePositionRecord     in document order
+//   removed_count x ElementUid
+// Elements are created (detached) or updated first, then put in place in document order, so that the parent and
+// previous sibling of each one are already where they belong, then removed elements are released with their subtree.
+
+// Sockets never block: both ends do their work in Poll(), once per frame. A message is sent by the builder in the frame
+// the edit was made and applied by the application in its next frame, so the latency from edit to update is at most
+// one frame of the application plus the transfer. The header carries the send time (GetLiveTime(), a clock both
+// processes share), and LiveClientStats reports the latency measured on arrival.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <string>
+#include <vector>
+
+#define LIVE_MESSAGE_MAGIC      "IMGL"
+#define LIVE_MESSAGE_VERSION    1
+#define LIVE_DEFAULT_PORT       7420
+
+enum LiveMessageFlags_ {
+    LiveMessageFlags_None       = 0,
+    LiveMessageFlags_Snapshot   = 1 << 0,   // Replaces the whole document
+};
+typedef int LiveMessageFlags;
+
+struct LiveMessageHeader {
+    char magic[4];
+    ImU32 version;
+    ImU32 size;                 // Whole message, header included
+    ImU32 flags;                // LiveMessageFlags_
+    ImU32 element_count;
+    ImU32 position_count;
+    ImU32 removed_count;
+    ImU32 reserved;
+    double send_time;           // GetLiveTime()
+};
+
+struct LiveElementRecord {
+    ElementUid uid;
+    ImU8 type;
+    ImU8 reserved[3];
+    ImU32 flags;                // ElementFlags_Enabled / Visible / BoolValue / Open
+    ImS32 int_value;
+    float float_value;
+    float min_value;
+    float max_value;
+    ImS32 selected_item;
+    float size[2];
+    float text_color[4];
+    float bg_color[4];
+    float color_value[4];
+    ImU32 label_size;           // Bytes following the record, terminators included
+    ImU32 text_size;
+    ImU32 items_size;
+    ImU32 items_count;
+    ImU32 reserved2;            // Keeps the record size a multiple of 8
+};
+
+struct LivePositionRecord {
+    ElementUid uid;
+    ElementUid parent;          // ElementUid_None: top level
+    ElementUid prev_sibling;    // ElementUid_None: first child
+};
+
+// Seconds on a monotonic clock shared by the processes of a machine
+double GetLiveTime();
+
+// Builder side: turns the changes of a store into messages
+class LiveDeltaWriter {
+public:
+    // Forget what was sent: the next message is a snapshot
+    void Reset();
+    // Encode what changed in 'store' since the previous call into 'out' (replaced). False if nothing changed.
+    bool Write(const ElementStore& store, std::vector<unsigned char>& out);
+
+private:
+    // What the element of a slot was when it was last sent
+    struct Sent {
+        ElementUid uid = ElementUid_None;
+        ElementRevision revision = 0;
+        ImU64 hash = 0;
+        ElementUid parent = ElementUid_None;
+        ElementUid prev_sibling = ElementUid_None;
+    };
+
+    void WriteSubtree(const ElementStore& store, ElementIndex index, std::vector<unsigned char>& out);
+    void WriteElement(const ElementStore& store, ElementIndex index, Sent& entry, std::vector<unsigned char>& out);
+    void WritePosition(const ElementStore& store, ElementIndex index, Sent& entry);
+    void WriteRemoved(const ElementStore& store);
+
+    std::vector<Sent> sent;         // Per slot
+    ElementRevision structure_revision = 0;
+    bool snapshot = true;
+    // Message being written
+    std::vector<LivePositionRecord> positions;
+    std::vector<ElementUid> removed;
+    int element_count = 0;
+};
+
+// Application side: applies messages to a store
+class LiveDeltaReader {
+public:
+    // False if the message is malformed. The store may then be partly updated: reconnecting gets a snapshot.
+    bool Apply(ElementStore& store, const unsigned char* data, size_t size, std::string* error = nullptr);
+
+private:
+    std::vector<const char*> items;
+    std::vector<ElementIndex> created;
+};
+
+struct LiveServerStats {
+    int clients = 0;
+    int messages = 0;               // Deltas written (sent to every client)
+    int snapshots = 0;              // Sent to new clients
+    int dropped_clients = 0;        // Closed, or too far behind
+    size_t bytes_sent = 0;
+    size_t last_message_size = 0;
+    double last_write_ms = 0.0;     // Encoding the last delta
+};
+
+// Builder side: serves a document to the applications connected to a local port
+class LiveServer {
+public:
+    ~LiveServer() { Close(); }
+
+    // Listen on 127.0.0.1:'port' (0: any free port)
+    bool Listen(int port, std::string* error = nullptr);
+    void Close();
+    bool IsListening() const { return listener != -1; }
+    int GetPort() const { return port; }
+
+    // Accept new clients and send them a snapshot, send the other clients what changed in 'store' since the
+    // previous call, flush what the sockets could not take yet. Never blocks.
+    void Poll(const ElementStore& store);
+    const LiveServerStats& GetStats() const { return stats; }
+
+private:
+    struct Client {
+        ImS64 socket;
+        std::vector<unsigned char> pending;     // Not sent yet, from 'pending_offset'
+        size_t pending_offset = 0;
+    };
+
+    void Send(Client& client, const std::vector<unsigned char>& data);
+    bool Flush(Client& client);
+
+    ImS64 listener = -1;
+    int port = 0;
+    std::vector<Client> clients;
+    LiveDeltaWriter writer;             // Deltas, shared by every client
+    LiveDeltaWriter snapshot_writer;    // Snapshots for new clients
+    ElementRevision written_revision = 0;
+    std::vector<unsigned char> message;
+    LiveServerStats stats;
+};
+
+struct LiveClientStats {
+    bool connected = false;
+    int connections = 0;
+    int messages = 0;
+    int snapshots = 0;
+    int errors = 0;                     // Malformed messages (the connection is dropped and made again)
+    size_t bytes_received = 0;
+    double last_latency_ms = 0.0;       // Send time to applied, of the last message
+    double max_latency_ms = 0.0;
+    double total_latency_ms = 0.0;      // Over 'messages'
+    double last_apply_ms = 0.0;
+};
+
+// Application side: follows the document of a builder serving on this machine
+class LiveClient {
+public:
+    ~LiveClient() { Disconnect(); }
+
+    // Connect to 127.0.0.1:'port', then again whenever the connection drops (every 'retry_interval' seconds)
+    void Connect(int port, double retry_interval = 1.0);
+    void Disconnect();
+    bool IsConnected() const { return state == State_Connected; }
+
+    // Receive and apply everything that arrived, without blocking. Returns the number of messages applied.
+    int Poll(ElementStore& store);
+    const LiveClientStats& GetStats() const { return stats; }
+    void ResetStats();
+    // Reason of the last dropped connection or malformed message
+    const std::string& GetError() const { return error; }
+
+private:
+    enum State {
+        State_Idle,
+        State_Connecting,
+        State_Connected,
+    };
+
+    void StartConnect(double now);
+    void Drop(const char* reason);   // nullptr: keep the error already set
+
+    State state = State_Idle;
+    ImS64 socket = -1;
+    int port = 0;
+    double retry_interval = 1.0;
+    double retry_time = 0.0;
+    std::vector<unsigned char> buffer;  // Received, [0, buffer_size)
+    size_t buffer_size = 0;
+    LiveDeltaReader reader;
+    LiveClientStats stats;
+    std::string error;
+};
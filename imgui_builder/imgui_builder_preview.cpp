@@ -0,0 +1,453 @@
+// ULTIMATE ImGui Builder: document preview
+// See imgui_builder_preview.h
+
+#include "imgui_builder_preview.h"
+#include "imgui_builder_profiler.h"
+#include "imgui_builder_types.h"
+#include <string.h>
+
+static int ResizeTextBuffer(ImGuiInputTextCallbackData* data) {
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize) {
+        std::vector<char>* buffer = (std::vector<char>*)data->UserData;
+        buffer->resize(data->BufSize);
+        data->Buf = buffer->data();
+    }
+    return 0;
+}
+
+// Interned strings are immutable: the widget edits a copy, only valid during the call
+bool InputString(const char* label, const char* text, std::vector<char>& buffer, bool multiline) {
+    const size_t size = strlen(text) + 1;
+    if (buffer.size() < size) {
+        buffer.resize(size > 256 ? size : 256);
+    }
+    memcpy(buffer.data(), text, size);
+    const ImGuiInputTextFlags flags = ImGuiInputTextFlags_CallbackResize;
+    return multiline ?
+        ImGui::InputTextMultiline(label, buffer.data(), buffer.size(), ImVec2(0, 0), flags, ResizeTextBuffer, &buffer) :
+        ImGui::InputText(label, buffer.data(), buffer.size(), flags, ResizeTextBuffer, &buffer);
+}
+
+void ElementPreview::Render(ElementStore& store) {
+    if (rows_dirty || rows_revision != store.GetStructureRevision()) {
+        BuildPreviewRows(store, items, rows);
+        heights.Reset((int)rows.size(), ImGui::GetFrameHeightWithSpacing());
+        rows_revision = store.GetStructureRevision();
+        rows_dirty = false;
+    }
+    style_calls = 0;
+    unbatched_style_calls = 0;
+    if (rows.empty()) {
+        return;
+    }
+
+    // Rows have different heights: skip to the first visible one with the height index, draw until the bottom of
+    // the window, measuring each row drawn, then leave room for the rest.
+    const float indent_spacing = ImGui::GetStyle().IndentSpacing;
+    const float top = ImGui::GetCursorPosY();
+    const float view_begin = ImGui::GetScrollY() - top;
+    const float view_end = view_begin + ImGui::GetWindowHeight();
+    int row = heights.FindRow(view_begin > 0.0f ? view_begin : 0.0f);
+    row = row < heights.Size() ? row : heights.Size() - 1;
+    float row_top = heights.Offset(row);
+    ImGui::SetCursorPosY(top + row_top);
+
+    int indent = 0;
+    StyleState state;
+    for (; row < (int)rows.size() && row_top < view_end; row++) {
+        const PreviewRow& preview_row = rows[row];
+        if (preview_row.indent != indent) {
+            const float indent_w = (preview_row.indent - indent) * indent_spacing;
+            if (indent_w > 0.0f) {
+                ImGui::Indent(indent_w);
+            } else {
+                ImGui::Unindent(-indent_w);
+            }
+            indent = preview_row.indent;
+        }
+        const float y = ImGui::GetCursorPosY();
+        for (int item = preview_row.first; item < preview_row.first + preview_row.count; item++) {
+            const ElementIndex element = items[item].element;
+            if (!store.IsAlive(element)) {
+                continue;
+            }
+            const ElementIndex parent = store.links[element].parent;
+            if (parent != state.parent) {
+                EndStyle(state);
+                EnterParent(store, parent);
+                state.parent = parent;
+            }
+            if (!RenderElement(store, element, state)) {
+                continue;
+            }
+            const ElementType type = store.types[element];
+            indent += (type == ElementType::INDENT) ? 1 : (type == ElementType::UNINDENT) ? -1 : 0;
+        }
+        const float height = ImGui::GetCursorPosY() - y;
+        heights.Set(row, height > 0.0f ? height : 0.0f);
+        row_top += heights.Get(row);
+    }
+    EndStyle(state);
+    EnterParent(store, ElementIndex_None);
+    if (indent != 0) {
+        if (indent > 0) {
+            ImGui::Unindent(indent * indent_spacing);
+        } else {
+            ImGui::Indent(-indent * indent_spacing);
+        }
+    }
+    if (row < (int)rows.size()) {
+        ImGui::SetCursorPosY(top + heights.Total());
+        ImGui::Dummy(ImVec2(0.0f, 0.0f));
+    }
+}
+
+void ElementPreview::ApplyStyle(const ElementStore& store, ElementIndex element, ElementCalls calls, StyleState& state) {
+    const ElementIndex parent = store.links[element].parent;
+    if (parent != state.parent) {
+        EndStyle(state);
+        state.parent = parent;
+    }
+    const int colors = GetColorCount(calls);
+    const bool disabled = (calls & ElementCalls_Disabled) != 0;
+    unbatched_style_calls += (disabled ? 2 : 0) + (colors > 0 ? colors + 1 : 0) + ((calls & ElementCalls_ItemWidth) ? 2 : 0);
+
+    if (state.disabled != ElementIndex_None && (disabled ? !HaveSameScope(store, state.disabled, element, StyleScope_Disabled) :
+                                                           !IsScopeTransparent(store, element, StyleScope_Disabled))) {
+        ImGui::EndDisabled();
+        state.disabled = ElementIndex_None;
+        style_calls++;
+    }
+    if (disabled && state.disabled == ElementIndex_None) {
+        ImGui::BeginDisabled();
+        state.disabled = element;
+        style_calls++;
+    }
+
+    if (state.colors != ElementIndex_None && (colors > 0 ? !HaveSameScope(store, state.colors, element, StyleScope_Colors) :
+                                                           !IsScopeTransparent(store, element, StyleScope_Colors))) {
+        ImGui::PopStyleColor(state.color_count);
+        state.colors = ElementIndex_None;
+        style_calls++;
+    }
+    if (colors > 0 && state.colors == ElementIndex_None) {
+        const ElementStyle& style = store.styles[element];
+        if (calls & ElementCalls_TextColor) {
+            ImGui::PushStyleColor(ImGuiCol_Text, style.text_color);
+        }
+        if (calls & ElementCalls_BgColor) {
+            ImGui::PushStyleColor(GetElementTypeInfo(store.types[element]).background, style.bg_color);
+        }
+        state.colors = element;
+        state.color_count = colors;
+        style_calls += colors;
+    }
+
+    const bool width = (calls & ElementCalls_ItemWidth) != 0;
+    if (state.width != ElementIndex_None && (width ? !HaveSameScope(store, state.width, element, StyleScope_ItemWidth) :
+                                                     !IsScopeTransparent(store, element, StyleScope_ItemWidth))) {
+        ImGui::PopItemWidth();
+        state.width = ElementIndex_None;
+        style_calls++;
+    }
+    if (width && state.width == ElementIndex_None) {
+        ImGui::PushItemWidth(store.styles[element].size.x);
+        state.width = element;
+        style_calls++;
+    }
+}
+
+void ElementPreview::EndStyle(StyleState& state) {
+    if (state.colors != ElementIndex_None) {
+        ImGui::PopStyleColor(state.color_count);
+        state.colors = ElementIndex_None;
+        style_calls++;
+    }
+    if (state.width != ElementIndex_None) {
+        ImGui::PopItemWidth();
+        state.width = ElementIndex_None;
+        style_calls++;
+    }
+    if (state.disabled != ElementIndex_None) {
+        ImGui::EndDisabled();
+        state.disabled = ElementIndex_None;
+        style_calls++;
+    }
+}
+
+void ElementPreview::EnterParent(const ElementStore& store, ElementIndex parent) {
+    parents.clear();
+    for (ElementIndex ancestor = parent; ancestor != ElementIndex_None; ancestor = store.links[ancestor].parent) {
+        parents.push_back(ancestor);
+    }
+    // 'parents' is innermost first, 'ancestors' outermost first
+    size_t common = 0;
+    while (common < ancestors.size() && common < parents.size() && ancestors[common].element == parents[parents.size() - 1 - common]) {
+        common++;
+    }
+    while (ancestors.size() > common) {
+        PopScopes(ancestors.back().calls);
+        ancestors.pop_back();
+    }
+    for (size_t n = common; n < parents.size(); n++) {
+        const ElementIndex element = parents[parents.size() - 1 - n];
+        const ElementCalls calls = GetElementCalls(store, element);
+        PushScopes(store, element, calls);
+        ancestors.push_back(AncestorScope{ element, calls });
+    }
+}
+
+void ElementPreview::PushScopes(const ElementStore& store, ElementIndex element, ElementCalls calls) {
+    const ElementStyle& style = store.styles[element];
+    const int count = ((calls & ElementCalls_Disabled) ? 1 : 0) + GetColorCount(calls) + ((calls & ElementCalls_ItemWidth) ? 1 : 0);
+    if (calls & ElementCalls_Disabled) {
+        ImGui::BeginDisabled();
+    }
+    if (calls & ElementCalls_TextColor) {
+        ImGui::PushStyleColor(ImGuiCol_Text, style.text_color);
+    }
+    if (calls & ElementCalls_BgColor) {
+        ImGui::PushStyleColor(GetElementTypeInfo(store.types[element]).background, style.bg_color);
+    }
+    if (calls & ElementCalls_ItemWidth) {
+        ImGui::PushItemWidth(style.size.x);
+    }
+    // Not a run of siblings: one scope per element would reopen them too
+    style_calls += count;
+    unbatched_style_calls += count;
+}
+
+void ElementPreview::PopScopes(ElementCalls calls) {
+    const int colors = GetColorCount(calls);
+    const int count = ((calls & ElementCalls_ItemWidth) ? 1 : 0) + (colors > 0 ? 1 : 0) + ((calls & ElementCalls_Disabled) ? 1 : 0);
+    if (calls & ElementCalls_ItemWidth) {
+        ImGui::PopItemWidth();
+    }
+    if (colors > 0) {
+        ImGui::PopStyleColor(colors);
+    }
+    if (calls & ElementCalls_Disabled) {
+        ImGui::EndDisabled();
+    }
+    style_calls += count;
+    unbatched_style_calls += count;
+}
+
+bool ElementPreview::RenderElement(ElementStore& store, ElementIndex element, StyleState& state) {
+    // The calls generated code makes, see imgui_builder_fold.h
+    const ElementCalls calls = GetElementCalls(store, element);
+    if (!(calls & ElementCalls_Draw)) {
+        return false;
+    }
+
+    const ImU64 start = profiler ? profiler->BeginZone() : 0;
+
+    // Widgets are identified by the element uid, not by hashing "label##id" strings.
+    // The low 32 bits are unique among the first 4 billion elements of a document.
+    ImGui::PushID((int)store.uids[element]);
+
+    // Apply styling
+    ApplyStyle(store, element, calls, state);
+
+    // Interacting with the preview edits the element's values
+    if (GetElementTypeInfo(store.types[element]).render(*this, store, element)) {
+        store.Touch(element);
+    }
+    ImGui::PopID();
+    if (profiler) {
+        profiler->EndZone(ProfileZone_ElementPreview, start, (int)store.types[element]);
+    }
+    return true;
+}
+
+// Content of a component, inside the ID scope of the instance drawing it. It has no preview rows: the children of
+// open tree nodes and headers are followed here.
+void ElementPreview::RenderInstance(ElementStore& store, ElementIndex component) {
+    StyleState state;
+    for (ElementIndex child = store.FirstChild(component); child != ElementIndex_None; child = store.NextSibling(child)) {
+        RenderElement(store, child, state);
+        const ElementType type = store.types[child];
+        const ElementFlags shown = ElementFlags_Visible | ElementFlags_Open;
+        if ((type == ElementType::TREE_NODE || type == ElementType::COLLAPSING_HEADER) && (store.flags[child] & shown) == shown) {
+            // Inside the scopes of the node, still open: it has children, a run of its siblings cannot continue across it
+            if (type == ElementType::TREE_NODE) {
+                ImGui::Indent();
+            }
+            RenderInstance(store, child);
+            if (type == ElementType::TREE_NODE) {
+                ImGui::Unindent();
+            }
+        }
+    }
+    EndStyle(state);
+}
+
+//-----------------------------------------------------------------------------
+// Per-type widgets, the render hooks of the element type table
+//-----------------------------------------------------------------------------
+
+bool ElementTraits<ElementType::BUTTON>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    if (ImGui::Button(store.strings[element].label, store.styles[element].size)) {
+        // Button clicked
+    }
+    return false;
+}
+
+bool ElementTraits<ElementType::CHECKBOX>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    return ImGui::CheckboxFlags(store.strings[element].label, &store.flags[element], ElementFlags_BoolValue);
+}
+
+bool ElementTraits<ElementType::SLIDER_FLOAT>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    const ElementRange& range = store.GetRange(element);
+    return ImGui::SliderFloat(store.strings[element].label, store.EditFloat(element), range.min_value, range.max_value);
+}
+
+bool ElementTraits<ElementType::SLIDER_INT>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    const ElementRange& range = store.GetRange(element);
+    return ImGui::SliderInt(store.strings[element].label, store.EditInt(element), (int)range.min_value, (int)range.max_value);
+}
+
+// SetText() touches the element
+bool ElementTraits<ElementType::INPUT_TEXT>::Render(ElementPreview& preview, ElementStore& store, ElementIndex element) {
+    const ElementStrings& strings = store.strings[element];
+    if (InputString(strings.label, strings.text_value, preview.text_buffer)) {
+        store.SetText(element, preview.text_buffer.data());
+    }
+    return false;
+}
+
+bool ElementTraits<ElementType::INPUT_INT>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    return ImGui::InputInt(store.strings[element].label, store.EditInt(element));
+}
+
+bool ElementTraits<ElementType::INPUT_FLOAT>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    return ImGui::InputFloat(store.strings[element].label, store.EditFloat(element));
+}
+
+bool ElementTraits<ElementType::COMBO>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    ElementItemList& list = *store.EditItemList(element);
+    if (list.count == 0) {
+        return false;
+    }
+    const char* const* items = store.GetItems(element);
+    bool changed = false;
+    if (ImGui::BeginCombo(store.strings[element].label, items[list.selected_item])) {
+        for (int i = 0; i < list.count; ++i) {
+            bool is_selected = (list.selected_item == i);
+            if (ImGui::Selectable(items[i], is_selected)) {
+                list.selected_item = i;
+                changed = true;
+            }
+            if (is_selected) {
+                ImGui::SetItemDefaultFocus();
+            }
+        }
+        ImGui::EndCombo();
+    }
+    return changed;
+}
+
+bool ElementTraits<ElementType::LISTBOX>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    ElementItemList& list = *store.EditItemList(element);
+    return list.count > 0 && ImGui::ListBox(store.strings[element].label, &list.selected_item, store.GetItems(element), list.count);
+}
+
+bool ElementTraits<ElementType::COLOR_PICKER>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    return ImGui::ColorEdit4(store.strings[element].label, (float*)store.EditColor(element));
+}
+
+bool ElementTraits<ElementType::SEPARATOR>::Render(ElementPreview&, ElementStore&, ElementIndex) {
+    ImGui::Separator();
+    return false;
+}
+
+bool ElementTraits<ElementType::TEXT>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    ImGui::Text("%s", store.strings[element].text_value);
+    return false;
+}
+
+bool ElementTraits<ElementType::BULLET_TEXT>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    ImGui::BulletText("%s", store.strings[element].text_value);
+    return false;
+}
+
+// Children are preview rows of their own (see ElementPreview::Render()): only the open state is handled here
+bool ElementTraits<ElementType::TREE_NODE>::Render(ElementPreview& preview, ElementStore& store, ElementIndex element) {
+    const bool open = (store.flags[element] & ElementFlags_Open) != 0;
+    ImGui::SetNextItemOpen(open);
+    if (ImGui::TreeNodeEx(store.strings[element].label, ImGuiTreeNodeFlags_NoTreePushOnOpen) != open) {
+        store.flags[element] ^= ElementFlags_Open;
+        preview.rows_dirty = true;
+    }
+    return false;
+}
+
+bool ElementTraits<ElementType::COLLAPSING_HEADER>::Render(ElementPreview& preview, ElementStore& store, ElementIndex element) {
+    const bool open = (store.flags[element] & ElementFlags_Open) != 0;
+    ImGui::SetNextItemOpen(open);
+    if (ImGui::CollapsingHeader(store.strings[element].label) != open) {
+        store.flags[element] ^= ElementFlags_Open;
+        preview.rows_dirty = true;
+    }
+    return false;
+}
+
+bool ElementTraits<ElementType::PROGRESS_BAR>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    ImGui::ProgressBar(store.GetFloat(element), store.styles[element].size, store.strings[element].label);
+    return false;
+}
+
+bool ElementTraits<ElementType::RADIO_BUTTON>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    return ImGui::RadioButton(store.strings[element].label, store.EditInt(element), 1);
+}
+
+bool ElementTraits<ElementType::SELECTABLE>::Render(ElementPreview&, ElementStore& store, ElementIndex element) {
+    if (!ImGui::Selectable(store.strings[element].label, (store.flags[element] & ElementFlags_BoolValue) != 0)) {
+        return false;
+    }
+    store.flags[element] ^= ElementFlags_BoolValue;
+    return true;
+}
+
+bool ElementTraits<ElementType::SPACING>::Render(ElementPreview&, ElementStore&, ElementIndex) {
+    ImGui::Spacing();
+    return false;
+}
+
+bool ElementTraits<ElementType::SAME_LINE>::Render(ElementPreview&, ElementStore&, ElementIndex) {
+    ImGui::SameLine();
+    return false;
+}
+
+bool ElementTraits<ElementType::NEW_LINE>::Render(ElementPreview&, ElementStore&, ElementIndex) {
+    ImGui::NewLine();
+    return false;
+}
+
+bool ElementTraits<ElementType::INDENT>::Render(ElementPreview&, ElementStore&, ElementIndex) {
+    ImGui::Indent();
+    return false;
+}
+
+bool ElementTraits<ElementType::UNINDENT>::Render(ElementPreview&, ElementStore&, ElementIndex) {
+    ImGui::Unindent();
+    return false;
+}
+
+bool ElementTraits<ElementType::INSTANCE>::Render(ElementPreview& preview, ElementStore& store, ElementIndex element) {
+    const char* name = store.strings[element].text_value;
+    if (preview.components.IsStale(store)) {
+        preview.components.Build(store);
+    }
+    const ElementIndex component = preview.components.Find(name);
+    if (component == ElementIndex_None) {
+        ImGui::TextDisabled("No component \"%s\"", name);
+        return false;
+    }
+    ImGui::BeginGroup();
+    preview.RenderInstance(store, component);
+    ImGui::EndGroup();
+    ImGui::SetItemTooltip("Instance of \"%s\": its values are those of the definition, shared by every "
+                          "instance here. Generated code keeps them per instance.", name);
+    return false;
+}
@@ -0,0 +1,91 @@
+// ULTIMATE ImGui Builder: document preview
+// Draws a document with the real Dear ImGui widgets, the way the generated code will. Used by the builder's preview
+// window and by applications showing a document received from the builder (see imgui_builder_live.h).
+// Only the rows inside the visible part of the window are drawn (see imgui_builder_rows.h).
+// Consecutive siblings with the same disabled state, colors or item width share one style scope, like in generated
+// code (see imgui_builder_fold.h). The runs are found while drawing, from the same rules: rows above the view are not
+// drawn, and the rows of the children of an open tree node come between it and its next sibling, which closes the
+// scope. Those rows are drawn inside the scopes of the node and of its ancestors, reopened where they start: children
+// inherit the disabled state, colors and item width of their tree node or header, as in generated code.
+// Interacting with the widgets edits the element values, like using the generated UI would.
+// Instances of a component draw its content in their own ID scope but edit the values of the definition: the
+// document has one set of values per component (generated code and LayoutProgram keep one per instance), which the
+// tooltip of an instance says.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_components.h"
+#include "imgui_builder_fold.h"
+#include "imgui_builder_rows.h"
+#include "imgui_builder_store.h"
+#include "imgui_builder_types.h"
+#include <vector>
+
+class FrameProfiler;
+
+class ElementPreview {
+public:
+    // 'profiler': times every element drawn into ProfileZone_ElementPreview (nullptr: not timed)
+    explicit ElementPreview(FrameProfiler* profiler = nullptr) : profiler(profiler) {}
+
+    // Draw 'store' into the current window
+    void Render(ElementStore& store);
+    // Rows are rebuilt by themselves when the tree changes shape. Call this when elements were shown, hidden,
+    // opened or closed without that (flag edits), or when 'store' is another document.
+    void Invalidate() { rows_dirty = true; }
+    // Style stack calls of the last Render() (BeginDisabled(), EndDisabled(), PushStyleColor(), PopStyleColor(),
+    // PushItemWidth(), PopItemWidth()), and how many one scope per element would have made
+    int GetStyleCalls() const { return style_calls; }
+    int GetUnbatchedStyleCalls() const { return unbatched_style_calls; }
+
+private:
+    // The render hooks draw the widgets (see imgui_builder_types.h)
+    template <ElementType Type> friend struct ElementTraits;
+
+    // Scopes open for the siblings being drawn
+    struct StyleState {
+        ElementIndex parent = ElementIndex_None;
+        ElementIndex disabled = ElementIndex_None;  // First element of the disabled run
+        ElementIndex colors = ElementIndex_None;    // Element whose colors are pushed
+        int color_count = 0;
+        ElementIndex width = ElementIndex_None;     // Element whose item width is pushed
+    };
+
+    // Scopes of an open tree node or header, around the rows of its children
+    struct AncestorScope {
+        ElementIndex element;
+        ElementCalls calls;         // What was pushed: GetElementCalls() of the element then
+    };
+
+    // False if it draws nothing: hidden or folded away
+    bool RenderElement(ElementStore& store, ElementIndex element, StyleState& state);
+    void RenderInstance(ElementStore& store, ElementIndex component);
+    // Continue the scopes of 'state' or close them and open the ones of 'element'
+    void ApplyStyle(const ElementStore& store, ElementIndex element, ElementCalls calls, StyleState& state);
+    void EndStyle(StyleState& state);
+    // Rows of 'parent' follow: keep the scopes of the ancestors it shares with the rows drawn before, reopen its own
+    // and those of its other ancestors, outermost first
+    void EnterParent(const ElementStore& store, ElementIndex parent);
+    void PushScopes(const ElementStore& store, ElementIndex element, ElementCalls calls);
+    void PopScopes(ElementCalls calls);
+
+    std::vector<ElementRow> items;
+    std::vector<PreviewRow> rows;
+    RowHeights heights;
+    std::vector<AncestorScope> ancestors;   // Outermost first
+    std::vector<ElementIndex> parents;      // EnterParent() scratch
+    ElementRevision rows_revision = 0;
+    bool rows_dirty = true;
+    FrameProfiler* profiler;
+    ComponentTable components;      // Built when an instance is drawn and the document changed
+    int style_calls = 0;
+    int unbatched_style_calls = 0;
+    // Text being edited by INPUT_TEXT elements (see InputString())
+    std::vector<char> text_buffer;
+};
+
+// Text field editing an interned string: the widget edits a copy in 'buffer', which holds the new text when it
+// returns true. The buffer keeps its size from frame to frame, so text fields cost no allocation once it fits the
+// longest text shown, and ImGui grows it while typing (no length limit).
+bool InputString(const char* label, const char* text, std::vector<char>& buffer, bool multiline = false);
@@ -0,0 +1,213 @@
+// ULTIMATE ImGui Builder: frame profiler
+// See imgui_builder_profiler.h
+
+#include "imgui_builder_profiler.h"
+#include "imgui_builder_json.h"
+#include <float.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+static const char* const g_ZoneNames[ProfileZone_COUNT] = { "Frame", "Element Tree", "Properties", "Preview", "Element Preview" };
+
+ImU64 FrameProfiler::Now() {
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FrameProfiler::FrameProfiler() {
+    memset(frame_ns, 0, sizeof(frame_ns));
+    memset(frame_calls, 0, sizeof(frame_calls));
+    memset(histories, 0, sizeof(histories));
+    memset(last_calls, 0, sizeof(last_calls));
+}
+
+void FrameProfiler::SetEnabled(bool enable) {
+    enabled = enable;
+    if (!enabled) {
+        tracing = false;
+    }
+}
+
+void FrameProfiler::BeginFrame() {
+    if (!enabled) {
+        return;
+    }
+    memset(frame_ns, 0, sizeof(frame_ns));
+    memset(frame_calls, 0, sizeof(frame_calls));
+    frame_scope_count = 0;
+    frame_start = Now();
+}
+
+void FrameProfiler::EndFrame() {
+    if (!enabled) {
+        return;
+    }
+    EndZone(ProfileZone_Frame, frame_start);
+    for (int history = 0; history < HISTORY_COUNT; history++) {
+        histories[history][history_offset] = (float)(frame_ns[history] / 1e6);
+        last_calls[history] = frame_calls[history];
+    }
+    history_offset = (history_offset + 1) % HISTORY_FRAMES;
+    last_scope_count = frame_scope_count;
+}
+
+void FrameProfiler::EndZone(int zone, ImU64 start, int element_type) {
+    if (start == 0) {
+        return;
+    }
+    const ImU64 end = Now();
+    const ImU64 duration = end - start;
+    frame_ns[zone] += duration;
+    frame_calls[zone]++;
+    if (element_type >= 0) {
+        frame_ns[ProfileZone_COUNT + element_type] += duration;
+        frame_calls[ProfileZone_COUNT + element_type]++;
+    }
+    frame_scope_count++;
+
+    if (tracing) {
+        if (trace_events.size() == trace_capacity) {
+            tracing = false;
+            return;
+        }
+        const TraceEvent event = { start, (ImU32)duration, (ImU16)zone, (ImS16)element_type };
+        trace_events.push_back(event);
+    }
+}
+
+void FrameProfiler::StartTrace(int max_events) {
+    trace_events.clear();
+    trace_events.reserve(max_events);
+    trace_capacity = (size_t)max_events;
+    trace_start = Now();
+    tracing = enabled;
+}
+
+bool FrameProfiler::ExportTrace(const char* path, std::string* error) const {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        if (error) {
+            *error = "Cannot open ";
+            *error += path;
+        }
+        return false;
+    }
+    bool ok;
+    {
+        // Complete ("X") events, timestamps in microseconds from the start of the recording
+        JsonWriter writer(f);
+        writer.BeginObject();
+        writer.Key("displayTimeUnit");
+        writer.String("ns");
+        writer.Key("traceEvents");
+        writer.BeginArray();
+        for (const TraceEvent& event : trace_events) {
+            writer.BeginObject();
+            writer.Key("name");
+            writer.String(event.element_type >= 0 ? GetElementTypeName((ElementType)event.element_type) : g_ZoneNames[event.zone]);
+            writer.Key("cat");
+            writer.String(g_ZoneNames[event.zone]);
+            writer.Key("ph");
+            writer.String("X");
+            writer.Key("ts");
+            writer.Double((double)(event.start - trace_start) / 1000.0);
+            writer.Key("dur");
+            writer.Double(event.duration / 1000.0);
+            writer.Key("pid");
+            writer.Int(1);
+            writer.Key("tid");
+            writer.Int(1);
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+        ok = writer.Flush();
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok && error) {
+        *error = "Cannot write ";
+        *error += path;
+    }
+    return ok;
+}
+
+void FrameProfiler::RenderWindow(bool* p_open) {
+    ImGui::SetNextWindowSize(ImVec2(420, 520), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", p_open)) {
+        ImGui::End();
+        return;
+    }
+
+    bool enable = enabled;
+    if (ImGui::Checkbox("Enabled", &enable)) {
+        SetEnabled(enable);
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("%d scopes/frame", last_scope_count);
+
+    // Panels: rolling history of the last frames, with average and worst
+    const int last = (history_offset + HISTORY_FRAMES - 1) % HISTORY_FRAMES;
+    for (int zone = 0; zone < ProfileZone_COUNT; zone++) {
+        float sum = 0.0f, max = 0.0f;
+        for (int n = 0; n < HISTORY_FRAMES; n++) {
+            sum += histories[zone][n];
+            max = histories[zone][n] > max ? histories[zone][n] : max;
+        }
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "%.3f ms (avg %.3f, max %.3f)", histories[zone][last], sum / HISTORY_FRAMES, max);
+        ImGui::PlotHistogram(g_ZoneNames[zone], histories[zone], HISTORY_FRAMES, history_offset, overlay, 0.0f, FLT_MAX, ImVec2(0, 40));
+    }
+
+    // Element types drawn in the last frame
+    if (ImGui::BeginTable("Types", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Total us");
+        ImGui::TableSetupColumn("Avg us");
+        ImGui::TableHeadersRow();
+        for (int type = 0; type < ElementType_COUNT; type++) {
+            const int history = ProfileZone_COUNT + type;
+            if (last_calls[history] == 0) {
+                continue;
+            }
+            const float total_us = histories[history][last] * 1000.0f;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(GetElementTypeName((ElementType)type));
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", last_calls[history]);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", total_us);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", total_us / last_calls[history]);
+        }
+        ImGui::EndTable();
+    }
+
+    // Trace
+    ImGui::Separator();
+    ImGui::InputText("Trace File", trace_path, sizeof(trace_path));
+    if (tracing) {
+        ImGui::Text("Recording: %d events", (int)trace_events.size());
+        ImGui::SameLine();
+        if (ImGui::Button("Stop")) {
+            StopTrace();
+        }
+    } else if (ImGui::Button("Record Trace")) {
+        StartTrace(200000);
+        trace_status.clear();
+    }
+    if (!tracing && !trace_events.empty()) {
+        ImGui::SameLine();
+        if (ImGui::Button("Export Trace")) {
+            if (ExportTrace(trace_path, &trace_status)) {
+                trace_status = "Exported ";
+                trace_status += trace_path;
+            }
+        }
+    }
+    if (!trace_status.empty()) {
+        ImGui::TextUnformatted(trace_status.c_str());
+    }
+    ImGui::End();
+}
@@ -0,0 +1,424 @@
+// ULTIMATE ImGui Builder: binary project files
+// See imgui_builder_project.h
+
+#include "imgui_builder_project.h"
+#include "imgui_builder_json.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(ProjectFileHeader) == 64, "ProjectFileHeader layout is part of the file format");
+static_assert(sizeof(ProjectFileNode) == 120, "ProjectFileNode layout is part of the file format");
+
+// Flags worth persisting (the others describe the in-memory slot)
+static const ImU32 PROJECT_FILE_NODE_FLAGS = ElementFlags_Enabled | ElementFlags_Visible | ElementFlags_BoolValue | ElementFlags_Open;
+
+static void SetError(std::string* error, const char* message, const char* path) {
+    if (error) {
+        *error = message;
+        *error += ": ";
+        *error += path;
+    }
+}
+
+static ImU64 AlignOffset(ImU64 offset) {
+    return (offset + 7) & ~(ImU64)7;
+}
+
+//-----------------------------------------------------------------------------
+// ProjectFileView
+//-----------------------------------------------------------------------------
+
+ProjectFileView::~ProjectFileView() {
+#ifdef _WIN32
+    if (data) {
+        ::UnmapViewOfFile(data);
+    }
+    if (mapping) {
+        ::CloseHandle((HANDLE)mapping);
+    }
+#else
+    if (data) {
+        munmap((void*)data, file_size);
+    }
+#endif
+}
+
+std::shared_ptr<ProjectFileView> ProjectFileView::Open(const char* path, std::string* error) {
+    std::shared_ptr<ProjectFileView> view(new ProjectFileView());
+
+#ifdef _WIN32
+    wchar_t wpath[MAX_PATH];
+    if (::MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, MAX_PATH) == 0) {
+        SetError(error, "Invalid path", path);
+        return nullptr;
+    }
+    // FILE_SHARE_DELETE lets SaveProjectBinary() replace a file that is still mapped by a loaded document.
+    HANDLE file = ::CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        SetError(error, "Cannot open file", path);
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(ProjectFileHeader)) {
+        ::CloseHandle(file);
+        SetError(error, "Not a project file", path);
+        return nullptr;
+    }
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (!mapping) {
+        SetError(error, "Cannot map file", path);
+        return nullptr;
+    }
+    view->mapping = mapping;
+    view->file_size = (size_t)size.QuadPart;
+    view->data = (const char*)::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        SetError(error, "Cannot open file", path);
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ProjectFileHeader)) {
+        close(fd);
+        SetError(error, "Not a project file", path);
+        return nullptr;
+    }
+    view->file_size = (size_t)st.st_size;
+    void* data = mmap(nullptr, view->file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    view->data = (data == MAP_FAILED) ? nullptr : (const char*)data;
+#endif
+    if (!view->data) {
+        SetError(error, "Cannot map file", path);
+        return nullptr;
+    }
+    if (!view->Validate(error)) {
+        if (error) {
+            *error += ": ";
+            *error += path;
+        }
+        return nullptr;
+    }
+    return view;
+}
+
+// Check every offset and range once, so that readers can index the file without further bounds checks.
+bool ProjectFileView::Validate(std::string* error) {
+    header = (const ProjectFileHeader*)data;
+    if (memcmp(header->magic, PROJECT_FILE_MAGIC, 4) != 0) {
+        if (error) *error = "Not a project file";
+        return false;
+    }
+    if (header->version != PROJECT_FILE_VERSION || header->header_size != sizeof(ProjectFileHeader) || header->node_size != sizeof(ProjectFileNode)) {
+        if (error) *error = "Unsupported project file version";
+        return false;
+    }
+
+    const ImU64 size = file_size;
+    if (header->nodes_offset % 8 != 0 || header->items_offset % 4 != 0 ||
+        header->nodes_offset > size || (size - header->nodes_offset) / sizeof(ProjectFileNode) < header->node_count ||
+        header->items_offset > size || (size - header->items_offset) / sizeof(ImU32) < header->item_count ||
+        header->strings_offset > size || size - header->strings_offset < header->strings_size ||
+        header->strings_size == 0 || header->root_count > header->node_count) {
+        if (error) *error = "Corrupted project file (sections)";
+        return false;
+    }
+    nodes = (const ProjectFileNode*)(data + header->nodes_offset);
+    items = (const ImU32*)(data + header->items_offset);
+    strings = data + header->strings_offset;
+    const ImU64 strings_size = header->strings_size;
+    if (strings[0] != 0 || strings[strings_size - 1] != 0 || header->name >= strings_size) {
+        if (error) *error = "Corrupted project file (strings)";
+        return false;
+    }
+    for (ImU32 n = 0; n < header->item_count; n++) {
+        if (items[n] >= strings_size) {
+            if (error) *error = "Corrupted project file (items)";
+            return false;
+        }
+    }
+
+    // Children ranges must be handed out in order, each node being the child of exactly one earlier node. The selected
+    // item indexes the node's items (0 without items).
+    ImU64 next_child = header->root_count;
+    for (ImU32 n = 0; n < header->node_count; n++) {
+        const ProjectFileNode& node = nodes[n];
+        if (node.type >= ElementType_COUNT || node.uid == 0 || node.label >= strings_size || node.text_value >= strings_size ||
+            node.items_first > header->item_count || header->item_count - node.items_first < node.items_count ||
+            (n >= header->root_count && n >= next_child) ||
+            (node.child_count > 0 && node.first_child != next_child) ||
+            node.selected_item < 0 || (node.items_count > 0 ? (ImU32)node.selected_item >= node.items_count : node.selected_item != 0)) {
+            if (error) *error = "Corrupted project file (nodes)";
+            return false;
+        }
+        next_child += node.child_count;
+        if (next_child > header->node_count) {
+            if (error) *error = "Corrupted project file (nodes)";
+            return false;
+        }
+    }
+    if (next_child != header->node_count) {
+        if (error) *error = "Corrupted project file (nodes)";
+        return false;
+    }
+
+    std::vector<ImU64> uids(header->node_count);
+    for (ImU32 n = 0; n < header->node_count; n++) {
+        uids[n] = nodes[n].uid;
+    }
+    std::sort(uids.begin(), uids.end());
+    if (std::adjacent_find(uids.begin(), uids.end()) != uids.end()) {
+        if (error) *error = "Corrupted project file (duplicate uids)";
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Save
+//-----------------------------------------------------------------------------
+
+namespace {
+// String table builder. Interned strings are deduplicated by address.
+struct StringTableWriter {
+    std::vector<char> data;
+    std::unordered_map<const char*, ImU32> offsets;
+
+    StringTableWriter() { data.push_back(0); }
+
+    ImU32 Add(const char* str) {
+        if (!str || !str[0]) {
+            return 0;
+        }
+        auto it = offsets.find(str);
+        if (it != offsets.end()) {
+            return it->second;
+        }
+        const ImU32 offset = (ImU32)data.size();
+        data.insert(data.end(), str, str + strlen(str) + 1);
+        offsets[str] = offset;
+        return offset;
+    }
+};
+}
+
+static bool WriteAt(FILE* f, ImU64 offset, const void* src, size_t size) {
+    static const char zeros[8] = {};
+    long pos = ftell(f);
+    if (pos < 0 || (ImU64)pos > offset || fwrite(zeros, 1, (size_t)(offset - (ImU64)pos), f) != (size_t)(offset - (ImU64)pos)) {
+        return false;
+    }
+    return size == 0 || fwrite(src, 1, size, f) == size;
+}
+
+bool ReplaceProjectFile(const char* temp_path, const char* path) {
+#ifdef _WIN32
+    wchar_t wtemp[MAX_PATH], wpath[MAX_PATH];
+    return ::MultiByteToWideChar(CP_UTF8, 0, temp_path, -1, wtemp, MAX_PATH) != 0 &&
+        ::MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, MAX_PATH) != 0 &&
+        ::MoveFileExW(wtemp, wpath, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(temp_path, path) == 0;
+#endif
+}
+
+bool SaveProjectBinary(const ElementStore& store, const char* name, const char* path, std::string* error) {
+    // Breadth-first order: the children of every node end up in one contiguous range
+    std::vector<ElementIndex> order;
+    order.reserve(store.Size());
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        order.push_back(root);
+    }
+    const ImU32 root_count = (ImU32)order.size();
+
+    StringTableWriter string_table;
+    std::vector<ImU32> items;
+    std::vector<ProjectFileNode> nodes;
+    nodes.reserve(store.Size());
+    for (size_t n = 0; n < order.size(); n++) {
+        const ElementIndex index = order[n];
+        const ElementValues value = store.GetValues(index);
+        const ElementStrings& strings = store.strings[index];
+        const ElementStyle& style = store.styles[index];
+        const ImVec4& color = store.GetColor(index);
+        const int item_count = store.GetItemCount(index);
+
+        ProjectFileNode node;
+        memset(&node, 0, sizeof(node));
+        node.type = (ImU8)store.types[index];
+        node.flags = store.flags[index] & PROJECT_FILE_NODE_FLAGS;
+        node.uid = store.uids[index];
+        node.int_value = value.int_value;
+        node.float_value = value.float_value;
+        node.min_value = value.min_value;
+        node.max_value = value.max_value;
+        node.selected_item = value.selected_item;
+        node.label = string_table.Add(strings.label);
+        node.text_value = string_table.Add(strings.text_value);
+        node.items_first = (ImU32)items.size();
+        node.items_count = (ImU32)item_count;
+        for (int i = 0; i < item_count; i++) {
+            items.push_back(string_table.Add(store.GetItems(index)[i]));
+        }
+        node.first_child = (ImU32)order.size();
+        for (ElementIndex child = store.FirstChild(index); child != ElementIndex_None; child = store.NextSibling(child)) {
+            order.push_back(child);
+        }
+        node.child_count = (ImU32)order.size() - node.first_child;
+        if (node.child_count == 0) {
+            node.first_child = 0;
+        }
+        node.size[0] = style.size.x; node.size[1] = style.size.y;
+        memcpy(node.text_color, &style.text_color, sizeof(node.text_color));
+        memcpy(node.bg_color, &style.bg_color, sizeof(node.bg_color));
+        memcpy(node.color_value, &color, sizeof(node.color_value));
+        nodes.push_back(node);
+    }
+
+    ProjectFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PROJECT_FILE_MAGIC, 4);
+    header.version = PROJECT_FILE_VERSION;
+    header.header_size = sizeof(ProjectFileHeader);
+    header.node_size = sizeof(ProjectFileNode);
+    header.node_count = (ImU32)nodes.size();
+    header.root_count = root_count;
+    header.item_count = (ImU32)items.size();
+    header.name = string_table.Add(name);
+    header.nodes_offset = AlignOffset(sizeof(ProjectFileHeader));
+    header.items_offset = AlignOffset(header.nodes_offset + nodes.size() * sizeof(ProjectFileNode));
+    header.strings_offset = AlignOffset(header.items_offset + items.size() * sizeof(ImU32));
+    header.strings_size = string_table.data.size();
+
+    // Write next to the destination, then swap: the destination may be mapped by a loaded document.
+    std::string temp_path = path;
+    temp_path += ".tmp";
+    FILE* f = fopen(temp_path.c_str(), "wb");
+    if (!f) {
+        SetError(error, "Cannot write file", temp_path.c_str());
+        return false;
+    }
+    bool ok = WriteAt(f, 0, &header, sizeof(header)) &&
+        WriteAt(f, header.nodes_offset, nodes.data(), nodes.size() * sizeof(ProjectFileNode)) &&
+        WriteAt(f, header.items_offset, items.data(), items.size() * sizeof(ImU32)) &&
+        WriteAt(f, header.strings_offset, string_table.data.data(), string_table.data.size());
+    ok = (fclose(f) == 0) && ok;
+    ok = ok && ReplaceProjectFile(temp_path.c_str(), path);
+    if (!ok) {
+        remove(temp_path.c_str());
+        SetError(error, "Cannot write file", path);
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Load
+//-----------------------------------------------------------------------------
+
+bool LoadProjectBinary(ElementStore& store, const char* path, const char** out_name, std::string* error) {
+    std::shared_ptr<ProjectFileView> view = ProjectFileView::Open(path, error);
+    if (!view) {
+        return false;
+    }
+
+    const ProjectFileHeader& header = view->GetHeader();
+    const ProjectFileNode* nodes = view->GetNodes();
+
+    store.Clear();
+    store.Reserve((int)header.node_count);
+    store.string_pool.KeepAlive(view);
+
+    // Items: one block of pointers into the mapped string table
+    const int items_base = store.AllocItems((int)header.item_count);
+    for (ImU32 n = 0; n < header.item_count; n++) {
+        store.item_pool[items_base + n] = view->GetItem(n);
+    }
+
+    // Nodes: slots are handed out in file order from the freshly cleared store
+    const ElementIndex base = (ElementIndex)store.types.size();
+    for (ImU32 n = 0; n < header.node_count; n++) {
+        const ProjectFileNode& node = nodes[n];
+        const ElementIndex index = store.Create((ElementType)node.type);
+        IM_ASSERT(index == base + (ElementIndex)n);
+        store.flags[index] = ElementFlags_Alive | (node.flags & PROJECT_FILE_NODE_FLAGS);
+        store.SetUid(index, node.uid);
+
+        ElementValues value;
+        value.int_value = node.int_value;
+        value.float_value = node.float_value;
+        value.min_value = node.min_value;
+        value.max_value = node.max_value;
+        value.selected_item = node.selected_item;
+        store.SetValues(index, value);
+        if (ElementItemList* items = store.EditItemList(index)) {
+            items->offset = items_base + (int)node.items_first;
+            items->count = (int)node.items_count;
+        }
+
+        ElementStrings& strings = store.strings[index];
+        strings.label = view->GetString(node.label);
+        strings.text_value = view->GetString(node.text_value);
+
+        ElementStyle& style = store.styles[index];
+        style.size = ImVec2(node.size[0], node.size[1]);
+        memcpy(&style.text_color, node.text_color, sizeof(node.text_color));
+        memcpy(&style.bg_color, node.bg_color, sizeof(node.bg_color));
+        if (ImVec4* color = store.EditColor(index)) {
+            memcpy(color, node.color_value, sizeof(node.color_value));
+        }
+    }
+
+    // Links
+    for (ImU32 n = 0; n < header.root_count; n++) {
+        store.Append(ElementIndex_None, base + (ElementIndex)n);
+    }
+    for (ImU32 n = 0; n < header.node_count; n++) {
+        for (ImU32 child = 0; child < nodes[n].child_count; child++) {
+            store.Append(base + (ElementIndex)n, base + (ElementIndex)(nodes[n].first_child + child));
+        }
+    }
+
+    if (out_name) {
+        *out_name = view->GetString(header.name);
+    }
+    return true;
+}
+
+bool IsJsonProjectPath(const char* path) {
+    const size_t length = strlen(path);
+    if (length < 5) {
+        return false;
+    }
+    for (int n = 0; n < 5; n++) {
+        if (tolower((unsigned char)path[length - 5 + n]) != ".json"[n]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SaveProjectFile(const ElementStore& store, const char* name, const char* path, std::string* error) {
+    return IsJsonProjectPath(path) ? SaveProjectJson(store, name, path, error) : SaveProjectBinary(store, name, path, error);
+}
+
+bool LoadProjectFile(ElementStore& store, const char* path, const char** out_name, std::string* error) {
+    return IsJsonProjectPath(path) ? LoadProjectJson(store, path, out_name, error) : LoadProjectBinary(store, path, out_name, error);
+}
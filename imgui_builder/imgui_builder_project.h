@@ -0,0 +1,100 @@
+// ULTIMATE ImGui Builder: binary project files
+// Layout of a .imgb file (little-endian, every section 8-byte aligned):
+//   ProjectFileHeader
+//   ProjectFileNode[node_count]   fixed-size records in breadth-first order: the children of a node are
+//                                 the contiguous range [first_child, first_child + child_count)
+//   ImU32[item_count]             combo/listbox items, as string table offsets
+//   char[strings_size]            string table: zero-terminated strings, offset 0 is the empty string
+// Files are memory-mapped on load: strings are used in place from the mapping (no copy, no parse),
+// and node records are converted to ElementStore slots in a single linear pass.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <memory>
+#include <string>
+
+#define PROJECT_FILE_MAGIC      "IMGB"
+#define PROJECT_FILE_VERSION    2     // 2: element uids replace id strings
+
+struct ProjectFileHeader {
+    char magic[4];
+    ImU32 version;
+    ImU32 header_size;
+    ImU32 node_size;
+    ImU32 node_count;
+    ImU32 root_count;           // Nodes [0, root_count) are top-level elements
+    ImU32 item_count;
+    ImU32 name;                 // Menu name, string table offset
+    ImU64 nodes_offset;
+    ImU64 items_offset;
+    ImU64 strings_offset;
+    ImU64 strings_size;
+};
+
+struct ProjectFileNode {
+    ImU8 type;
+    ImU8 reserved[3];
+    ImU32 flags;                // ElementFlags_Enabled / Visible / BoolValue / Open
+    ImU64 uid;                  // Unique in the file, not 0
+    ImS32 int_value;
+    float float_value;
+    float min_value;
+    float max_value;
+    ImS32 selected_item;
+    ImU32 label;                // String table offsets
+    ImU32 text_value;
+    ImU32 items_first;          // Range of the item table
+    ImU32 items_count;
+    ImU32 first_child;          // Range of the node array
+    ImU32 child_count;
+    float size[2];
+    float text_color[4];
+    float bg_color[4];
+    float color_value[4];
+    ImU32 reserved2;            // Keeps the node size a multiple of 8
+};
+
+// Read-only view of a validated, memory-mapped project file.
+class ProjectFileView {
+public:
+    ~ProjectFileView();
+
+    // Map and validate a file. Returns nullptr on failure (missing file, bad magic/version, out of range offsets,
+    // duplicate uids).
+    static std::shared_ptr<ProjectFileView> Open(const char* path, std::string* error = nullptr);
+
+    const ProjectFileHeader& GetHeader() const { return *header; }
+    const ProjectFileNode* GetNodes() const { return nodes; }
+    const char* GetString(ImU32 offset) const { return strings + offset; }
+    const char* GetItem(ImU32 index) const { return strings + items[index]; }
+    size_t GetFileSize() const { return file_size; }
+
+private:
+    ProjectFileView() {}
+    bool Validate(std::string* error);
+
+    void* mapping = nullptr;        // Platform mapping handle (Win32 only)
+    const char* data = nullptr;
+    size_t file_size = 0;
+    const ProjectFileHeader* header = nullptr;
+    const ProjectFileNode* nodes = nullptr;
+    const ImU32* items = nullptr;
+    const char* strings = nullptr;
+};
+
+// Move a fully written temporary file over 'path' (which may be mapped by a loaded document).
+bool ReplaceProjectFile(const char* temp_path, const char* path);
+
+// Save a whole document. 'name' is the menu name stored along with the elements.
+bool SaveProjectBinary(const ElementStore& store, const char* name, const char* path, std::string* error = nullptr);
+
+// Replace the content of 'store' with a project file. The store keeps the file mapped and its strings point into it.
+// On success '*out_name' (optional) receives the menu name, valid until the store is cleared.
+bool LoadProjectBinary(ElementStore& store, const char* path, const char** out_name = nullptr, std::string* error = nullptr);
+
+// Projects are binary unless the path ends with ".json" (see imgui_builder_json.h)
+bool IsJsonProjectPath(const char* path);
+bool SaveProjectFile(const ElementStore& store, const char* name, const char* path, std::string* error = nullptr);
+bool LoadProjectFile(ElementStore& store, const char* path, const char** out_name = nullptr, std::string* error = nullptr);
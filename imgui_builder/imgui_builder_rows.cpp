@@ -0,0 +1,138 @@
+// ULTIMATE ImGui Builder: flattened rows for the virtualized panels
+// See imgui_builder_rows.h
+
+#include "imgui_builder_rows.h"
+
+static void AddTreeRows(const ElementStore& store, ElementIndex parent, int depth, std::vector<ElementRow>& rows) {
+    for (ElementIndex child = store.FirstChild(parent); child != ElementIndex_None; child = store.NextSibling(child)) {
+        rows.push_back(ElementRow{ child, depth });
+        if (store.flags[child] & ElementFlags_Expanded) {
+            AddTreeRows(store, child, depth + 1, rows);
+        }
+    }
+}
+
+void BuildTreeRows(const ElementStore& store, std::vector<ElementRow>& rows) {
+    rows.clear();
+    AddTreeRows(store, ElementIndex_None, 0, rows);
+}
+
+static void AddFilteredTreeRows(const ElementStore& store, const std::vector<unsigned char>& marks, ElementIndex parent, int depth, std::vector<ElementRow>& rows) {
+    for (ElementIndex child = store.FirstChild(parent); child != ElementIndex_None; child = store.NextSibling(child)) {
+        if (!marks[child]) {
+            continue;
+        }
+        rows.push_back(ElementRow{ child, depth });
+        if (marks[child] & TreeRowMark_Ancestor) {
+            AddFilteredTreeRows(store, marks, child, depth + 1, rows);
+        }
+    }
+}
+
+void BuildFilteredTreeRows(const ElementStore& store, const std::vector<ElementIndex>& matches, std::vector<unsigned char>& marks, std::vector<ElementRow>& rows) {
+    marks.assign(store.types.size(), 0);
+    for (ElementIndex match : matches) {
+        marks[match] |= TreeRowMark_Match;
+        // Stop at the first ancestor already marked: everything above it is too
+        for (ElementIndex parent = store.links[match].parent; parent != ElementIndex_None && !(marks[parent] & TreeRowMark_Ancestor); parent = store.links[parent].parent) {
+            marks[parent] |= TreeRowMark_Ancestor;
+        }
+    }
+    rows.clear();
+    AddFilteredTreeRows(store, marks, ElementIndex_None, 0, rows);
+}
+
+namespace {
+struct PreviewRowBuilder {
+    const ElementStore& store;
+    std::vector<ElementRow>& items;
+    std::vector<PreviewRow>& rows;
+    int indent = 0;             // INDENT minus UNINDENT so far
+    bool join = false;          // The last item was a SAME_LINE
+
+    PreviewRowBuilder(const ElementStore& s, std::vector<ElementRow>& i, std::vector<PreviewRow>& r) : store(s), items(i), rows(r) {}
+
+    void Add(ElementIndex parent, int depth) {
+        for (ElementIndex child = store.FirstChild(parent); child != ElementIndex_None; child = store.NextSibling(child)) {
+            const ElementFlags flags = store.flags[child];
+            const ElementType type = store.types[child];
+            // Component definitions are drawn by their instances (see ElementPreview::RenderInstance())
+            if (!(flags & ElementFlags_Visible) || type == ElementType::COMPONENT) {
+                continue;
+            }
+            if ((join || type == ElementType::SAME_LINE) && !rows.empty()) {
+                rows.back().count++;
+            } else {
+                rows.push_back(PreviewRow{ (int)items.size(), 1, depth + indent });
+            }
+            items.push_back(ElementRow{ child, depth });
+            join = type == ElementType::SAME_LINE;
+
+            if (type == ElementType::INDENT) {
+                indent++;
+            } else if (type == ElementType::UNINDENT) {
+                indent--;
+            } else if ((type == ElementType::TREE_NODE || type == ElementType::COLLAPSING_HEADER) && (flags & ElementFlags_Open)) {
+                Add(child, type == ElementType::TREE_NODE ? depth + 1 : depth);
+            }
+        }
+    }
+};
+}
+
+void BuildPreviewRows(const ElementStore& store, std::vector<ElementRow>& items, std::vector<PreviewRow>& rows) {
+    items.clear();
+    rows.clear();
+    PreviewRowBuilder builder(store, items, rows);
+    builder.Add(ElementIndex_None, 0);
+}
+
+void RowHeights::Reset(int count, float height) {
+    heights.assign(count, height);
+    // Linear-time build: each node passes its sum on to its parent
+    tree.assign(count + 1, 0.0);
+    for (int i = 1; i <= count; i++) {
+        tree[i] += height;
+        const int parent = i + (i & -i);
+        if (parent <= count) {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+void RowHeights::Set(int row, float height) {
+    const double delta = (double)height - heights[row];
+    if (delta == 0.0) {
+        return;
+    }
+    heights[row] = height;
+    for (int i = row + 1; i < (int)tree.size(); i += i & -i) {
+        tree[i] += delta;
+    }
+}
+
+float RowHeights::Offset(int row) const {
+    double sum = 0.0;
+    for (int i = row; i > 0; i -= i & -i) {
+        sum += tree[i];
+    }
+    return (float)sum;
+}
+
+int RowHeights::FindRow(float offset) const {
+    const int count = Size();
+    int step = 1;
+    while (step * 2 <= count) {
+        step *= 2;
+    }
+    // Largest 'row' such that the rows before it end at or above 'offset'
+    int row = 0;
+    double remaining = offset;
+    for (; step > 0; step /= 2) {
+        if (row + step <= count && tree[row + step] <= remaining) {
+            row += step;
+            remaining -= tree[row];
+        }
+    }
+    return row;
+}
@@ -0,0 +1,59 @@
+// ULTIMATE ImGui Builder: flattened rows for the virtualized panels
+// The element tree and the preview do not walk the document every frame: they draw from a flat list of the rows
+// that are currently reachable (children of collapsed nodes are left out), rebuilt only when the tree changes shape
+// or a node opens/closes, and only the rows inside the visible part of the window are submitted to ImGui.
+// Tree rows all have the same height (ImGuiListClipper). Preview rows do not: their heights are measured as they are
+// drawn and kept in a RowHeights index, which finds the row at a scroll offset in O(log n).
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <vector>
+
+struct ElementRow {
+    ElementIndex element;
+    int depth;                  // Nesting level in the panel
+};
+
+// Builder element tree: every element, the children of ElementFlags_Expanded ones after them.
+void BuildTreeRows(const ElementStore& store, std::vector<ElementRow>& rows);
+
+enum TreeRowMark_ {
+    TreeRowMark_Match       = 1 << 0,
+    TreeRowMark_Ancestor    = 1 << 1,   // Has a match below it
+};
+
+// Builder element tree filtered by a search: the elements of 'matches' and their ancestors, the ancestors shown
+// as if expanded. 'marks' receives TreeRowMark_ flags, one byte per slot.
+void BuildFilteredTreeRows(const ElementStore& store, const std::vector<ElementIndex>& matches, std::vector<unsigned char>& marks, std::vector<ElementRow>& rows);
+
+// A line of the preview: items [first, first + count). SAME_LINE elements join the item before and after them into
+// a single line. 'indent' counts IndentSpacing steps at the start of the line (tree depth plus INDENT/UNINDENT).
+struct PreviewRow {
+    int first;
+    int count;
+    int indent;
+};
+
+// Preview: visible elements, the children of open TREE_NODE / COLLAPSING_HEADER elements (ElementFlags_Open) after them.
+void BuildPreviewRows(const ElementStore& store, std::vector<ElementRow>& items, std::vector<PreviewRow>& rows);
+
+// Heights of a list of rows, as a Fenwick tree of prefix sums: setting one height and looking up offsets are O(log n).
+class RowHeights {
+public:
+    // 'count' rows of height 'height' (an estimate, until rows are measured)
+    void Reset(int count, float height);
+    int Size() const { return (int)heights.size(); }
+    float Get(int row) const { return (float)heights[row]; }
+    void Set(int row, float height);
+    // Sum of the heights of the rows before 'row' (row == Size(): the total)
+    float Offset(int row) const;
+    float Total() const { return Offset(Size()); }
+    // Row covering 'offset' from the top, Size() past the last row
+    int FindRow(float offset) const;
+
+private:
+    std::vector<double> tree;   // 1-based: tree[i] sums the heights of rows (i - (i & -i), i]
+    std::vector<double> heights;
+};
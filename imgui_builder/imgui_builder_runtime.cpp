@@ -0,0 +1,662 @@
+// ULTIMATE ImGui Builder: layout runtime
+// See imgui_builder_runtime.h
+
+#include "imgui_builder_runtime.h"
+#include "imgui_builder_fold.h"
+#include "imgui_builder_project.h"
+#include "imgui_builder_types.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+static_assert(sizeof(bool) == 1, "bool values are stored as bytes while compiling");
+
+//-----------------------------------------------------------------------------
+// Compiler
+//-----------------------------------------------------------------------------
+
+LayoutOp& LayoutProgram::AddOp(LayoutOpCode code, ImU32 label) {
+    ops.emplace_back();
+    LayoutOp& op = ops.back();
+    memset(&op, 0, sizeof(op));
+    op.code = (ImU32)code;
+    op.label = label;
+    return op;
+}
+
+ImU32 LayoutProgram::AddString(const char* str) {
+    const ImU32 offset = (ImU32)strings.size();
+    strings.insert(strings.end(), str, str + strlen(str) + 1);
+    return offset;
+}
+
+// "Volume##12", as generated code writes it
+ImU32 LayoutProgram::AddLabel(const ElementStore& store, ElementIndex element) {
+    char id[24];
+    snprintf(id, sizeof(id), "##%llu", (unsigned long long)store.uids[element]);
+    const ImU32 offset = (ImU32)strings.size();
+    const char* label = store.strings[element].label;
+    strings.insert(strings.end(), label, label + strlen(label));
+    strings.insert(strings.end(), id, id + strlen(id) + 1);
+    return offset;
+}
+
+ImU32 LayoutProgram::AddBool(bool value) {
+    bool_values.push_back(value ? 1 : 0);
+    return (ImU32)bool_values.size() - 1;
+}
+
+ImU32 LayoutProgram::AddInt(int value) {
+    ints.push_back(value);
+    return (ImU32)ints.size() - 1;
+}
+
+ImU32 LayoutProgram::AddFloats(const float* values, int count) {
+    const ImU32 slot = (ImU32)floats.size();
+    if (values) {
+        floats.insert(floats.end(), values, values + count);
+    } else {
+        floats.resize(floats.size() + count, 0.0f);
+    }
+    return slot;
+}
+
+void LayoutProgram::CompileChildren(const ElementStore& store, ElementIndex element) {
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        CompileElement(store, child);
+    }
+}
+
+// Block op, the children, then the end op if any (LayoutOpCode_COUNT: none). The block continues after its last op
+// when it is not open.
+void LayoutProgram::CompileBlock(const ElementStore& store, ElementIndex element, LayoutOpCode begin, ImU32 label, LayoutOpCode end) {
+    const size_t first_op = ops.size();
+    AddOp(begin, label);
+    CompileChildren(store, element);
+    if (end != LayoutOpCode_COUNT) {
+        AddOp(end);
+    }
+    ops[first_op].jump = (ImU32)ops.size();
+}
+
+// Combo, ListBox
+void LayoutProgram::CompileItems(const ElementStore& store, ElementIndex element, LayoutOpCode code) {
+    LayoutOp& op = AddOp(code, AddLabel(store, element));
+    op.slot = AddInt(store.GetItemList(element).selected_item);
+    op.items = (ImU32)item_offsets.size();
+    op.count = store.GetItemCount(element);
+    const char* const* element_items = store.GetItems(element);
+    for (int n = 0; n < store.GetItemCount(element); n++) {
+        item_offsets.push_back(AddString(element_items[n]));
+    }
+}
+
+// PlotLines, PlotHistogram
+void LayoutProgram::CompilePlot(const ElementStore& store, ElementIndex element, LayoutOpCode code) {
+    const ElementRange& range = store.GetRange(element);
+    const ImVec2& size = store.styles[element].size;
+    LayoutOp& op = AddOp(code, AddLabel(store, element));
+    op.slot = AddFloats(nullptr, LAYOUT_PLOT_VALUES);
+    op.args[0] = range.min_value;
+    op.args[1] = range.max_value;
+    op.args[2] = size.x;
+    op.args[3] = size.y;
+}
+
+// One column per child unless a count was set
+int LayoutProgram::GetColumnCount(const ElementStore& store, ElementIndex element, int max_columns) {
+    int child_count = 0;
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        child_count++;
+    }
+    int columns = store.GetInt(element) > 0 ? store.GetInt(element) : child_count;
+    return columns < 1 ? 1 : columns > max_columns ? max_columns : columns;
+}
+
+// Same structure as CodeGenerator::Element(), one op per ImGui call (or per if)
+void LayoutProgram::CompileElement(const ElementStore& store, ElementIndex element) {
+    const ElementCalls calls = GetElementCalls(store, element);
+    if (!(calls & ElementCalls_Draw)) {
+        return;
+    }
+    const ElementType type = store.types[element];
+    const ElementStyle& style = store.styles[element];
+
+    if (calls & ElementCalls_BeginDisabled) {
+        AddOp(LayoutOpCode_BeginDisabled);
+    }
+    if ((calls & ElementCalls_PushColors) && (calls & ElementCalls_TextColor)) {
+        LayoutOp& op = AddOp(LayoutOpCode_PushColor);
+        op.count = ImGuiCol_Text;
+        memcpy(op.args, &style.text_color, sizeof(ImVec4));
+    }
+    if ((calls & ElementCalls_PushColors) && (calls & ElementCalls_BgColor)) {
+        LayoutOp& op = AddOp(LayoutOpCode_PushColor);
+        op.count = GetElementTypeInfo(type).background;
+        memcpy(op.args, &style.bg_color, sizeof(ImVec4));
+    }
+    if (calls & ElementCalls_PushItemWidth) {
+        AddOp(LayoutOpCode_PushItemWidth).args[0] = style.size.x;
+    }
+
+    // Containers compile their children themselves, the children of other elements simply follow them
+    const size_t first_op = ops.size();
+    GetElementTypeInfo(type).compile(*this, store, element);
+    if (!HasTypeFlags(type, ElementTypeFlags_Container)) {
+        CompileChildren(store, element);
+    }
+    if (first_op < ops.size() && instance_depth == 0) {
+        bindings.push_back({ store.uids[element], (ImU32)first_op });
+    }
+
+    if (calls & ElementCalls_PopItemWidth) {
+        AddOp(LayoutOpCode_PopItemWidth);
+    }
+    if (calls & ElementCalls_PopColors) {
+        AddOp(LayoutOpCode_PopColor).count = GetColorCount(calls);
+    }
+    if (calls & ElementCalls_EndDisabled) {
+        AddOp(LayoutOpCode_EndDisabled);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Per-type ops, the compile hooks of the element type table
+//-----------------------------------------------------------------------------
+
+void ElementTraits<ElementType::BUTTON>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const ImVec2& size = store.styles[element].size;
+    LayoutOp& op = program.AddOp(LayoutOpCode_Button, program.AddLabel(store, element));
+    op.slot = program.AddBool(false);
+    op.args[0] = size.x;
+    op.args[1] = size.y;
+}
+
+void ElementTraits<ElementType::IMAGE_BUTTON>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const ImVec2& style_size = store.styles[element].size;
+    const ImVec2 size = (style_size.x > 0 && style_size.y > 0) ? style_size : ImVec2(32.0f, 32.0f);
+    LayoutOp& op = program.AddOp(LayoutOpCode_ImageButton, program.AddLabel(store, element));
+    op.slot = program.AddBool(false);
+    op.args[0] = size.x;
+    op.args[1] = size.y;
+}
+
+void ElementTraits<ElementType::CHECKBOX>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_Checkbox, program.AddLabel(store, element)).slot =
+        program.AddBool((store.flags[element] & ElementFlags_BoolValue) != 0);
+}
+
+void ElementTraits<ElementType::SELECTABLE>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_Selectable, program.AddLabel(store, element)).slot =
+        program.AddBool((store.flags[element] & ElementFlags_BoolValue) != 0);
+}
+
+void ElementTraits<ElementType::SLIDER_FLOAT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const float value = store.GetFloat(element);
+    const ElementRange& range = store.GetRange(element);
+    LayoutOp& op = program.AddOp(LayoutOpCode_SliderFloat, program.AddLabel(store, element));
+    op.slot = program.AddFloats(&value, 1);
+    op.args[0] = range.min_value;
+    op.args[1] = range.max_value;
+}
+
+void ElementTraits<ElementType::SLIDER_INT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const ElementRange& range = store.GetRange(element);
+    LayoutOp& op = program.AddOp(LayoutOpCode_SliderInt, program.AddLabel(store, element));
+    op.slot = program.AddInt(store.GetInt(element));
+    op.args[0] = (float)(int)range.min_value;
+    op.args[1] = (float)(int)range.max_value;
+}
+
+void ElementTraits<ElementType::INPUT_TEXT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    // Fixed capacity, like the array generated code declares
+    const char* text = store.strings[element].text_value;
+    const size_t length = strlen(text);
+    size_t capacity = 256;
+    while (capacity <= length) {
+        capacity *= 2;
+    }
+    LayoutOp& op = program.AddOp(LayoutOpCode_InputText, program.AddLabel(store, element));
+    op.slot = (ImU32)program.text.size();
+    op.count = (ImS32)capacity;
+    program.text.insert(program.text.end(), text, text + length);
+    program.text.resize(program.text.size() + capacity - length, 0);
+}
+
+void ElementTraits<ElementType::INPUT_INT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_InputInt, program.AddLabel(store, element)).slot = program.AddInt(store.GetInt(element));
+}
+
+void ElementTraits<ElementType::RADIO_BUTTON>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_RadioButton, program.AddLabel(store, element)).slot = program.AddInt(store.GetInt(element));
+}
+
+void ElementTraits<ElementType::INPUT_FLOAT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const float value = store.GetFloat(element);
+    program.AddOp(LayoutOpCode_InputFloat, program.AddLabel(store, element)).slot = program.AddFloats(&value, 1);
+}
+
+void ElementTraits<ElementType::COMBO>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileItems(store, element, LayoutOpCode_Combo);
+}
+
+void ElementTraits<ElementType::LISTBOX>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileItems(store, element, LayoutOpCode_ListBox);
+}
+
+void ElementTraits<ElementType::COLOR_PICKER>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_ColorEdit, program.AddLabel(store, element)).slot =
+        program.AddFloats((const float*)&store.GetColor(element), 4);
+}
+
+void ElementTraits<ElementType::SEPARATOR>::Compile(LayoutProgram& program, const ElementStore&, ElementIndex) {
+    program.AddOp(LayoutOpCode_Separator);
+}
+
+void ElementTraits<ElementType::TEXT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_Text, program.AddString(store.strings[element].text_value));
+}
+
+void ElementTraits<ElementType::BULLET_TEXT>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_BulletText, program.AddString(store.strings[element].text_value));
+}
+
+void ElementTraits<ElementType::PROGRESS_BAR>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const float value = store.GetFloat(element);
+    const ImVec2& size = store.styles[element].size;
+    LayoutOp& op = program.AddOp(LayoutOpCode_ProgressBar, program.AddString(store.strings[element].label));
+    op.slot = program.AddFloats(&value, 1);
+    op.args[0] = size.x;
+    op.args[1] = size.y;
+}
+
+void ElementTraits<ElementType::SPACING>::Compile(LayoutProgram& program, const ElementStore&, ElementIndex) {
+    program.AddOp(LayoutOpCode_Spacing);
+}
+
+void ElementTraits<ElementType::SAME_LINE>::Compile(LayoutProgram& program, const ElementStore&, ElementIndex) {
+    program.AddOp(LayoutOpCode_SameLine);
+}
+
+void ElementTraits<ElementType::NEW_LINE>::Compile(LayoutProgram& program, const ElementStore&, ElementIndex) {
+    program.AddOp(LayoutOpCode_NewLine);
+}
+
+void ElementTraits<ElementType::INDENT>::Compile(LayoutProgram& program, const ElementStore&, ElementIndex) {
+    program.AddOp(LayoutOpCode_Indent);
+}
+
+void ElementTraits<ElementType::UNINDENT>::Compile(LayoutProgram& program, const ElementStore&, ElementIndex) {
+    program.AddOp(LayoutOpCode_Unindent);
+}
+
+void ElementTraits<ElementType::PLOT_LINES>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompilePlot(store, element, LayoutOpCode_PlotLines);
+}
+
+void ElementTraits<ElementType::PLOT_HISTOGRAM>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompilePlot(store, element, LayoutOpCode_PlotHistogram);
+}
+
+void ElementTraits<ElementType::TREE_NODE>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileBlock(store, element, LayoutOpCode_TreeNode, program.AddLabel(store, element), LayoutOpCode_TreePop);
+}
+
+void ElementTraits<ElementType::COLLAPSING_HEADER>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileBlock(store, element, LayoutOpCode_CollapsingHeader, program.AddLabel(store, element), LayoutOpCode_COUNT);
+}
+
+void ElementTraits<ElementType::TAB_BAR>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileBlock(store, element, LayoutOpCode_BeginTabBar, program.AddLabel(store, element), LayoutOpCode_EndTabBar);
+}
+
+void ElementTraits<ElementType::TAB_ITEM>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileBlock(store, element, LayoutOpCode_BeginTabItem, program.AddLabel(store, element), LayoutOpCode_EndTabItem);
+}
+
+void ElementTraits<ElementType::MENU_BAR>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileBlock(store, element, LayoutOpCode_BeginMenuBar, 0, LayoutOpCode_EndMenuBar);
+}
+
+void ElementTraits<ElementType::MENU_ITEM>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    // A menu item with children is a sub-menu
+    if (store.FirstChild(element) != ElementIndex_None) {
+        program.CompileBlock(store, element, LayoutOpCode_BeginMenu, program.AddLabel(store, element), LayoutOpCode_EndMenu);
+    } else {
+        program.AddOp(LayoutOpCode_MenuItem, program.AddLabel(store, element)).slot = program.AddBool(false);
+    }
+}
+
+void ElementTraits<ElementType::POPUP>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.CompileBlock(store, element, LayoutOpCode_BeginPopup, program.AddLabel(store, element), LayoutOpCode_EndPopup);
+}
+
+void ElementTraits<ElementType::TOOLTIP>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const size_t begin = program.ops.size();
+    const char* text = store.strings[element].text_value;
+    program.AddOp(LayoutOpCode_BeginTooltip);
+    if (text[0]) {
+        program.AddOp(LayoutOpCode_Text, program.AddString(text));
+    }
+    program.CompileChildren(store, element);
+    program.AddOp(LayoutOpCode_EndTooltip);
+    program.ops[begin].jump = (ImU32)program.ops.size();
+}
+
+void ElementTraits<ElementType::GROUP>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    // Not a block: the group always ends
+    program.AddOp(LayoutOpCode_BeginGroup);
+    program.CompileChildren(store, element);
+    program.AddOp(LayoutOpCode_EndGroup);
+}
+
+void ElementTraits<ElementType::CHILD_WINDOW>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const size_t begin = program.ops.size();
+    const ImVec2& size = store.styles[element].size;
+    LayoutOp& op = program.AddOp(LayoutOpCode_BeginChild, program.AddLabel(store, element));
+    op.args[0] = size.x;
+    op.args[1] = size.y;
+    program.CompileChildren(store, element);
+    // Closed or not, the child window ends: the jump lands on EndChild
+    program.ops[begin].jump = (ImU32)program.ops.size();
+    program.AddOp(LayoutOpCode_EndChild);
+}
+
+void ElementTraits<ElementType::COLUMNS>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    program.AddOp(LayoutOpCode_Columns, program.AddLabel(store, element)).count = program.GetColumnCount(store, element, 64);
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        program.CompileElement(store, child);
+        program.AddOp(LayoutOpCode_NextColumn);
+    }
+    program.AddOp(LayoutOpCode_EndColumns);
+}
+
+void ElementTraits<ElementType::TABLE>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const size_t begin = program.ops.size();
+    program.AddOp(LayoutOpCode_BeginTable, program.AddLabel(store, element)).count = program.GetColumnCount(store, element, 512);
+    for (ElementIndex child = store.FirstChild(element); child != ElementIndex_None; child = store.NextSibling(child)) {
+        program.AddOp(LayoutOpCode_TableNextColumn);
+        program.CompileElement(store, child);
+    }
+    program.AddOp(LayoutOpCode_EndTable);
+    program.ops[begin].jump = (ImU32)program.ops.size();
+}
+
+void ElementTraits<ElementType::INSTANCE>::Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element) {
+    const ElementIndex component = program.components.Find(store.strings[element].text_value);
+    if (component != ElementIndex_None) {
+        program.AddOp(LayoutOpCode_PushID).count = (ImS32)store.uids[element];
+        program.instance_depth++;
+        program.CompileChildren(store, component);
+        program.instance_depth--;
+        program.AddOp(LayoutOpCode_PopID);
+    }
+}
+
+void LayoutProgram::Compile(const ElementStore& store, const char* title) {
+    ops.clear();
+    strings.clear();
+    item_offsets.clear();
+    items.clear();
+    bindings.clear();
+    bool_values.clear();
+    ints.clear();
+    floats.clear();
+    text.clear();
+
+    components.Build(store);
+    window_name = AddString(title);
+    // A menu bar at the top level needs the window flag
+    menu_bar = false;
+    for (ElementIndex root = store.FirstChild(ElementIndex_None); root != ElementIndex_None; root = store.NextSibling(root)) {
+        menu_bar |= store.types[root] == ElementType::MENU_BAR && (store.flags[root] & ElementFlags_Visible);
+    }
+    CompileChildren(store, ElementIndex_None);
+
+    // The pool is complete: item pointers can be resolved
+    items.reserve(item_offsets.size());
+    for (ImU32 offset : item_offsets) {
+        items.push_back(strings.data() + offset);
+    }
+    bools.reset(new bool[bool_values.size() + 1]);
+    for (size_t n = 0; n < bool_values.size(); n++) {
+        bools[n] = bool_values[n] != 0;
+    }
+    std::sort(bindings.begin(), bindings.end(), [](const Binding& a, const Binding& b) { return a.uid < b.uid; });
+}
+
+bool LayoutProgram::Load(const char* path, std::string* error) {
+    // The name lives in the store's strings: compiled before the store goes away
+    ElementStore store;
+    const char* name = nullptr;
+    const bool ok = LoadProjectFile(store, path, &name, error);
+    if (ok) {
+        Compile(store, name);
+    }
+    return ok;
+}
+
+//-----------------------------------------------------------------------------
+// Interpreter
+//-----------------------------------------------------------------------------
+
+void LayoutProgram::Render(bool* p_open) {
+    if (ImGui::Begin(strings.data() + window_name, p_open, menu_bar ? ImGuiWindowFlags_MenuBar : 0)) {
+        Run();
+    }
+    ImGui::End();
+}
+
+void LayoutProgram::Run() {
+    const LayoutOp* const first = ops.data();
+    const LayoutOp* const end = first + ops.size();
+    const char* const pool = strings.data();
+    bool* const bool_slots = bools.get();
+    int* const int_slots = ints.data();
+    float* const float_slots = floats.data();
+    char* const text_slots = text.data();
+
+    for (const LayoutOp* op = first; op < end; op++) {
+        const char* label = pool + op->label;
+        switch (op->code) {
+        case LayoutOpCode_BeginDisabled:    ImGui::BeginDisabled(); break;
+        case LayoutOpCode_EndDisabled:      ImGui::EndDisabled(); break;
+        case LayoutOpCode_PushColor:        ImGui::PushStyleColor(op->count, ImVec4(op->args[0], op->args[1], op->args[2], op->args[3])); break;
+        case LayoutOpCode_PopColor:         ImGui::PopStyleColor(op->count); break;
+        case LayoutOpCode_PushItemWidth:    ImGui::PushItemWidth(op->args[0]); break;
+        case LayoutOpCode_PopItemWidth:     ImGui::PopItemWidth(); break;
+        case LayoutOpCode_PushID:           ImGui::PushID(op->count); break;
+        case LayoutOpCode_PopID:            ImGui::PopID(); break;
+
+        case LayoutOpCode_Button:
+            bool_slots[op->slot] = ImGui::Button(label, ImVec2(op->args[0], op->args[1]));
+            break;
+        case LayoutOpCode_Checkbox:
+            ImGui::Checkbox(label, &bool_slots[op->slot]);
+            break;
+        case LayoutOpCode_SliderFloat:
+            ImGui::SliderFloat(label, &float_slots[op->slot], op->args[0], op->args[1]);
+            break;
+        case LayoutOpCode_SliderInt:
+            ImGui::SliderInt(label, &int_slots[op->slot], (int)op->args[0], (int)op->args[1]);
+            break;
+        case LayoutOpCode_InputText:
+            ImGui::InputText(label, text_slots + op->slot, (size_t)op->count);
+            break;
+        case LayoutOpCode_InputInt:
+            ImGui::InputInt(label, &int_slots[op->slot]);
+            break;
+        case LayoutOpCode_InputFloat:
+            ImGui::InputFloat(label, &float_slots[op->slot]);
+            break;
+        case LayoutOpCode_Combo:
+            ImGui::Combo(label, &int_slots[op->slot], op->count > 0 ? &items[op->items] : nullptr, op->count);
+            break;
+        case LayoutOpCode_ListBox:
+            ImGui::ListBox(label, &int_slots[op->slot], op->count > 0 ? &items[op->items] : nullptr, op->count);
+            break;
+        case LayoutOpCode_ColorEdit:
+            ImGui::ColorEdit4(label, &float_slots[op->slot]);
+            break;
+        case LayoutOpCode_Separator:        ImGui::Separator(); break;
+        case LayoutOpCode_Text:             ImGui::TextUnformatted(label); break;
+        case LayoutOpCode_BulletText:       ImGui::BulletText("%s", label); break;
+        case LayoutOpCode_ProgressBar:
+            ImGui::ProgressBar(float_slots[op->slot], ImVec2(op->args[0], op->args[1]), label);
+            break;
+        case LayoutOpCode_ImageButton:
+            bool_slots[op->slot] = ImGui::ImageButton(label, (ImTextureID)0, ImVec2(op->args[0], op->args[1]));
+            break;
+        case LayoutOpCode_RadioButton:
+            ImGui::RadioButton(label, &int_slots[op->slot], 1);
+            break;
+        case LayoutOpCode_Selectable:
+            ImGui::Selectable(label, &bool_slots[op->slot]);
+            break;
+        case LayoutOpCode_MenuItem:
+            bool_slots[op->slot] = ImGui::MenuItem(label);
+            break;
+        case LayoutOpCode_Spacing:          ImGui::Spacing(); break;
+        case LayoutOpCode_SameLine:         ImGui::SameLine(); break;
+        case LayoutOpCode_NewLine:          ImGui::NewLine(); break;
+        case LayoutOpCode_Indent:           ImGui::Indent(); break;
+        case LayoutOpCode_Unindent:         ImGui::Unindent(); break;
+        case LayoutOpCode_PlotLines:
+            ImGui::PlotLines(label, &float_slots[op->slot], LAYOUT_PLOT_VALUES, 0, nullptr, op->args[0], op->args[1], ImVec2(op->args[2], op->args[3]));
+            break;
+        case LayoutOpCode_PlotHistogram:
+            ImGui::PlotHistogram(label, &float_slots[op->slot], LAYOUT_PLOT_VALUES, 0, nullptr, op->args[0], op->args[1], ImVec2(op->args[2], op->args[3]));
+            break;
+
+        // Blocks: skip to the jump (the loop increment lands on it) when not open
+        case LayoutOpCode_TreeNode:
+            if (!ImGui::TreeNode(label)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_TreePop:          ImGui::TreePop(); break;
+        case LayoutOpCode_CollapsingHeader:
+            if (!ImGui::CollapsingHeader(label)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_BeginTabBar:
+            if (!ImGui::BeginTabBar(label)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndTabBar:        ImGui::EndTabBar(); break;
+        case LayoutOpCode_BeginTabItem:
+            if (!ImGui::BeginTabItem(label)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndTabItem:       ImGui::EndTabItem(); break;
+        case LayoutOpCode_BeginMenuBar:
+            if (!ImGui::BeginMenuBar()) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndMenuBar:       ImGui::EndMenuBar(); break;
+        case LayoutOpCode_BeginMenu:
+            if (!ImGui::BeginMenu(label)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndMenu:          ImGui::EndMenu(); break;
+        case LayoutOpCode_BeginPopup:
+            if (ImGui::Button(label)) ImGui::OpenPopup(label);
+            if (!ImGui::BeginPopup(label)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndPopup:         ImGui::EndPopup(); break;
+        case LayoutOpCode_BeginTooltip:
+            if (!ImGui::BeginItemTooltip()) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndTooltip:       ImGui::EndTooltip(); break;
+        case LayoutOpCode_BeginChild:
+            if (!ImGui::BeginChild(label, ImVec2(op->args[0], op->args[1]), true)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_EndChild:         ImGui::EndChild(); break;
+        case LayoutOpCode_BeginTable:
+            if (!ImGui::BeginTable(label, op->count)) op = first + op->jump - 1;
+            break;
+        case LayoutOpCode_TableNextColumn:  ImGui::TableNextColumn(); break;
+        case LayoutOpCode_EndTable:         ImGui::EndTable(); break;
+        case LayoutOpCode_BeginGroup:       ImGui::BeginGroup(); break;
+        case LayoutOpCode_EndGroup:         ImGui::EndGroup(); break;
+        case LayoutOpCode_Columns:          ImGui::Columns(op->count, label); break;
+        case LayoutOpCode_NextColumn:       ImGui::NextColumn(); break;
+        case LayoutOpCode_EndColumns:       ImGui::Columns(1); break;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Values
+//-----------------------------------------------------------------------------
+
+// Op drawing the element (skipping the scopes pushed around it)
+const LayoutOp* LayoutProgram::FindOp(ElementUid uid) const {
+    auto it = std::lower_bound(bindings.begin(), bindings.end(), uid, [](const Binding& binding, ElementUid value) { return binding.uid < value; });
+    if (it == bindings.end() || it->uid != uid) {
+        return nullptr;
+    }
+    return &ops[it->op];
+}
+
+bool* LayoutProgram::GetBool(ElementUid uid) {
+    const LayoutOp* op = FindOp(uid);
+    if (!op) {
+        return nullptr;
+    }
+    switch (op->code) {
+    case LayoutOpCode_Button:
+    case LayoutOpCode_Checkbox:
+    case LayoutOpCode_ImageButton:
+    case LayoutOpCode_Selectable:
+    case LayoutOpCode_MenuItem:
+        return &bools[op->slot];
+    default:
+        return nullptr;
+    }
+}
+
+int* LayoutProgram::GetInt(ElementUid uid) {
+    const LayoutOp* op = FindOp(uid);
+    if (!op) {
+        return nullptr;
+    }
+    switch (op->code) {
+    case LayoutOpCode_SliderInt:
+    case LayoutOpCode_InputInt:
+    case LayoutOpCode_Combo:
+    case LayoutOpCode_ListBox:
+    case LayoutOpCode_RadioButton:
+        return &ints[op->slot];
+    default:
+        return nullptr;
+    }
+}
+
+float* LayoutProgram::GetFloat(ElementUid uid) {
+    const LayoutOp* op = FindOp(uid);
+    if (!op) {
+        return nullptr;
+    }
+    switch (op->code) {
+    case LayoutOpCode_SliderFloat:
+    case LayoutOpCode_InputFloat:
+    case LayoutOpCode_ColorEdit:
+    case LayoutOpCode_ProgressBar:
+    case LayoutOpCode_PlotLines:
+    case LayoutOpCode_PlotHistogram:
+        return &floats[op->slot];
+    default:
+        return nullptr;
+    }
+}
+
+char* LayoutProgram::GetText(ElementUid uid, int* out_capacity) {
+    const LayoutOp* op = FindOp(uid);
+    if (!op || op->code != LayoutOpCode_InputText) {
+        return nullptr;
+    }
+    if (out_capacity) {
+        *out_capacity = op->count;
+    }
+    return &text[op->slot];
+}
+
+size_t LayoutProgram::GetMemorySize() const {
+    return ops.capacity() * sizeof(LayoutOp) + strings.capacity() + items.capacity() * sizeof(const char*) +
+        bindings.capacity() * sizeof(Binding) + bool_values.size() + ints.capacity() * sizeof(int) +
+        floats.capacity() * sizeof(float) + text.capacity();
+}
@@ -0,0 +1,177 @@
+// ULTIMATE ImGui Builder: layout runtime
+// Draws a saved layout in a shipped application without generating code: LayoutProgram compiles a document into a
+// flat array of widget ops and runs it every frame, making the same Dear ImGui calls in the same order as the code
+// GenerateDocumentCode() writes for it (see imgui_builder_codegen.h).
+//
+//     LayoutProgram layout;
+//     if (!layout.Load("settings.imgb", &error)) ...
+//     ...every frame:
+//     layout.Render(&show_settings);
+//     if (*layout.GetBool(apply_uid)) ...         // "Apply" button pressed
+//     volume = *layout.GetFloat(volume_uid);
+//
+// Everything is resolved by Compile(): hidden elements are left out, labels are pre-formatted ("Volume##12", the
+// ImGui ID part is the element uid like in generated code) into one string pool, constants (ranges, sizes, colors)
+// are stored in the ops, and the values generated code keeps in function-local statics live in per-kind value arrays
+// the ops index directly. Running the program is a single loop over the ops with a switch: no tree walk, no lookup
+// by name, no allocation. Ops opening a block (TreeNode, BeginChild...) hold the index of the op to continue from
+// when the block is closed, so the children of closed blocks cost nothing, as with generated code.
+// Instances of components (see imgui_builder_components.h) are compiled inline, their content between PushID and
+// PopID ops, each with its own values. Those values are not found by uid: the uid is shared by every instance.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_components.h"
+#include "imgui_builder_store.h"
+#include "imgui_builder_types.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Operands used by each op: label (L), value slot (S, in the array given), jump (J), count (C), args (A).
+enum LayoutOpCode_ {
+    // Scopes around an element, or a run of siblings (see imgui_builder_fold.h)
+    LayoutOpCode_BeginDisabled,
+    LayoutOpCode_EndDisabled,
+    LayoutOpCode_PushColor,         // C: ImGuiCol, A: color
+    LayoutOpCode_PopColor,          // C: count
+    LayoutOpCode_PushItemWidth,     // A: width
+    LayoutOpCode_PopItemWidth,
+    LayoutOpCode_PushID,            // C: id (an instance's uid)
+    LayoutOpCode_PopID,
+    // Widgets
+    LayoutOpCode_Button,            // L, S: bools (pressed), A: size
+    LayoutOpCode_Checkbox,          // L, S: bools
+    LayoutOpCode_SliderFloat,       // L, S: floats, A: min, max
+    LayoutOpCode_SliderInt,         // L, S: ints, A: min, max
+    LayoutOpCode_InputText,         // L, S: text, C: capacity
+    LayoutOpCode_InputInt,          // L, S: ints
+    LayoutOpCode_InputFloat,        // L, S: floats
+    LayoutOpCode_Combo,             // L, S: ints (selected item), items, C: item count
+    LayoutOpCode_ListBox,           // L, S: ints (selected item), items, C: item count
+    LayoutOpCode_ColorEdit,         // L, S: floats (4)
+    LayoutOpCode_Separator,
+    LayoutOpCode_Text,              // L: text
+    LayoutOpCode_BulletText,        // L: text
+    LayoutOpCode_ProgressBar,       // L: overlay, S: floats (fraction), A: size
+    LayoutOpCode_ImageButton,       // L, S: bools (pressed), A: size
+    LayoutOpCode_RadioButton,       // L, S: ints
+    LayoutOpCode_Selectable,        // L, S: bools
+    LayoutOpCode_MenuItem,          // L, S: bools (pressed)
+    LayoutOpCode_Spacing,
+    LayoutOpCode_SameLine,
+    LayoutOpCode_NewLine,
+    LayoutOpCode_Indent,
+    LayoutOpCode_Unindent,
+    LayoutOpCode_PlotLines,         // L, S: floats (LAYOUT_PLOT_VALUES), A: min, max, size
+    LayoutOpCode_PlotHistogram,     // L, S: floats (LAYOUT_PLOT_VALUES), A: min, max, size
+    // Blocks: J is the op to continue from when the block is not open
+    LayoutOpCode_TreeNode,          // L, J
+    LayoutOpCode_TreePop,
+    LayoutOpCode_CollapsingHeader,  // L, J
+    LayoutOpCode_BeginTabBar,       // L, J
+    LayoutOpCode_EndTabBar,
+    LayoutOpCode_BeginTabItem,      // L, J
+    LayoutOpCode_EndTabItem,
+    LayoutOpCode_BeginMenuBar,      // J
+    LayoutOpCode_EndMenuBar,
+    LayoutOpCode_BeginMenu,         // L, J
+    LayoutOpCode_EndMenu,
+    LayoutOpCode_BeginPopup,        // L, J: a button opening the popup, then the popup
+    LayoutOpCode_EndPopup,
+    LayoutOpCode_BeginTooltip,      // J: tooltip of the previous item
+    LayoutOpCode_EndTooltip,
+    LayoutOpCode_BeginChild,        // L, J (EndChild, which is always called), A: size
+    LayoutOpCode_EndChild,
+    LayoutOpCode_BeginTable,        // L, J, C: columns
+    LayoutOpCode_TableNextColumn,
+    LayoutOpCode_EndTable,
+    LayoutOpCode_BeginGroup,
+    LayoutOpCode_EndGroup,
+    LayoutOpCode_Columns,           // L, C: columns
+    LayoutOpCode_NextColumn,
+    LayoutOpCode_EndColumns,
+    LayoutOpCode_COUNT
+};
+typedef int LayoutOpCode;
+
+// Values of a plot, like the array generated code declares for it
+#define LAYOUT_PLOT_VALUES  32
+
+struct LayoutOp {
+    ImU32 code;                 // LayoutOpCode_
+    ImU32 label;                // Offset in the string pool
+    ImU32 slot;                 // Index of the first value in the array of the op
+    union {
+        ImU32 jump;             // Blocks: index of an op
+        ImU32 items;            // Combo, ListBox: index of the first item
+    };
+    ImS32 count;
+    float args[4];
+};
+
+class LayoutProgram {
+public:
+    // Replace the program with one drawing 'store', in a window titled 'title' (see Render()).
+    // Values start from the ones of the document. Nothing of 'store' is referenced afterwards.
+    void Compile(const ElementStore& store, const char* title);
+    // Compile a project file (.imgb or .json, see LoadProjectFile()), titled with its menu name
+    bool Load(const char* path, std::string* error = nullptr);
+
+    // Draw the layout in its own window, like the function of generated code ('p_open' is optional)
+    void Render(bool* p_open = nullptr);
+    // Draw the layout into the current window
+    void Run();
+
+    // Value of an element, looked up by uid: nullptr if the element is hidden, missing, or has no value of that kind.
+    // Pointers stay valid until the next Compile().
+    bool* GetBool(ElementUid uid);      // CHECKBOX, SELECTABLE; BUTTON, IMAGE_BUTTON, MENU_ITEM: pressed this frame
+    int* GetInt(ElementUid uid);        // SLIDER_INT, INPUT_INT, RADIO_BUTTON; COMBO, LISTBOX: selected item
+    float* GetFloat(ElementUid uid);    // SLIDER_FLOAT, INPUT_FLOAT, PROGRESS_BAR; COLOR_PICKER: 4; PLOT_*: the values
+    char* GetText(ElementUid uid, int* out_capacity = nullptr);    // INPUT_TEXT
+
+    const char* GetWindowName() const { return strings.data() + window_name; }
+    const std::vector<LayoutOp>& GetOps() const { return ops; }
+    // Bytes used by the ops, strings and values
+    size_t GetMemorySize() const;
+
+private:
+    // The compile hooks make the ops (see imgui_builder_types.h)
+    template <ElementType Type> friend struct ElementTraits;
+
+    struct Binding {
+        ElementUid uid;
+        ImU32 op;
+    };
+
+    void CompileElement(const ElementStore& store, ElementIndex element);
+    void CompileChildren(const ElementStore& store, ElementIndex element);
+    void CompileBlock(const ElementStore& store, ElementIndex element, LayoutOpCode begin, ImU32 label, LayoutOpCode end);
+    void CompileItems(const ElementStore& store, ElementIndex element, LayoutOpCode code);
+    void CompilePlot(const ElementStore& store, ElementIndex element, LayoutOpCode code);
+    static int GetColumnCount(const ElementStore& store, ElementIndex element, int max_columns);
+    LayoutOp& AddOp(LayoutOpCode code, ImU32 label = 0);
+    ImU32 AddString(const char* str);
+    ImU32 AddLabel(const ElementStore& store, ElementIndex element);
+    ImU32 AddBool(bool value);
+    ImU32 AddInt(int value);
+    ImU32 AddFloats(const float* values, int count);
+    const LayoutOp* FindOp(ElementUid uid) const;
+
+    std::vector<LayoutOp> ops;
+    std::vector<char> strings;
+    std::vector<ImU32> item_offsets;        // Into 'strings', while compiling
+    ComponentTable components;              // While compiling
+    int instance_depth = 0;                 // Compiling the content of an instance
+    std::vector<const char*> items;
+    std::vector<Binding> bindings;          // Sorted by uid
+    // Values
+    std::vector<unsigned char> bool_values; // While compiling (std::vector<bool> has no bool*)
+    std::unique_ptr<bool[]> bools;
+    std::vector<int> ints;
+    std::vector<float> floats;
+    std::vector<char> text;
+    ImU32 window_name = 0;
+    bool menu_bar = false;
+};
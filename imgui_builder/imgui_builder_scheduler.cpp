@@ -0,0 +1,117 @@
+// ULTIMATE ImGui Builder: event-driven frame scheduling
+// See imgui_builder_scheduler.h
+
+#include "imgui_builder_scheduler.h"
+
+// A requested time counts as reached this close to it: platform timeouts are rounded to milliseconds
+static const double WAKE_TOLERANCE = 0.001;
+// Dear ImGui text cursor: shown 0.8s then hidden 0.4s
+static const double CURSOR_BLINK_INTERVAL = 0.4;
+
+FrameScheduler::FrameScheduler(double refresh_interval, int settle_frames)
+    : refresh_interval(refresh_interval), settle_frames(settle_frames) {
+}
+
+void FrameScheduler::Touch(double now) {
+    if (first_time < 0.0) {
+        first_time = now;
+    }
+    last_time = now;
+}
+
+void FrameScheduler::OnEvent(double now) {
+    Touch(now);
+    stats.events++;
+    last_event_time = now;
+    RequestFrames(settle_frames);
+}
+
+void FrameScheduler::RequestFrames(int count) {
+    pending_frames = count > pending_frames ? count : pending_frames;
+}
+
+void FrameScheduler::RequestFrameAt(double time) {
+    if (wake_time < 0.0 || time < wake_time) {
+        wake_time = time;
+    }
+}
+
+void FrameScheduler::NotifyRevision(ImU64 new_revision) {
+    if (has_revision && new_revision != revision) {
+        RequestFrames(settle_frames);
+    }
+    revision = new_revision;
+    has_revision = true;
+}
+
+double FrameScheduler::GetTimeout(double now) const {
+    if (!enabled || pending_frames > 0) {
+        return 0.0;
+    }
+    double timeout = -1.0;
+    if (wake_time >= 0.0) {
+        timeout = wake_time > now ? wake_time - now : 0.0;
+    }
+    if (poll_interval > 0.0 && (timeout < 0.0 || timeout > poll_interval)) {
+        timeout = poll_interval;
+    }
+    return timeout;
+}
+
+bool FrameScheduler::ShouldRender(double now) {
+    Touch(now);
+    const bool wake = wake_time >= 0.0 && now + WAKE_TOLERANCE >= wake_time;
+    if (enabled && pending_frames == 0 && !wake) {
+        stats.wakeups++;
+        return false;
+    }
+    if (pending_frames > 0) {
+        pending_frames--;
+    }
+    if (wake) {
+        wake_time = -1.0;
+    }
+    stats.frames_rendered++;
+    return true;
+}
+
+void FrameScheduler::EndFrame(double now, bool continuous, double wake_in) {
+    Touch(now);
+    if (continuous) {
+        RequestFrames(1);
+    }
+    if (wake_in >= 0.0) {
+        RequestFrameAt(now + wake_in);
+    }
+}
+
+void FrameScheduler::EndImGuiFrame(double now) {
+    const ImGuiIO& io = ImGui::GetIO();
+    const bool continuous = ImGui::IsAnyItemActive() && !io.WantTextInput;
+    double wake_in = -1.0;
+    if (io.WantTextInput) {
+        wake_in = CURSOR_BLINK_INTERVAL;
+    }
+    // The hover delay runs while the mouse stays still, i.e. without events: wake up once when it expires
+    if (ImGui::IsAnyItemHovered() && last_event_time >= 0.0) {
+        const double tooltip_in = last_event_time + ImGui::GetStyle().HoverDelayNormal + refresh_interval - now;
+        if (tooltip_in > 0.0 && (wake_in < 0.0 || tooltip_in < wake_in)) {
+            wake_in = tooltip_in;
+        }
+    }
+    EndFrame(now, continuous, wake_in);
+}
+
+FrameSchedulerStats FrameScheduler::GetStats(double now) const {
+    FrameSchedulerStats result = stats;
+    if (first_time >= 0.0) {
+        const int intervals = (int)(((now < 0.0 ? last_time : now) - first_time) / refresh_interval) + 1;
+        result.frames_skipped = intervals > stats.frames_rendered ? intervals - stats.frames_rendered : 0;
+    }
+    return result;
+}
+
+void FrameScheduler::ResetStats() {
+    stats = FrameSchedulerStats();
+    first_time = -1.0;
+}
@@ -0,0 +1,77 @@
+// ULTIMATE ImGui Builder: event-driven frame scheduling
+// Decides when the application renders instead of redrawing at the refresh rate forever. A frame is rendered when
+// - input arrived (and for a few frames after it, so hover states, popups and auto-sized windows settle),
+// - the last frame asked for more: a widget being dragged, an animation,
+// - a wake-up time requested by the last frame is reached (text cursor blink, tooltip delay),
+// - the document changed without any input (loaded, edited from another thread).
+// Otherwise the platform loop blocks until the next input or GetTimeout(), whichever comes first (at most the poll
+// interval, when one is set).
+// Time is passed in by the caller, in seconds from any origin, so the scheduler has no platform dependency and can
+// be driven by a synthetic clock and event stream.
+
+#pragma once
+
+#include "imgui.h"
+
+struct FrameSchedulerStats {
+    int events = 0;                 // OnEvent() calls
+    int frames_rendered = 0;
+    int frames_skipped = 0;         // Refresh intervals elapsed without a frame (what a redraw-always loop would have rendered)
+    int wakeups = 0;                // ShouldRender() calls that did not render
+};
+
+class FrameScheduler {
+public:
+    // 'refresh_interval': display refresh period, to count skipped frames.
+    // 'settle_frames': frames rendered after each event.
+    explicit FrameScheduler(double refresh_interval = 1.0 / 60.0, int settle_frames = 3);
+
+    // Disabled: every call to ShouldRender() renders (the redraw-always loop)
+    void SetEnabled(bool enabled) { this->enabled = enabled; }
+    bool IsEnabled() const { return enabled; }
+
+    // Input or a window message arrived
+    void OnEvent(double now);
+    // Render at least 'count' more frames
+    void RequestFrames(int count = 1);
+    // Render a frame no later than 'time'
+    void RequestFrameAt(double time);
+    // Render frames while the document changes: call with its revision before ShouldRender()
+    void NotifyRevision(ImU64 revision);
+    // While positive, GetTimeout() is at most 'interval': the loop wakes up that often, without rendering, for what it
+    // polls between frames (sockets of the live preview). Negative: wait for input and requested frames only.
+    void SetPollInterval(double interval) { poll_interval = interval; }
+
+    // Seconds the platform loop may block waiting for input: 0 to render right away, negative to wait for input alone
+    double GetTimeout(double now) const;
+    // Whether to render a frame now. Counts the frame as rendered when it returns true.
+    bool ShouldRender(double now);
+    // After a rendered frame. 'continuous': the frame wants the next one right away.
+    // 'wake_in': seconds until it wants another one (negative: none).
+    void EndFrame(double now, bool continuous, double wake_in = -1.0);
+
+    // EndFrame() from the Dear ImGui state of the frame that was just rendered: an active widget renders continuously,
+    // a text cursor blinks, and a tooltip shows up after the mouse rested over an item.
+    void EndImGuiFrame(double now);
+
+    // Skipped frames are counted up to 'now', by default the last time passed to the scheduler
+    FrameSchedulerStats GetStats(double now = -1.0) const;
+    void ResetStats();
+
+private:
+    void Touch(double now);
+
+    double refresh_interval;
+    int settle_frames;
+    bool enabled = true;
+    int pending_frames = 1;         // The first frame is always rendered
+    double wake_time = -1.0;        // Earliest requested frame, negative if none
+    double poll_interval = -1.0;
+    double last_event_time = -1.0;
+    ImU64 revision = 0;
+    bool has_revision = false;
+    // Stats
+    FrameSchedulerStats stats;
+    double first_time = -1.0;
+    double last_time = 0.0;
+};
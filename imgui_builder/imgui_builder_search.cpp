@@ -0,0 +1,178 @@
+// ULTIMATE ImGui Builder: element search
+// See imgui_builder_search.h
+
+#include "imgui_builder_search.h"
+#include <algorithm>
+#include <string.h>
+
+static const int MAX_QUERY_TRIGRAMS = 64;
+
+static inline unsigned char Lower(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+static void AddTrigrams(const char* str, std::vector<ImU32>& out) {
+    const unsigned char* p = (const unsigned char*)str;
+    if (!p[0] || !p[1]) {
+        return;
+    }
+    ImU32 key = ((ImU32)Lower(p[0]) << 8) | Lower(p[1]);
+    for (p += 2; *p; p++) {
+        key = ((key << 8) | Lower(*p)) & 0xFFFFFF;
+        out.push_back(key);
+    }
+}
+
+// 'needle' is lowercase
+static bool ContainsNoCase(const char* haystack, const char* needle, size_t needle_length) {
+    for (const char* start = haystack; *start; start++) {
+        size_t n = 0;
+        while (n < needle_length && start[n] && Lower((unsigned char)start[n]) == (unsigned char)needle[n]) {
+            n++;
+        }
+        if (n == needle_length) {
+            return true;
+        }
+    }
+    return needle_length == 0;
+}
+
+static bool ElementMatches(const ElementStore& store, ElementIndex index, const char* needle, size_t needle_length) {
+    const ElementStrings& strings = store.strings[index];
+    return ContainsNoCase(strings.label, needle, needle_length) || ContainsNoCase(strings.text_value, needle, needle_length) ||
+        ContainsNoCase(GetElementTypeName(store.types[index]), needle, needle_length);
+}
+
+void ElementSearchIndex::CollectTrigrams(const Entry& entry) {
+    scratch.clear();
+    AddTrigrams(entry.label, scratch);
+    AddTrigrams(entry.text_value, scratch);
+    AddTrigrams(GetElementTypeName(entry.type), scratch);
+    std::sort(scratch.begin(), scratch.end());
+    scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+}
+
+void ElementSearchIndex::Add(ElementIndex index, const Entry& entry) {
+    CollectTrigrams(entry);
+    for (ImU32 key : scratch) {
+        postings[key].push_back(index);
+    }
+    entries[index] = entry;
+}
+
+void ElementSearchIndex::Remove(ElementIndex index, const Entry& entry) {
+    CollectTrigrams(entry);
+    for (ImU32 key : scratch) {
+        std::vector<ElementIndex>& list = postings[key];
+        std::vector<ElementIndex>::iterator it = std::find(list.begin(), list.end(), index);
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    }
+    entries[index] = Entry();
+}
+
+void ElementSearchIndex::Sync(const ElementStore& store) {
+    const ImU32 generation = store.string_pool.GetGeneration();
+    if (store.GetRevision() == synced_revision && generation == synced_generation) {
+        return;
+    }
+    const int slot_count = (int)store.types.size();
+    if (entries.size() < store.types.size()) {
+        entries.resize(store.types.size());
+    }
+
+    // Strings indexed before a pool reset may be gone: start over. Same when most of the document changed,
+    // re-indexing one element at a time would search the long posting lists over and over.
+    int changed = 0;
+    if (generation == synced_generation) {
+        for (int index = 0; index < (int)entries.size(); index++) {
+            const Entry& entry = entries[index];
+            const bool alive = index < slot_count && (store.flags[index] & ElementFlags_Alive);
+            if (alive ? (entry.label != store.strings[index].label || entry.text_value != store.strings[index].text_value || entry.type != store.types[index])
+                      : entry.label != nullptr) {
+                changed++;
+            }
+        }
+    }
+    const bool rebuild = generation != synced_generation || changed > store.Size() / 8 + 64;
+
+    reindexed_count = 0;
+    if (rebuild) {
+        for (auto& posting : postings) {
+            posting.second.clear();
+        }
+        std::fill(entries.begin(), entries.end(), Entry());
+    }
+    for (int index = 0; index < (int)entries.size(); index++) {
+        const bool alive = index < slot_count && (store.flags[index] & ElementFlags_Alive);
+        Entry current;
+        if (alive) {
+            current.label = store.strings[index].label;
+            current.text_value = store.strings[index].text_value;
+            current.type = store.types[index];
+        }
+        const Entry& entry = entries[index];
+        if (entry.label == current.label && entry.text_value == current.text_value && entry.type == current.type) {
+            continue;
+        }
+        if (entry.label) {
+            Remove(index, entry);
+        }
+        if (alive) {
+            Add(index, current);
+        }
+        reindexed_count++;
+    }
+    synced_revision = store.GetRevision();
+    synced_generation = generation;
+}
+
+void ElementSearchIndex::Find(const ElementStore& store, const char* query, std::vector<ElementIndex>& out) const {
+    out.clear();
+    char needle[256];
+    size_t length = 0;
+    for (const char* p = query; *p && length < sizeof(needle) - 1; p++) {
+        needle[length++] = (char)Lower((unsigned char)*p);
+    }
+    needle[length] = 0;
+    if (length == 0) {
+        return;
+    }
+
+    if (length < 3) {
+        for (int index = 0; index < (int)store.types.size(); index++) {
+            if ((store.flags[index] & ElementFlags_Alive) && ElementMatches(store, index, needle, length)) {
+                out.push_back(index);
+            }
+        }
+        return;
+    }
+
+    // Every match contains every trigram of the query: the shortest posting list holds all candidates
+    const std::vector<ElementIndex>* candidates = nullptr;
+    ImU32 key = ((ImU32)(unsigned char)needle[0] << 8) | (unsigned char)needle[1];
+    for (size_t n = 2; n < length && n < MAX_QUERY_TRIGRAMS + 2; n++) {
+        key = ((key << 8) | (unsigned char)needle[n]) & 0xFFFFFF;
+        auto it = postings.find(key);
+        if (it == postings.end() || it->second.empty()) {
+            return;
+        }
+        if (!candidates || it->second.size() < candidates->size()) {
+            candidates = &it->second;
+        }
+    }
+    for (ElementIndex index : *candidates) {
+        if (ElementMatches(store, index, needle, length)) {
+            out.push_back(index);
+        }
+    }
+}
+
+void ElementSearchIndex::Clear() {
+    entries.clear();
+    postings.clear();
+    synced_revision = 0;
+    synced_generation = 0;
+}
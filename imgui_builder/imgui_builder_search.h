@@ -0,0 +1,47 @@
+// ULTIMATE ImGui Builder: element search
+// Trigram index over the label, text value and type name of every element (ASCII case-insensitive).
+// A query looks up its rarest trigram and only checks the elements listed under it, instead of scanning every
+// string of the document. The index follows the document incrementally: Sync() is free when the store did not
+// change, and otherwise only re-indexes the elements whose strings differ from what was indexed.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+#include <unordered_map>
+#include <vector>
+
+class ElementSearchIndex {
+public:
+    // Bring the index up to date with 'store'. Elements are compared by string address (strings are interned, an
+    // edit always makes a new one), the whole index is rebuilt when the store's string pool was reset.
+    void Sync(const ElementStore& store);
+
+    // Alive elements whose label, text value or type name contains 'query', in no particular order.
+    // Queries shorter than a trigram scan every element. Call Sync() first.
+    void Find(const ElementStore& store, const char* query, std::vector<ElementIndex>& out) const;
+
+    // Elements re-indexed by the last Sync() that did some work
+    int GetReindexedCount() const { return reindexed_count; }
+
+    void Clear();
+
+private:
+    // What an element was indexed with
+    struct Entry {
+        const char* label = nullptr;    // nullptr: not indexed
+        const char* text_value = nullptr;
+        ElementType type = ElementType::TEXT;
+    };
+
+    void Add(ElementIndex index, const Entry& entry);
+    void Remove(ElementIndex index, const Entry& entry);
+    void CollectTrigrams(const Entry& entry);
+
+    std::vector<Entry> entries;                                     // Per slot
+    std::unordered_map<ImU32, std::vector<ElementIndex>> postings;  // Trigram -> elements containing it
+    std::vector<ImU32> scratch;                                     // Trigrams of one element
+    ElementRevision synced_revision = 0;
+    ImU32 synced_generation = 0;
+    int reindexed_count = 0;
+};
@@ -0,0 +1,583 @@
+// ULTIMATE ImGui Builder: element storage
+// See imgui_builder_store.h
+
+#include "imgui_builder_store.h"
+#include "imgui_builder_types.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+static std::atomic<ElementRevision> g_LastRevision(0);
+
+static ElementRevision NewRevision() {
+    return ++g_LastRevision;
+}
+
+
+ElementIndex ElementUidMap::Find(ElementUid uid) const {
+    if (entries.empty() || uid == ElementUid_None) {
+        return ElementIndex_None;
+    }
+    const size_t mask = entries.size() - 1;
+    for (size_t slot = Home(uid); entries[slot].uid != ElementUid_None; slot = (slot + 1) & mask) {
+        if (entries[slot].uid == uid) {
+            return entries[slot].index;
+        }
+    }
+    return ElementIndex_None;
+}
+
+void ElementUidMap::Insert(ElementUid uid, ElementIndex index) {
+    Reserve(count + 1);
+    const size_t mask = entries.size() - 1;
+    size_t slot = Home(uid);
+    for (; entries[slot].uid != ElementUid_None; slot = (slot + 1) & mask) {
+        if (entries[slot].uid == uid) {
+            entries[slot].index = index;
+            return;
+        }
+    }
+    entries[slot].uid = uid;
+    entries[slot].index = index;
+    count++;
+}
+
+void ElementUidMap::Erase(ElementUid uid, ElementIndex index) {
+    if (entries.empty()) {
+        return;
+    }
+    const size_t mask = entries.size() - 1;
+    size_t slot = Home(uid);
+    for (; entries[slot].uid != uid; slot = (slot + 1) & mask) {
+        if (entries[slot].uid == ElementUid_None) {
+            return;
+        }
+    }
+    if (entries[slot].index != index) {
+        return;
+    }
+    // Backward shift: pull later entries of the probe run into the hole, so lookups never need tombstones
+    for (size_t next = (slot + 1) & mask; entries[next].uid != ElementUid_None; next = (next + 1) & mask) {
+        const size_t home = Home(entries[next].uid);
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            entries[slot] = entries[next];
+            slot = next;
+        }
+    }
+    entries[slot].uid = ElementUid_None;
+    count--;
+}
+
+bool ElementUidMap::Reserve(int required) {
+    if ((size_t)required * 2 <= entries.size()) {
+        return false;
+    }
+    size_t capacity = 64;
+    int new_shift = 58;
+    while (capacity < (size_t)required * 2) {
+        capacity *= 2;
+        new_shift--;
+    }
+    std::vector<Entry> old_entries(capacity, Entry{ ElementUid_None, ElementIndex_None });
+    old_entries.swap(entries);
+    shift = new_shift;
+    count = 0;
+    for (const Entry& entry : old_entries) {
+        if (entry.uid != ElementUid_None) {
+            Insert(entry.uid, entry.index);
+        }
+    }
+    return true;
+}
+
+void ElementUidMap::Clear() {
+    std::fill(entries.begin(), entries.end(), Entry{ ElementUid_None, ElementIndex_None });
+    count = 0;
+}
+
+void ElementUidMap::Swap(ElementUidMap& other) {
+    entries.swap(other.entries);
+    std::swap(count, other.count);
+    std::swap(shift, other.shift);
+}
+
+ElementIndex ElementStore::AllocSlot() {
+    ElementIndex index;
+    if (!free_slots.empty()) {
+        index = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        index = (ElementIndex)types.size();
+        if (types.size() == types.capacity()) {
+            Reserve(types.empty() ? 64 : (int)types.size());
+        }
+        types.emplace_back();
+        flags.emplace_back();
+        payloads.emplace_back();
+        links.emplace_back();
+        uids.emplace_back();
+        revisions.emplace_back();
+        strings.emplace_back();
+        styles.emplace_back();
+    }
+    alive_count++;
+    return index;
+}
+
+ElementIndex ElementStore::Create(ElementType type) {
+    ElementIndex index = AllocSlot();
+    types[index] = type;
+    flags[index] = ElementFlags_Default;
+    payloads[index] = AllocPayloads(type);
+    links[index] = ElementLinks();
+    uids[index] = next_uid++;
+    uid_map.Insert(uids[index], index);
+    revisions[index] = NewRevision();
+    strings[index] = ElementStrings();
+    styles[index] = ElementStyle();
+    return index;
+}
+
+void ElementStore::SetType(ElementIndex index, ElementType type) {
+    ReleasePayloads(index);
+    types[index] = type;
+    payloads[index] = AllocPayloads(type);
+}
+
+// Entries with the default values, in the buckets of the payloads of 'type'
+ElementPayloadEntries ElementStore::AllocPayloads(ElementType type) {
+    const ElementPayload payload = GetElementTypeInfo(type).payload;
+    ElementPayloadEntries entries;
+    if (payload & ElementPayload_Int) {
+        entries.int_value = ints.Alloc(0);
+    }
+    if (payload & ElementPayload_Float) {
+        entries.float_value = floats.Alloc(0.0f);
+    }
+    if (payload & ElementPayload_Range) {
+        entries.range = ranges.Alloc(ElementRange());
+    }
+    if (payload & ElementPayload_Items) {
+        entries.items = item_lists.Alloc(ElementItemList());
+    }
+    if (payload & ElementPayload_Color) {
+        entries.color = colors.Alloc(default_color);
+    }
+    return entries;
+}
+
+void ElementStore::ReleasePayloads(ElementIndex index) {
+    ElementPayloadEntries& entries = payloads[index];
+    ints.Release(entries.int_value);
+    floats.Release(entries.float_value);
+    ranges.Release(entries.range);
+    item_lists.Release(entries.items);
+    colors.Release(entries.color);
+    entries = ElementPayloadEntries();
+}
+
+ElementValues ElementStore::GetValues(ElementIndex index) const {
+    ElementValues values;
+    values.int_value = GetInt(index);
+    values.float_value = GetFloat(index);
+    values.min_value = GetRange(index).min_value;
+    values.max_value = GetRange(index).max_value;
+    values.selected_item = GetItemList(index).selected_item;
+    return values;
+}
+
+void ElementStore::SetValues(ElementIndex index, const ElementValues& values) {
+    if (int* value = EditInt(index)) {
+        *value = values.int_value;
+    }
+    if (float* value = EditFloat(index)) {
+        *value = values.float_value;
+    }
+    if (ElementRange* range = EditRange(index)) {
+        range->min_value = values.min_value;
+        range->max_value = values.max_value;
+    }
+    if (ElementItemList* items = EditItemList(index)) {
+        items->selected_item = values.selected_item;
+    }
+}
+
+ElementIndex ElementStore::Create(ElementType type, const char* label) {
+    ElementIndex index = Create(type);
+    strings[index].label = string_pool.Intern(label);
+    return index;
+}
+
+void ElementStore::SetUid(ElementIndex index, ElementUid uid) {
+    uid_map.Erase(uids[index], index);
+    uids[index] = uid;
+    uid_map.Insert(uid, index);
+    if (uid >= next_uid) {
+        next_uid = uid + 1;
+    }
+}
+
+bool ElementStore::HasUniqueUids() const {
+    std::vector<ElementUid> sorted;
+    sorted.reserve(alive_count);
+    for (size_t index = 0; index < uids.size(); index++) {
+        if (flags[index] & ElementFlags_Alive) {
+            sorted.push_back(uids[index]);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+}
+
+void ElementStore::Insert(ElementIndex parent, ElementIndex before, ElementIndex index) {
+    ElementIndex& first = (parent == ElementIndex_None) ? first_root : links[parent].first_child;
+    ElementIndex& last = (parent == ElementIndex_None) ? last_root : links[parent].last_child;
+    const ElementIndex prev = (before == ElementIndex_None) ? last : links[before].prev_sibling;
+    ElementLinks& link = links[index];
+    link.parent = parent;
+    link.prev_sibling = prev;
+    link.next_sibling = before;
+    if (prev == ElementIndex_None) {
+        first = index;
+    } else {
+        links[prev].next_sibling = index;
+    }
+    if (before == ElementIndex_None) {
+        last = index;
+    } else {
+        links[before].prev_sibling = index;
+    }
+    Touch(index);
+    structure_revision = revisions[index];
+}
+
+bool ElementStore::Move(ElementIndex index, ElementIndex parent, ElementIndex before) {
+    if (parent != ElementIndex_None && IsDescendantOrSelf(parent, index)) {
+        return false;
+    }
+    if (before == index) {
+        return true;
+    }
+    if (links[index].parent != ElementIndex_None) {
+        Touch(links[index].parent);
+    }
+    Unlink(index);
+    Insert(parent, before, index);
+    return true;
+}
+
+void ElementStore::Touch(ElementIndex index) {
+    revision = NewRevision();
+    for (; index != ElementIndex_None; index = links[index].parent) {
+        revisions[index] = revision;
+    }
+}
+
+static int CountSubtree(const ElementStore& store, ElementIndex index) {
+    int count = 1;
+    for (ElementIndex child = store.links[index].first_child; child != ElementIndex_None; child = store.links[child].next_sibling) {
+        count += CountSubtree(store, child);
+    }
+    return count;
+}
+
+ElementIndex ElementStore::Duplicate(ElementIndex index) {
+    Reserve(CountSubtree(*this, index));
+    return DuplicateSubtree(index);
+}
+
+ElementIndex ElementStore::DuplicateSubtree(ElementIndex index) {
+    // Strings and item ranges are immutable and shared with the source element
+    ElementIndex copy = AllocSlot();
+    types[copy] = types[index];
+    flags[copy] = flags[index];
+    payloads[copy] = AllocPayloads(types[index]);
+    SetValues(copy, GetValues(index));
+    if (ElementItemList* items = EditItemList(copy)) {
+        *items = GetItemList(index);
+    }
+    if (ImVec4* color = EditColor(copy)) {
+        *color = GetColor(index);
+    }
+    links[copy] = ElementLinks();
+    uids[copy] = next_uid++;
+    uid_map.Insert(uids[copy], copy);
+    revisions[copy] = NewRevision();
+    strings[copy] = strings[index];
+    styles[copy] = styles[index];
+
+    for (ElementIndex child = links[index].first_child; child != ElementIndex_None; child = links[child].next_sibling) {
+        Append(copy, DuplicateSubtree(child));
+    }
+    return copy;
+}
+
+void ElementStore::Unlink(ElementIndex index) {
+    if (IsDetached(index)) {
+        return;
+    }
+    ElementIndex parent = links[index].parent;
+    ElementIndex& first = (parent == ElementIndex_None) ? first_root : links[parent].first_child;
+    ElementIndex& last = (parent == ElementIndex_None) ? last_root : links[parent].last_child;
+    const ElementIndex prev = links[index].prev_sibling;
+    const ElementIndex next = links[index].next_sibling;
+    if (prev == ElementIndex_None) {
+        first = next;
+    } else {
+        links[prev].next_sibling = next;
+    }
+    if (next == ElementIndex_None) {
+        last = prev;
+    } else {
+        links[next].prev_sibling = prev;
+    }
+    links[index].parent = ElementIndex_None;
+    links[index].prev_sibling = ElementIndex_None;
+    links[index].next_sibling = ElementIndex_None;
+}
+
+void ElementStore::ReleaseSubtree(ElementIndex index) {
+    for (ElementIndex child = links[index].first_child; child != ElementIndex_None;) {
+        ElementIndex next = links[child].next_sibling;
+        ReleaseSubtree(child);
+        child = next;
+    }
+    flags[index] = ElementFlags_None;
+    ReleasePayloads(index);
+    uid_map.Erase(uids[index], index);
+    free_slots.push_back(index);
+    alive_count--;
+}
+
+void ElementStore::Remove(ElementIndex index) {
+    if (links[index].parent != ElementIndex_None) {
+        Touch(links[index].parent);
+    }
+    Unlink(index);
+    ReleaseSubtree(index);
+    revision = structure_revision = NewRevision();
+}
+
+void ElementStore::Detach(ElementIndex index) {
+    if (IsDetached(index)) {
+        return;
+    }
+    if (links[index].parent != ElementIndex_None) {
+        Touch(links[index].parent);
+    }
+    Unlink(index);
+    revision = structure_revision = NewRevision();
+}
+
+bool ElementStore::IsDescendantOrSelf(ElementIndex index, ElementIndex ancestor) const {
+    for (; index != ElementIndex_None; index = links[index].parent) {
+        if (index == ancestor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ElementStore::Clear() {
+    types.clear();
+    flags.clear();
+    payloads.clear();
+    links.clear();
+    uids.clear();
+    revisions.clear();
+    strings.clear();
+    styles.clear();
+    ints.Clear();
+    floats.Clear();
+    ranges.Clear();
+    item_lists.Clear();
+    colors.Clear();
+    free_slots.clear();
+    uid_map.Clear();
+    string_pool.Reset();
+    item_pool.clear();
+    first_root = last_root = ElementIndex_None;
+    alive_count = 0;
+    next_uid = 1;
+    revision = structure_revision = NewRevision();
+}
+
+void ElementStore::Reserve(int count) {
+    if (uid_map.Reserve(alive_count + count)) {
+        slot_array_allocs++;
+    }
+    const int missing_slots = count - (int)free_slots.size();
+    const size_t required = types.size() + (size_t)missing_slots;
+    if (missing_slots <= 0 || required <= types.capacity()) {
+        return;
+    }
+    types.reserve(required);
+    flags.reserve(required);
+    payloads.reserve(required);
+    links.reserve(required);
+    uids.reserve(required);
+    revisions.reserve(required);
+    strings.reserve(required);
+    styles.reserve(required);
+    slot_array_allocs += 8;
+}
+
+int ElementStore::AllocItems(int count) {
+    const int offset = (int)item_pool.size();
+    if (item_pool.size() + count > item_pool.capacity()) {
+        const size_t doubled = item_pool.size() * 2;
+        item_pool.reserve(doubled > item_pool.size() + count ? doubled : item_pool.size() + count);
+        item_pool_allocs++;
+    }
+    item_pool.resize(item_pool.size() + count);
+    return offset;
+}
+
+// The selected item of a list stays one of its items, 0 when it has none (project files reject other values)
+static void ClampSelectedItem(ElementItemList& list) {
+    if (list.selected_item >= list.count || list.selected_item < 0) {
+        list.selected_item = list.count > 0 ? list.count - 1 : 0;
+    }
+}
+
+// Item editing is ignored by the types without ElementPayload_Items
+void ElementStore::SetItems(ElementIndex index, const char* const* items, int count) {
+    if (!EditItemList(index)) {
+        return;
+    }
+    const int offset = AllocItems(count);
+    for (int i = 0; i < count; i++) {
+        item_pool[offset + i] = string_pool.Intern(items[i]);
+    }
+    ElementItemList& list = *EditItemList(index);
+    list.offset = offset;
+    list.count = count;
+    ClampSelectedItem(list);
+    Touch(index);
+}
+
+void ElementStore::SetItem(ElementIndex index, int item, const char* text) {
+    ElementItemList* list = EditItemList(index);
+    if (!list) {
+        return;
+    }
+    const int offset = AllocItems(list->count);
+    for (int i = 0; i < list->count; i++) {
+        item_pool[offset + i] = item_pool[list->offset + i];
+    }
+    item_pool[offset + item] = string_pool.Intern(text);
+    list->offset = offset;
+    Touch(index);
+}
+
+void ElementStore::AddItem(ElementIndex index, const char* text) {
+    ElementItemList* list = EditItemList(index);
+    if (!list) {
+        return;
+    }
+    const char* interned = string_pool.Intern(text);
+    if (list->offset + list->count == (int)item_pool.size() && list->count > 0) {
+        // Range ends the pool: grow it in place (elements sharing the range still see their own count)
+        AllocItems(1);
+    } else {
+        const int offset = AllocItems(list->count + 1);
+        for (int i = 0; i < list->count; i++) {
+            item_pool[offset + i] = item_pool[list->offset + i];
+        }
+        list->offset = offset;
+    }
+    item_pool[list->offset + list->count++] = interned;
+    Touch(index);
+}
+
+void ElementStore::RemoveItem(ElementIndex index, int item) {
+    ElementItemList* list = EditItemList(index);
+    if (!list) {
+        return;
+    }
+    const int offset = AllocItems(list->count - 1);
+    for (int i = 0, dst = offset; i < list->count; i++) {
+        if (i != item) {
+            item_pool[dst++] = item_pool[list->offset + i];
+        }
+    }
+    list->offset = offset;
+    list->count--;
+    ClampSelectedItem(*list);
+    Touch(index);
+}
+
+ElementStoreStats ElementStore::GetStats() const {
+    ElementStoreStats stats;
+    stats.elements = alive_count;
+    stats.slots = (int)types.size();
+    stats.slot_array_allocs = slot_array_allocs;
+    stats.item_pool_allocs = item_pool_allocs;
+    stats.item_pool_size = (int)item_pool.size();
+    stats.value_payloads = ints.GetCount() + floats.GetCount() + ranges.GetCount();
+    stats.item_payloads = item_lists.GetCount();
+    stats.color_payloads = colors.GetCount();
+    const size_t slot_size = sizeof(ElementType) + sizeof(ElementFlags) + sizeof(ElementPayloadEntries) + sizeof(ElementLinks) +
+        sizeof(ElementUid) + sizeof(ElementRevision) + sizeof(ElementStrings) + sizeof(ElementStyle);
+    stats.slot_bytes = types.size() * slot_size + ints.GetBytes() + floats.GetBytes() + ranges.GetBytes() +
+        item_lists.GetBytes() + colors.GetBytes();
+    stats.strings = string_pool.GetStats();
+    return stats;
+}
+
+void ElementStore::Swap(ElementStore& other) {
+    types.swap(other.types);
+    flags.swap(other.flags);
+    payloads.swap(other.payloads);
+    links.swap(other.links);
+    uids.swap(other.uids);
+    revisions.swap(other.revisions);
+    strings.swap(other.strings);
+    styles.swap(other.styles);
+    ints.Swap(other.ints);
+    floats.Swap(other.floats);
+    ranges.Swap(other.ranges);
+    item_lists.Swap(other.item_lists);
+    colors.Swap(other.colors);
+    string_pool.Swap(other.string_pool);
+    item_pool.swap(other.item_pool);
+    free_slots.swap(other.free_slots);
+    uid_map.Swap(other.uid_map);
+    std::swap(first_root, other.first_root);
+    std::swap(last_root, other.last_root);
+    std::swap(alive_count, other.alive_count);
+    std::swap(next_uid, other.next_uid);
+    std::swap(revision, other.revision);
+    std::swap(structure_revision, other.structure_revision);
+    std::swap(slot_array_allocs, other.slot_array_allocs);
+    std::swap(item_pool_allocs, other.item_pool_allocs);
+}
+
+void ElementStore::CopySnapshot(const ElementStore& source) {
+    types = source.types;
+    flags = source.flags;
+    payloads = source.payloads;
+    links = source.links;
+    uids = source.uids;
+    revisions = source.revisions;
+    strings = source.strings;
+    styles = source.styles;
+    ints = source.ints;
+    floats = source.floats;
+    ranges = source.ranges;
+    item_lists = source.item_lists;
+    colors = source.colors;
+    string_pool.Share(source.string_pool);
+    item_pool = source.item_pool;
+    free_slots = source.free_slots;
+    uid_map = source.uid_map;
+    first_root = source.first_root;
+    last_root = source.last_root;
+    alive_count = source.alive_count;
+    next_uid = source.next_uid;
+    revision = source.revision;
+    structure_revision = source.structure_revision;
+}
@@ -0,0 +1,357 @@
+// ULTIMATE ImGui Builder: element storage
+// Elements live in flat, index-addressed arrays instead of a tree of heap nodes:
+// - hot arrays (type, flags, payload entries, tree links) are walked every frame by the tree view and the preview,
+// - cold arrays (strings, style) are only touched by the element being drawn or edited.
+// The tree is threaded through the 'links' array (parent / first and last child / previous and next sibling), so
+// unlinking, inserting and moving an element are O(1), checking a move for cycles is O(depth).
+// Strings are interned in a StringPool and combo/listbox items are ranges of an append-only pointer pool,
+// so creating, duplicating and clearing elements only allocates when an array has to grow.
+// Every element has a uid: a 64-bit number handed out in creation order by its store, never reused within the
+// document and saved with it. It names the element in ImGui's ID stack and in generated code, so both are the same
+// from one run to the next. Slots are reused, uids are not: anything holding on to an element across edits
+// (drag and drop, undo...) keeps its uid and looks the slot up with FindByUid().
+// Payloads, the values only some element types have (see imgui_builder_types.h), are not stored per slot but in one
+// bucket per payload, which only the elements of those types have an entry in: a slot keeps the entry numbers.
+// Every change is stamped with a revision: caches built from the document (generated code...) compare revisions
+// to find what changed since they were built, and skip whole subtrees that did not.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_arena.h"
+#include <vector>
+
+enum class ElementType : unsigned char {
+    CHECKBOX,
+    BUTTON,
+    SLIDER_FLOAT,
+    SLIDER_INT,
+    INPUT_TEXT,
+    INPUT_INT,
+    INPUT_FLOAT,
+    COMBO,
+    LISTBOX,
+    COLOR_PICKER,
+    SEPARATOR,
+    TEXT,
+    BULLET_TEXT,
+    TREE_NODE,
+    COLLAPSING_HEADER,
+    TAB_BAR,
+    TAB_ITEM,
+    MENU_BAR,
+    MENU_ITEM,
+    POPUP,
+    TOOLTIP,
+    PROGRESS_BAR,
+    IMAGE_BUTTON,
+    RADIO_BUTTON,
+    SELECTABLE,
+    SPACING,
+    SAME_LINE,
+    NEW_LINE,
+    INDENT,
+    UNINDENT,
+    GROUP,
+    CHILD_WINDOW,
+    COLUMNS,
+    TABLE,
+    PLOT_LINES,
+    PLOT_HISTOGRAM,
+    COMPONENT,
+    INSTANCE
+};
+
+static const int ElementType_COUNT = (int)ElementType::INSTANCE + 1;
+
+// Enumerator name ("SLIDER_FLOAT"), as used by text formats
+const char* GetElementTypeName(ElementType type);
+bool FindElementTypeByName(const char* name, ElementType* out_type);
+
+// Slot of an element inside an ElementStore. Stays valid until the element is removed.
+typedef int ElementIndex;
+static const ElementIndex ElementIndex_None = -1;
+
+// Stable identity of an element, see ElementStore::uids. 0 is never used.
+typedef ImU64 ElementUid;
+static const ElementUid ElementUid_None = 0;
+
+// Revisions come from one process-wide counter, so they never repeat across elements, slots or stores.
+// 0 is never used and can mark "nothing cached".
+typedef ImU32 ElementRevision;
+
+enum ElementFlags_ : unsigned int {
+    ElementFlags_None       = 0,
+    ElementFlags_Alive      = 1 << 0,   // Slot is in use (cleared slots sit in the free list)
+    ElementFlags_Enabled    = 1 << 1,
+    ElementFlags_Visible    = 1 << 2,
+    ElementFlags_BoolValue  = 1 << 3,   // Value of CHECKBOX / SELECTABLE
+    ElementFlags_Open       = 1 << 4,   // TREE_NODE / COLLAPSING_HEADER open in the preview
+    ElementFlags_Expanded   = 1 << 5,   // Children shown in the builder's element tree (editor state, not saved)
+    ElementFlags_Default    = ElementFlags_Alive | ElementFlags_Enabled | ElementFlags_Visible,
+};
+typedef unsigned int ElementFlags;
+
+// Every numeric payload of an element at once, as undone and saved (see ElementStore::GetValues())
+struct ElementValues {
+    int int_value = 0;
+    float float_value = 0.0f;
+    float min_value = 0.0f;
+    float max_value = 100.0f;
+    int selected_item = 0;
+};
+
+// ElementPayload_Range entry
+struct ElementRange {
+    float min_value = 0.0f;
+    float max_value = 100.0f;
+};
+
+// ElementPayload_Items entry: range of ElementStore::item_pool. Ranges are never modified in place (editing the list
+// writes a new range), so duplicated elements can share them.
+struct ElementItemList {
+    int offset = 0;
+    int count = 0;
+    int selected_item = 0;
+};
+
+// Hot: entries of an element in the payload buckets, -1 for the payloads its type does not have
+struct ElementPayloadEntries {
+    int int_value = -1;
+    int float_value = -1;
+    int range = -1;
+    int items = -1;
+    int color = -1;
+};
+
+// Entries of one payload, for the elements whose type has it. Entries of released elements are reused.
+template <class T>
+struct PayloadBucket {
+    std::vector<T> entries;
+    std::vector<int> free_entries;
+
+    int Alloc(const T& value) {
+        int entry;
+        if (!free_entries.empty()) {
+            entry = free_entries.back();
+            free_entries.pop_back();
+            entries[entry] = value;
+        } else {
+            entry = (int)entries.size();
+            entries.push_back(value);
+        }
+        return entry;
+    }
+    void Release(int entry) {
+        if (entry >= 0) {
+            free_entries.push_back(entry);
+        }
+    }
+    void Clear() { entries.clear(); free_entries.clear(); }
+    void Swap(PayloadBucket& other) { entries.swap(other.entries); free_entries.swap(other.free_entries); }
+    int GetCount() const { return (int)(entries.size() - free_entries.size()); }
+    size_t GetBytes() const { return entries.size() * sizeof(T); }
+};
+
+// Hot: tree structure
+struct ElementLinks {
+    ElementIndex parent = ElementIndex_None;
+    ElementIndex first_child = ElementIndex_None;
+    ElementIndex last_child = ElementIndex_None;
+    ElementIndex prev_sibling = ElementIndex_None;
+    ElementIndex next_sibling = ElementIndex_None;
+};
+
+// Uid -> slot of the alive elements: open addressing (linear probing), no allocation per element
+class ElementUidMap {
+public:
+    ElementIndex Find(ElementUid uid) const;
+    // A uid already mapped is re-pointed at 'index'
+    void Insert(ElementUid uid, ElementIndex index);
+    // Only if 'uid' still maps to 'index'
+    void Erase(ElementUid uid, ElementIndex index);
+    // Room for 'required' entries without rehashing. Returns true if the table had to grow.
+    bool Reserve(int required);
+    void Clear();
+    void Swap(ElementUidMap& other);
+
+private:
+    struct Entry {
+        ElementUid uid;             // ElementUid_None: empty
+        ElementIndex index;
+    };
+    size_t Home(ElementUid uid) const { return (size_t)((uid * 0x9E3779B97F4A7C15ull) >> shift); }
+
+    std::vector<Entry> entries;     // Power of two, at most half full
+    int count = 0;
+    int shift = 64;
+};
+
+// Cold: strings, all interned in ElementStore::string_pool
+struct ElementStrings {
+    const char* label = "";
+    const char* text_value = "";
+};
+
+// Cold: style properties
+struct ElementStyle {
+    ImVec2 size = ImVec2(0, 0);
+    ImVec4 text_color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+    ImVec4 bg_color = ImVec4(0.2f, 0.2f, 0.2f, 1.0f);
+};
+
+struct ElementStoreStats {
+    int elements = 0;
+    int slots = 0;                  // Allocated slots (alive + free)
+    int slot_array_allocs = 0;      // Heap allocations made when growing the per-slot arrays
+    int item_pool_allocs = 0;       // Heap allocations made when growing the item pool
+    int item_pool_size = 0;
+    int value_payloads = 0;         // Entries of the int, float and range buckets
+    int item_payloads = 0;          // Entries of the items bucket (COMBO / LISTBOX elements)
+    int color_payloads = 0;         // Entries of the color bucket (COLOR_PICKER elements)
+    size_t slot_bytes = 0;          // Per-slot arrays and payload buckets
+    StringPoolStats strings;
+};
+
+class ElementStore {
+public:
+    // Hot data, one entry per slot
+    std::vector<ElementType> types;
+    std::vector<ElementFlags> flags;
+    std::vector<ElementPayloadEntries> payloads;
+    std::vector<ElementLinks> links;
+    // Unique within the store, counting up from 1 in creation order: a new document numbers its elements the same
+    // way on every run. Duplicates get new uids, loaders restore the saved ones.
+    std::vector<ElementUid> uids;
+    // Revision of the last change to the element or to anything below it
+    std::vector<ElementRevision> revisions;
+
+    // Cold data, one entry per slot
+    std::vector<ElementStrings> strings;
+    std::vector<ElementStyle> styles;
+
+    // Payload buckets, indexed by ElementStore::payloads
+    PayloadBucket<int> ints;                    // ElementPayload_Int
+    PayloadBucket<float> floats;                // ElementPayload_Float
+    PayloadBucket<ElementRange> ranges;         // ElementPayload_Range
+    PayloadBucket<ElementItemList> item_lists;  // ElementPayload_Items
+    PayloadBucket<ImVec4> colors;               // ElementPayload_Color
+
+    // Arenas backing ElementStrings
+    StringPool string_pool;
+    std::vector<const char*> item_pool;
+
+    // Create a detached element with default values and a new uid, then Append() it to a parent (ElementIndex_None = top level).
+    ElementIndex Create(ElementType type, const char* label);
+    // Same, with empty strings: used by loaders which fill every field themselves.
+    ElementIndex Create(ElementType type);
+    // Change the type of an element created by a loader before it knew the type (its payload follows).
+    void SetType(ElementIndex index, ElementType type);
+    void Append(ElementIndex parent, ElementIndex index) { Insert(parent, ElementIndex_None, index); }
+    // Link a detached element under 'parent', before its child 'before' (ElementIndex_None: after the last child).
+    void Insert(ElementIndex parent, ElementIndex before, ElementIndex index);
+    // Move an element and its descendants under 'parent', before 'before' (ElementIndex_None: last).
+    // Refused (returns false) when 'parent' is the element itself or one of its descendants.
+    bool Move(ElementIndex index, ElementIndex parent, ElementIndex before);
+    // Deep copy of an element and all its descendants. The copy is detached.
+    ElementIndex Duplicate(ElementIndex index);
+    // Unlink an element and release it together with all its descendants.
+    void Remove(ElementIndex index);
+    // Unlink an element, keeping it and its descendants: it is detached again, like a new element.
+    void Detach(ElementIndex index);
+    // Drop every element and restart uids from 1. Arrays, string blocks and pools keep their memory for the next document.
+    void Clear();
+    // Make room for 'count' more elements in a single allocation per array.
+    void Reserve(int count);
+
+    // Give an element a saved uid (loaders). Uids handed out afterwards continue above it.
+    void SetUid(ElementIndex index, ElementUid uid);
+    // False if two alive elements share a uid (a hand-edited or corrupt project file).
+    bool HasUniqueUids() const;
+    // Slot of the alive element with this uid, ElementIndex_None if there is none.
+    ElementIndex FindByUid(ElementUid uid) const { return uid_map.Find(uid); }
+
+    // Record a change of an element: stamps it and its ancestors with a new revision.
+    // Structure and string edits below do it themselves, code writing values/flags/style directly must call it.
+    void Touch(ElementIndex index);
+
+    // String and item editing (all strings are interned, editing never modifies a string in place)
+    void SetLabel(ElementIndex index, const char* label) { strings[index].label = string_pool.Intern(label); Touch(index); }
+    void SetText(ElementIndex index, const char* text) { strings[index].text_value = string_pool.Intern(text); Touch(index); }
+    const char* const* GetItems(ElementIndex index) const { return item_pool.data() + GetItemList(index).offset; }
+    int GetItemCount(ElementIndex index) const { return GetItemList(index).count; }
+    void SetItems(ElementIndex index, const char* const* items, int count);
+    void SetItem(ElementIndex index, int item, const char* text);
+    void AddItem(ElementIndex index, const char* text);
+    void RemoveItem(ElementIndex index, int item);
+    // Append 'count' uninitialized entries to the item pool, return the offset of the first one.
+    int AllocItems(int count);
+
+    // Payloads: Get() returns the default value for the types without it, Edit() nullptr. Call Touch() after writing.
+    int GetInt(ElementIndex index) const { return Get(ints, payloads[index].int_value, 0); }
+    int* EditInt(ElementIndex index) { return Edit(ints, payloads[index].int_value); }
+    float GetFloat(ElementIndex index) const { return Get(floats, payloads[index].float_value, 0.0f); }
+    float* EditFloat(ElementIndex index) { return Edit(floats, payloads[index].float_value); }
+    const ElementRange& GetRange(ElementIndex index) const { return Get(ranges, payloads[index].range, default_range); }
+    ElementRange* EditRange(ElementIndex index) { return Edit(ranges, payloads[index].range); }
+    // Items go through SetItems() & co, the selected item can be written directly
+    const ElementItemList& GetItemList(ElementIndex index) const { return Get(item_lists, payloads[index].items, default_items); }
+    ElementItemList* EditItemList(ElementIndex index) { return Edit(item_lists, payloads[index].items); }
+    const ImVec4& GetColor(ElementIndex index) const { return Get(colors, payloads[index].color, default_color); }
+    ImVec4* EditColor(ElementIndex index) { return Edit(colors, payloads[index].color); }
+    // The numeric payloads gathered (history, file formats), and written back: fields of the payloads the type does
+    // not have are ignored.
+    ElementValues GetValues(ElementIndex index) const;
+    void SetValues(ElementIndex index, const ElementValues& values);
+
+    ElementStoreStats GetStats() const;
+
+    // Exchange the whole content of two stores (used to commit a document loaded on the side).
+    void Swap(ElementStore& other);
+    // Replace the content with a copy of 'source' that other threads can read while 'source' keeps being edited: the
+    // arrays are copied (into the memory this store already has), the strings are shared (see StringPool::Pin()).
+    // Same uids, slots and revisions as 'source'.
+    void CopySnapshot(const ElementStore& source);
+
+    // Revision of the last change to the document, whatever it was
+    ElementRevision GetRevision() const { return revision; }
+    // Revision of the last change to the shape of the tree (elements added, moved or removed)
+    ElementRevision GetStructureRevision() const { return structure_revision; }
+
+    ElementIndex Parent(ElementIndex index) const { return links[index].parent; }
+    ElementIndex FirstChild(ElementIndex parent) const { return parent == ElementIndex_None ? first_root : links[parent].first_child; }
+    ElementIndex LastChild(ElementIndex parent) const { return parent == ElementIndex_None ? last_root : links[parent].last_child; }
+    ElementIndex PrevSibling(ElementIndex index) const { return links[index].prev_sibling; }
+    ElementIndex NextSibling(ElementIndex index) const { return links[index].next_sibling; }
+    bool IsDescendantOrSelf(ElementIndex index, ElementIndex ancestor) const;
+    bool IsAlive(ElementIndex index) const { return index >= 0 && index < (int)flags.size() && (flags[index] & ElementFlags_Alive) != 0; }
+    // Alive but not linked anywhere (created or detached, not yet inserted)
+    bool IsDetached(ElementIndex index) const { return links[index].parent == ElementIndex_None && links[index].prev_sibling == ElementIndex_None && first_root != index; }
+    int Size() const { return alive_count; }
+
+private:
+    ElementIndex AllocSlot();
+    ElementIndex DuplicateSubtree(ElementIndex index);
+    void Unlink(ElementIndex index);
+    void ReleaseSubtree(ElementIndex index);
+    ElementPayloadEntries AllocPayloads(ElementType type);
+    void ReleasePayloads(ElementIndex index);
+    template <class T>
+    static const T& Get(const PayloadBucket<T>& bucket, int entry, const T& value) { return entry >= 0 ? bucket.entries[entry] : value; }
+    template <class T>
+    static T* Edit(PayloadBucket<T>& bucket, int entry) { return entry >= 0 ? &bucket.entries[entry] : nullptr; }
+
+    ElementIndex first_root = ElementIndex_None;
+    ElementIndex last_root = ElementIndex_None;
+    std::vector<ElementIndex> free_slots;
+    ElementRange default_range;
+    ElementItemList default_items;
+    ImVec4 default_color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+    ElementUidMap uid_map;
+    int alive_count = 0;
+    ElementUid next_uid = 1;
+    ElementRevision revision = 0;
+    ElementRevision structure_revision = 0;
+    int slot_array_allocs = 0;
+    int item_pool_allocs = 0;
+};
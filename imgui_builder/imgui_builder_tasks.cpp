@@ -0,0 +1,169 @@
+// ULTIMATE ImGui Builder: background tasks
+// See imgui_builder_tasks.h
+
+#include "imgui_builder_tasks.h"
+#include <utility>
+
+void TaskContext::SetProgress(float fraction, const char* step) {
+    progress.store(fraction, std::memory_order_relaxed);
+    this->step.store(step, std::memory_order_relaxed);
+}
+
+TaskQueue::~TaskQueue() {
+    CancelAll();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+TaskId TaskQueue::Start(const char* name, std::function<bool(TaskContext&)> run, std::function<void(TaskStatus)> apply) {
+    std::unique_ptr<Task> task(new Task());
+    task->name = name;
+    task->run = std::move(run);
+    task->apply = std::move(apply);
+    TaskId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = task->id = next_id++;
+        tasks.push_back(std::move(task));
+        if (!worker.joinable()) {
+            worker = std::thread(&TaskQueue::WorkerMain, this);
+        }
+    }
+    wake.notify_one();
+    stats.started++;
+    return id;
+}
+
+void TaskQueue::WorkerMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // Oldest queued task. Tasks only leave the deque from the front once finished, so the pointer stays valid.
+        Task* task = nullptr;
+        for (std::unique_ptr<Task>& queued : tasks) {
+            if (queued->status == TaskStatus_Queued) {
+                task = queued.get();
+                break;
+            }
+        }
+        if (!task) {
+            if (stop) {
+                return;
+            }
+            wake.wait(lock);
+            continue;
+        }
+        task->status = TaskStatus_Running;
+        task->start_time = Clock::now();
+        lock.unlock();
+
+        const bool ok = task->run(task->context);
+
+        lock.lock();
+        task->status = task->context.IsCancelled() ? TaskStatus_Cancelled : ok ? TaskStatus_Done : TaskStatus_Failed;
+        finished.notify_all();
+    }
+}
+
+int TaskQueue::Update() {
+    int applied = 0;
+    for (;;) {
+        std::unique_ptr<Task> task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty() || tasks.front()->status == TaskStatus_Queued || tasks.front()->status == TaskStatus_Running) {
+                break;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        // Outside the lock: apply may start other tasks
+        const Clock::time_point start = Clock::now();
+        task->apply(task->status);
+        if (task->status == TaskStatus_Done) {
+            stats.done++;
+        } else if (task->status == TaskStatus_Failed) {
+            stats.failed++;
+        } else {
+            stats.cancelled++;
+        }
+        task.reset();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (ms > stats.max_apply_ms) {
+            stats.max_apply_ms = ms;
+        }
+        applied++;
+    }
+    return applied;
+}
+
+void TaskQueue::Cancel(TaskId id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::unique_ptr<Task>& task : tasks) {
+        if (task->id != id) {
+            continue;
+        }
+        task->context.cancelled = true;
+        if (task->status == TaskStatus_Queued) {
+            task->status = TaskStatus_Cancelled;
+        }
+        break;
+    }
+}
+
+void TaskQueue::CancelAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::unique_ptr<Task>& task : tasks) {
+        task->context.cancelled = true;
+        if (task->status == TaskStatus_Queued) {
+            task->status = TaskStatus_Cancelled;
+        }
+    }
+}
+
+bool TaskQueue::IsBusy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !tasks.empty();
+}
+
+void TaskQueue::WaitIdle() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return;
+            }
+            finished.wait(lock, [this] {
+                for (const std::unique_ptr<Task>& task : tasks) {
+                    if (task->status == TaskStatus_Queued || task->status == TaskStatus_Running) {
+                        return false;
+                    }
+                }
+                return true;
+            });
+        }
+        // Applying may have started more
+        Update();
+    }
+}
+
+void TaskQueue::GetTasks(std::vector<TaskInfo>& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    const Clock::time_point now = Clock::now();
+    for (const std::unique_ptr<Task>& task : tasks) {
+        TaskInfo info;
+        info.id = task->id;
+        info.name = task->name;
+        info.step = task->context.step.load(std::memory_order_relaxed);
+        info.progress = task->context.progress.load(std::memory_order_relaxed);
+        info.seconds = task->start_time == Clock::time_point() ? 0.0 : std::chrono::duration<double>(now - task->start_time).count();
+        info.status = task->status;
+        out.push_back(info);
+    }
+}
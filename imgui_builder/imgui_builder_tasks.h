@@ -0,0 +1,119 @@
+// ULTIMATE ImGui Builder: background tasks
+// Long operations (saving, loading, exporting code, searching a large document) run on a worker thread, so the UI
+// keeps rendering frames while they do. A task comes in two parts:
+// - run: on the worker, only touching data no other thread writes (an immutable snapshot of the document, see
+//   ElementStore::CopySnapshot(), or a store of its own), it returns whether it succeeded;
+// - apply: on the UI thread, in Update() at the start of a frame, it publishes the result (swaps a loaded document
+//   in, sets a status). Nothing changes under the UI in the middle of a frame.
+// Tasks run one at a time, in the order they were started, and are applied in that order: a save started before a
+// load writes the document as it was before the load.
+//
+// Cancel() drops a task that has not started. A running task is told through TaskContext::IsCancelled(), which it
+// checks between its steps; its result is not applied either way (apply is called with TaskStatus_Cancelled).
+// The task objects, and whatever their functions hold, are destroyed on the UI thread after they were applied.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef int TaskId;     // 0: none
+
+enum TaskStatus_ {
+    TaskStatus_Queued,
+    TaskStatus_Running,
+    TaskStatus_Done,
+    TaskStatus_Failed,
+    TaskStatus_Cancelled,
+};
+typedef int TaskStatus;
+
+// Given to the run function of a task, on the worker
+class TaskContext {
+public:
+    bool IsCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+    // Progress in [0, 1] (negative: unknown) and what the task is doing ('step' must be a string literal)
+    void SetProgress(float fraction, const char* step = nullptr);
+
+private:
+    friend class TaskQueue;
+
+    std::atomic<bool> cancelled{ false };
+    std::atomic<float> progress{ -1.0f };
+    std::atomic<const char*> step{ nullptr };
+};
+
+// A task not applied yet, as the UI shows it
+struct TaskInfo {
+    TaskId id;
+    const char* name;
+    const char* step;           // nullptr: none set
+    float progress;             // Negative: unknown
+    double seconds;             // Running time so far (0 while queued)
+    TaskStatus status;
+};
+
+struct TaskQueueStats {
+    int started = 0;
+    int done = 0;
+    int failed = 0;
+    int cancelled = 0;
+    double max_apply_ms = 0.0;  // Longest apply, the part of a task spent in a frame
+};
+
+class TaskQueue {
+public:
+    TaskQueue() = default;
+    // Cancels everything, waits for the running task and destroys the tasks without applying them
+    ~TaskQueue();
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    // Queue a task ('name' must be a string literal). The worker thread is started on first use.
+    TaskId Start(const char* name, std::function<bool(TaskContext&)> run, std::function<void(TaskStatus)> apply);
+    // UI thread, at the start of a frame: apply the tasks that finished, in start order. Returns the number applied.
+    // An apply function may start new tasks.
+    int Update();
+
+    void Cancel(TaskId id);
+    void CancelAll();
+    // Tasks started and not applied yet
+    bool IsBusy() const;
+    // Block until every task ran and was applied (headless drivers, shutdown)
+    void WaitIdle();
+
+    // Tasks not applied yet, in start order, into 'out' (replaced)
+    void GetTasks(std::vector<TaskInfo>& out) const;
+    const TaskQueueStats& GetStats() const { return stats; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Task {
+        TaskId id;
+        const char* name;
+        std::function<bool(TaskContext&)> run;
+        std::function<void(TaskStatus)> apply;
+        TaskContext context;
+        TaskStatus status = TaskStatus_Queued;      // Under 'mutex'
+        Clock::time_point start_time;
+    };
+
+    void WorkerMain();
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;           // A task was queued, or the queue is shutting down
+    std::condition_variable finished;       // A task finished
+    std::deque<std::unique_ptr<Task>> tasks;    // Not applied yet, in start order
+    std::thread worker;
+    TaskId next_id = 1;
+    bool stop = false;
+    TaskQueueStats stats;                   // UI thread only
+};
@@ -0,0 +1,59 @@
+// ULTIMATE ImGui Builder: element type registry
+// See imgui_builder_types.h
+
+#include "imgui_builder_types.h"
+#include <string.h>
+
+constexpr const char* const ElementTraits<ElementType::COMBO>::default_items[];
+
+template <ElementType Type>
+static constexpr ElementTypeInfo MakeElementTypeInfo(const char* name) {
+    typedef ElementTraits<Type> T;
+    return { Type, name, T::payload, T::flags, T::background, T::value_label, T::value_min, T::value_max,
+        T::int_value, T::float_value, T::min_value, T::max_value, T::text, T::items, T::items_count,
+        &T::Render, &T::Edit, &T::Emit, &T::Compile };
+}
+
+#define ELEMENT_TYPE_INFO(TYPE)     MakeElementTypeInfo<ElementType::TYPE>(#TYPE)
+
+static constexpr ElementTypeInfo g_ElementTypeInfos[] = {
+    ELEMENT_TYPE_INFO(CHECKBOX), ELEMENT_TYPE_INFO(BUTTON), ELEMENT_TYPE_INFO(SLIDER_FLOAT), ELEMENT_TYPE_INFO(SLIDER_INT),
+    ELEMENT_TYPE_INFO(INPUT_TEXT), ELEMENT_TYPE_INFO(INPUT_INT), ELEMENT_TYPE_INFO(INPUT_FLOAT), ELEMENT_TYPE_INFO(COMBO),
+    ELEMENT_TYPE_INFO(LISTBOX), ELEMENT_TYPE_INFO(COLOR_PICKER), ELEMENT_TYPE_INFO(SEPARATOR), ELEMENT_TYPE_INFO(TEXT),
+    ELEMENT_TYPE_INFO(BULLET_TEXT), ELEMENT_TYPE_INFO(TREE_NODE), ELEMENT_TYPE_INFO(COLLAPSING_HEADER),
+    ELEMENT_TYPE_INFO(TAB_BAR), ELEMENT_TYPE_INFO(TAB_ITEM), ELEMENT_TYPE_INFO(MENU_BAR), ELEMENT_TYPE_INFO(MENU_ITEM),
+    ELEMENT_TYPE_INFO(POPUP), ELEMENT_TYPE_INFO(TOOLTIP), ELEMENT_TYPE_INFO(PROGRESS_BAR), ELEMENT_TYPE_INFO(IMAGE_BUTTON),
+    ELEMENT_TYPE_INFO(RADIO_BUTTON), ELEMENT_TYPE_INFO(SELECTABLE), ELEMENT_TYPE_INFO(SPACING), ELEMENT_TYPE_INFO(SAME_LINE),
+    ELEMENT_TYPE_INFO(NEW_LINE), ELEMENT_TYPE_INFO(INDENT), ELEMENT_TYPE_INFO(UNINDENT), ELEMENT_TYPE_INFO(GROUP),
+    ELEMENT_TYPE_INFO(CHILD_WINDOW), ELEMENT_TYPE_INFO(COLUMNS), ELEMENT_TYPE_INFO(TABLE), ELEMENT_TYPE_INFO(PLOT_LINES),
+    ELEMENT_TYPE_INFO(PLOT_HISTOGRAM), ELEMENT_TYPE_INFO(COMPONENT), ELEMENT_TYPE_INFO(INSTANCE),
+};
+
+static constexpr bool IsIndexedByType() {
+    for (int n = 0; n < IM_ARRAYSIZE(g_ElementTypeInfos); n++) {
+        if ((int)g_ElementTypeInfos[n].type != n) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(IM_ARRAYSIZE(g_ElementTypeInfos) == ElementType_COUNT, "Missing element type");
+static_assert(IsIndexedByType(), "Element types must be listed in enum order");
+
+const ElementTypeInfo& GetElementTypeInfo(ElementType type) {
+    return g_ElementTypeInfos[(int)type];
+}
+
+const char* GetElementTypeName(ElementType type) {
+    return (int)type < ElementType_COUNT ? g_ElementTypeInfos[(int)type].name : "UNKNOWN";
+}
+
+bool FindElementTypeByName(const char* name, ElementType* out_type) {
+    for (int n = 0; n < ElementType_COUNT; n++) {
+        if (strcmp(g_ElementTypeInfos[n].name, name) == 0) {
+            *out_type = (ElementType)n;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,379 @@
+// ULTIMATE ImGui Builder: element type registry
+// What each ElementType is made of, declared once (ElementTraits specializations below) and compiled into a table
+// indexed by type (imgui_builder_types.cpp):
+// - its payload: the per-element data it reads besides the label, flags and style. The property editor shows the
+//   payload fields and nothing else, and each payload lives in a bucket of the ElementStore which only the elements
+//   of the types having it have an entry in (see ElementStore::payloads);
+// - how it behaves in the tree and in generated code (container, item width, the style color of its background);
+// - the values of a new element of that type;
+// - its hooks: how the preview draws it, the property editor edits it, generated code and the layout runtime make
+//   its calls. Each is defined next to the code calling it (ElementTraits<ElementType::SLIDER_FLOAT>::Render() in
+//   imgui_builder_preview.cpp...), which looks it up in the table instead of switching on the type.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_store.h"
+
+enum ElementPayload_ {
+    ElementPayload_None     = 0,
+    ElementPayload_Bool     = 1 << 0,   // ElementFlags_BoolValue
+    ElementPayload_Int      = 1 << 1,   // ElementStore::ints bucket
+    ElementPayload_Float    = 1 << 2,   // ElementStore::floats bucket
+    ElementPayload_Range    = 1 << 3,   // ElementStore::ranges bucket (min / max value)
+    ElementPayload_Text     = 1 << 4,   // ElementStrings::text_value
+    ElementPayload_Items    = 1 << 5,   // ElementStore::item_lists bucket (combo/listbox items and selected item)
+    ElementPayload_Color    = 1 << 6,   // ElementStore::colors bucket
+};
+typedef int ElementPayload;
+
+enum ElementTypeFlags_ {
+    ElementTypeFlags_None       = 0,
+    ElementTypeFlags_Container  = 1 << 0,   // Draws its children inside itself (the others are simply followed by them)
+    ElementTypeFlags_ItemWidth  = 1 << 1,   // Sized through PushItemWidth() (the others take the size as a parameter)
+    ElementTypeFlags_Openable   = 1 << 2,   // Has an open state in the preview (ElementFlags_Open)
+    ElementTypeFlags_Item       = 1 << 3,   // Submits one item, the cursor then starts a new line
+    ElementTypeFlags_Layout     = 1 << 4,   // Only moves the cursor: drawn the same disabled or not
+    ElementTypeFlags_NoText     = 1 << 5,   // Draws no text: the text color does not apply to it
+};
+typedef int ElementTypeFlags;
+
+class ElementPreview;
+class ImGuiBuilder;
+class LayoutProgram;
+struct CodeGenerator;
+
+// Draw the element's widget in the preview, return true if interacting with it changed the element
+typedef bool (*ElementRenderHook)(ElementPreview& preview, ElementStore& store, ElementIndex element);
+// Property editor widgets of the element's payload, return true if they changed the element (text edits touch it)
+typedef bool (*ElementEditHook)(ImGuiBuilder& builder, ElementIndex element);
+// Generated code of the element at indentation 'depth'. Containers write their children, the others are followed
+// by them.
+typedef void (*ElementEmitHook)(CodeGenerator& generator, ElementIndex element, int depth);
+// Layout ops of the element, same structure as its generated code
+typedef void (*ElementCompileHook)(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+
+struct ElementTypeInfo {
+    ElementType type;
+    const char* name;                   // Enumerator name ("SLIDER_FLOAT"), as used by text formats
+    ElementPayload payload;
+    ElementTypeFlags flags;
+    ImGuiCol background;                // Style color set to the element's bg_color (-1: none, bg_color is not used)
+    const char* value_label;            // Property editor label of the Int / Float payload
+    float value_min, value_max;         // Bounds of the value editor, when the type has no Range payload (0, 0: none)
+    // New elements
+    int int_value;
+    float float_value;
+    float min_value, max_value;
+    const char* text;
+    const char* const* items;
+    int items_count;
+    // Hooks
+    ElementRenderHook render;
+    ElementEditHook edit;
+    ElementEmitHook emit;
+    ElementCompileHook compile;
+};
+
+const ElementTypeInfo& GetElementTypeInfo(ElementType type);
+inline bool HasPayload(ElementType type, ElementPayload payload) { return (GetElementTypeInfo(type).payload & payload) != 0; }
+inline bool HasTypeFlags(ElementType type, ElementTypeFlags flags) { return (GetElementTypeInfo(type).flags & flags) != 0; }
+
+// Everything a type does not declare
+struct ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_None;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_None;
+    static constexpr ImGuiCol background = -1;
+    static constexpr const char* value_label = "Default Value";
+    static constexpr float value_min = 0.0f;
+    static constexpr float value_max = 0.0f;
+    static constexpr int int_value = 0;
+    static constexpr float float_value = 0.0f;
+    static constexpr float min_value = 0.0f;
+    static constexpr float max_value = 100.0f;
+    static constexpr const char* text = "";
+    static constexpr const char* const* items = nullptr;
+    static constexpr int items_count = 0;
+    // Hooks: a type without them draws nothing in the preview and makes no calls, its payload gets the generic
+    // property editor
+    static bool Render(ElementPreview&, ElementStore&, ElementIndex) { return false; }
+    static bool Edit(ImGuiBuilder& builder, ElementIndex element);
+    static void Emit(CodeGenerator&, ElementIndex, int) {}
+    static void Compile(LayoutProgram&, const ElementStore&, ElementIndex) {}
+};
+
+template <ElementType Type>
+struct ElementTraits : ElementTraitsDefaults {
+};
+
+template <> struct ElementTraits<ElementType::CHECKBOX> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Bool;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::BUTTON> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_Button;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::SLIDER_FLOAT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Float | ElementPayload_Range;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static constexpr float float_value = 50.0f;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::SLIDER_INT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Int | ElementPayload_Range;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static constexpr int int_value = 50;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::INPUT_TEXT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Text;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static constexpr const char* text = "Enter text...";
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::INPUT_INT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Int;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::INPUT_FLOAT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Float;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::COMBO> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Items;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static constexpr const char* const default_items[] = { "Option 1", "Option 2", "Option 3" };
+    static constexpr const char* const* items = default_items;
+    static constexpr int items_count = IM_ARRAYSIZE(default_items);
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::LISTBOX> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Items;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::COLOR_PICKER> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Color;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_ItemWidth;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::SEPARATOR> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_NoText;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::TEXT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Text;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr const char* text = "Sample Text";
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::BULLET_TEXT> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Text;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::TREE_NODE> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container | ElementTypeFlags_Openable;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::COLLAPSING_HEADER> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container | ElementTypeFlags_Openable;
+    static constexpr ImGuiCol background = ImGuiCol_Header;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::TAB_BAR> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::TAB_ITEM> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static constexpr ImGuiCol background = ImGuiCol_Tab;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::MENU_BAR> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::MENU_ITEM> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::POPUP> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static constexpr ImGuiCol background = ImGuiCol_Button;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::TOOLTIP> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Text;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static constexpr ImGuiCol background = ImGuiCol_PopupBg;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::PROGRESS_BAR> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Float;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static constexpr const char* value_label = "Progress";
+    static constexpr float value_max = 1.0f;
+    static constexpr float float_value = 0.5f;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::IMAGE_BUTTON> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item | ElementTypeFlags_NoText;
+    static constexpr ImGuiCol background = ImGuiCol_Button;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::RADIO_BUTTON> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Int;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static constexpr const char* value_label = "Selected (1)";
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::SELECTABLE> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Bool;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_Header;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::SPACING> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Layout | ElementTypeFlags_NoText;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::SAME_LINE> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Layout | ElementTypeFlags_NoText;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::NEW_LINE> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Layout | ElementTypeFlags_NoText;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::INDENT> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Layout | ElementTypeFlags_NoText;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::UNINDENT> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Layout | ElementTypeFlags_NoText;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::GROUP> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::CHILD_WINDOW> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static constexpr ImGuiCol background = ImGuiCol_ChildBg;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::COLUMNS> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Int;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static constexpr const char* value_label = "Columns (0: one per child)";
+    static constexpr float value_max = 64.0f;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::TABLE> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Int;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+    static constexpr const char* value_label = "Columns (0: one per child)";
+    static constexpr float value_max = 512.0f;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::PLOT_LINES> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Range;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+template <> struct ElementTraits<ElementType::PLOT_HISTOGRAM> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Range;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Item;
+    static constexpr ImGuiCol background = ImGuiCol_FrameBg;
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+};
+// Label: the component name. Children: its content (see imgui_builder_components.h).
+template <> struct ElementTraits<ElementType::COMPONENT> : ElementTraitsDefaults {
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_Container;
+};
+// Text: the name of the component drawn
+template <> struct ElementTraits<ElementType::INSTANCE> : ElementTraitsDefaults {
+    static constexpr ElementPayload payload = ElementPayload_Text;
+    static constexpr ElementTypeFlags flags = ElementTypeFlags_ItemWidth;
+    static bool Render(ElementPreview& preview, ElementStore& store, ElementIndex element);
+    static void Emit(CodeGenerator& generator, ElementIndex element, int depth);
+    static void Compile(LayoutProgram& program, const ElementStore& store, ElementIndex element);
+    static bool Edit(ImGuiBuilder& builder, ElementIndex element);
+};
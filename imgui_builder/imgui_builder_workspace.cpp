@@ -0,0 +1,96 @@
+// ULTIMATE ImGui Builder: workspace of open documents
+// See imgui_builder_workspace.h
+
+#include "imgui_builder_workspace.h"
+#include <string.h>
+
+int Workspace::Add(const char* path) {
+    const int existing = Find(path);
+    if (existing >= 0) {
+        return existing;
+    }
+    WorkspaceDocument document;
+    document.path = paths.Intern(path);
+    const char* slash = strrchr(document.path, '/');
+    const char* backslash = strrchr(document.path, '\\');
+    if (backslash > slash) {
+        slash = backslash;
+    }
+    document.title = slash ? slash + 1 : document.path;
+    documents.push_back(document);
+    return (int)documents.size() - 1;
+}
+
+void Workspace::Remove(int index) {
+    documents.erase(documents.begin() + index);
+    if (active == index) {
+        active = -1;
+    } else if (active > index) {
+        active--;
+    }
+    if (requested == index) {
+        requested = -1;
+    } else if (requested > index) {
+        requested--;
+    }
+    // Paths of closed documents stay interned until none is left
+    if (documents.empty()) {
+        paths.Reset();
+    }
+}
+
+int Workspace::Find(const char* path) const {
+    for (int n = 0; n < (int)documents.size(); n++) {
+        if (documents[n].path == path || strcmp(documents[n].path, path) == 0) {
+            return n;
+        }
+    }
+    return -1;
+}
+
+void Workspace::SetActive(int index) {
+    active = index;
+    if (requested == index) {
+        requested = -1;
+    }
+    if (index >= 0) {
+        documents[index].last_shown = ++clock;
+    }
+}
+
+void Workspace::Trim() {
+    int loaded = 0;
+    for (const WorkspaceDocument& document : documents) {
+        if (document.body) {
+            loaded++;
+        }
+    }
+    while (loaded > max_loaded) {
+        WorkspaceDocument* oldest = nullptr;
+        for (WorkspaceDocument& document : documents) {
+            // Unsaved changes are only in memory
+            if (document.body && document.body->elements.GetRevision() == document.body->saved_revision &&
+                (!oldest || document.last_shown < oldest->last_shown)) {
+                oldest = &document;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        oldest->body.reset();
+        oldest->state = WorkspaceDocumentState_Unloaded;
+        loaded--;
+    }
+}
+
+WorkspaceStats Workspace::GetStats() const {
+    WorkspaceStats stats;
+    stats.documents = (int)documents.size();
+    for (int n = 0; n < (int)documents.size(); n++) {
+        if (documents[n].body || n == active) {
+            stats.loaded++;
+        }
+    }
+    stats.index_bytes = documents.capacity() * sizeof(WorkspaceDocument) + paths.GetStats().bytes_used;
+    return stats;
+}
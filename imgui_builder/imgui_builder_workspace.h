@@ -0,0 +1,84 @@
+// ULTIMATE ImGui Builder: workspace of open documents
+// The builder edits one document at a time but keeps any number open, one tab each. An open document is an index
+// entry (its path, interned in the workspace's StringPool, and a few words of state) until its tab is first shown:
+// only then is the file read, on the task queue. The body (elements, undo history, selection, menu name) stays in
+// memory while the document has unsaved changes; unmodified bodies of inactive tabs are dropped again past
+// SetMaxLoaded(), so hundreds of open but idle documents cost one entry each.
+//
+// The active document lives in the builder (see ImGuiBuilder::ShowDocument()): its body is swapped in and out, the
+// panels and caches keep working on a single ElementStore. Its entry has no body.
+
+#pragma once
+
+#include "imgui.h"
+#include "imgui_builder_arena.h"
+#include "imgui_builder_history.h"
+#include "imgui_builder_store.h"
+#include "imgui_builder_tasks.h"
+#include <memory>
+#include <vector>
+
+// What the builder keeps per document
+struct WorkspaceBody {
+    ElementStore elements;
+    EditHistory history;
+    ElementIndex selected_element = ElementIndex_None;
+    char menu_name[256] = "My Menu";
+    ElementRevision saved_revision = 0;     // Revision when last loaded or saved
+};
+
+enum WorkspaceDocumentState_ {
+    WorkspaceDocumentState_Unloaded,        // Index entry only
+    WorkspaceDocumentState_Loading,
+    WorkspaceDocumentState_Loaded,          // Body in memory (or in the builder, for the active document)
+    WorkspaceDocumentState_Failed,          // Could not be read, see ImGuiBuilder's project status
+};
+typedef int WorkspaceDocumentState;
+
+struct WorkspaceDocument {
+    const char* path;                       // Interned: one address per path, identifies the document
+    const char* title;                      // File name part of 'path'
+    std::shared_ptr<WorkspaceBody> body;    // Loaded, inactive documents only
+    ImU32 last_shown = 0;                   // Workspace clock when it was last the active document
+    WorkspaceDocumentState state = WorkspaceDocumentState_Unloaded;
+};
+
+struct WorkspaceStats {
+    int documents = 0;
+    int loaded = 0;                         // Bodies in memory, the active document included
+    size_t index_bytes = 0;                 // Entries and interned paths (the blocks holding them not counted)
+};
+
+class Workspace {
+public:
+    // Add an entry for 'path' (nothing is read). Returns its index, that of the existing entry if already open.
+    int Add(const char* path);
+    // Close a document, whatever its state. Indices after it shift down by one.
+    void Remove(int index);
+    // -1 if not open. 'path' need not be interned.
+    int Find(const char* path) const;
+
+    int GetCount() const { return (int)documents.size(); }
+    WorkspaceDocument& Get(int index) { return documents[index]; }
+    const WorkspaceDocument& Get(int index) const { return documents[index]; }
+    // Document in the builder, -1 if the builder holds one that has no entry
+    int GetActive() const { return active; }
+    void SetActive(int index);
+    // Document to show next (a tab was picked), -1: none. Cleared when it is shown or fails to load.
+    int GetRequested() const { return requested; }
+    void Request(int index) { requested = index; }
+
+    // Drop the bodies of unmodified inactive documents beyond 'max_loaded', least recently shown first
+    void SetMaxLoaded(int max_loaded) { this->max_loaded = max_loaded; }
+    void Trim();
+
+    WorkspaceStats GetStats() const;
+
+private:
+    std::vector<WorkspaceDocument> documents;
+    StringPool paths;
+    int active = -1;
+    int requested = -1;
+    int max_loaded = 8;
+    ImU32 clock = 0;
+};